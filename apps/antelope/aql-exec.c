@@ -62,6 +62,102 @@ clear_handle(db_handle_t *handle)
   handle->join_rel = NULL;
 }
 
+#if DB_FEATURE_JOIN
+static int
+is_integer_attribute(attribute_t *attr)
+{
+  return attr->domain == DOMAIN_INT || attr->domain == DOMAIN_LONG;
+}
+
+static int
+has_index_type(attribute_t *attr, index_type_t type)
+{
+  return attr->index != NULL && ((index_t *)attr->index)->type == type;
+}
+
+/*
+ * Choose how to join the relations of a handle. The cost of each
+ * strategy is estimated as the number of tuple reads, and an index
+ * lookup is counted as DB_INDEX_COST reads unless it is a binary search
+ * in an inline index. The reads of matching tuples are the same for all
+ * strategies, and are not counted.
+ */
+static uint8_t
+choose_join_strategy(db_handle_t *handle, aql_adt_t *adt)
+{
+  attribute_t *left_attr;
+  attribute_t *right_attr;
+  tuple_id_t left_count;
+  tuple_id_t right_count;
+  unsigned long cost;
+  unsigned long best_cost;
+  unsigned long lookup_cost;
+  uint8_t best;
+
+  left_attr = relation_attribute_get(handle->left_rel, adt->attributes[0].name);
+  right_attr = relation_attribute_get(handle->right_rel, adt->attributes[0].name);
+  if(left_attr == NULL || right_attr == NULL) {
+    /* The join reports the error. */
+    return DB_JOIN_INDEX;
+  }
+
+  left_count = relation_cardinality(handle->left_rel);
+  right_count = relation_cardinality(handle->right_rel);
+  if(left_count == INVALID_TUPLE || right_count == INVALID_TUPLE) {
+    return DB_JOIN_INDEX;
+  }
+
+  best = DB_JOIN_INDEX;
+  best_cost = (unsigned long)-1;
+
+  if(index_exists(right_attr)) {
+    if(has_index_type(right_attr, INDEX_INLINE)) {
+      for(lookup_cost = 1; (1UL << lookup_cost) < right_count; lookup_cost++);
+    } else {
+      lookup_cost = DB_INDEX_COST;
+    }
+    best_cost = left_count + left_count * lookup_cost;
+    if(DB_JOIN_STRATEGY == DB_JOIN_INDEX) {
+      return DB_JOIN_INDEX;
+    }
+  }
+
+  if(!is_integer_attribute(left_attr) || !is_integer_attribute(right_attr)) {
+    return best;
+  }
+
+#if DB_FEATURE_HASH_JOIN
+  /* The left relation is read once for each part of the right relation
+     that fits in the hash table. */
+  cost = right_count + left_count *
+    ((right_count + DB_HASH_JOIN_ENTRIES - 1) / DB_HASH_JOIN_ENTRIES);
+  if(DB_JOIN_STRATEGY == DB_JOIN_HASH) {
+    return DB_JOIN_HASH;
+  }
+  if(cost < best_cost) {
+    best = DB_JOIN_HASH;
+    best_cost = cost;
+  }
+#endif /* DB_FEATURE_HASH_JOIN */
+
+  if(has_index_type(left_attr, INDEX_INLINE) &&
+     has_index_type(right_attr, INDEX_INLINE)) {
+    cost = left_count + right_count;
+    if(DB_JOIN_STRATEGY == DB_JOIN_MERGE) {
+      return DB_JOIN_MERGE;
+    }
+    if(cost < best_cost) {
+      best = DB_JOIN_MERGE;
+      best_cost = cost;
+    }
+  }
+
+  PRINTF("DB: Chose join strategy %d with cost %lu\n", best, best_cost);
+
+  return best;
+}
+#endif /* DB_FEATURE_JOIN */
+
 static db_result_t
 aql_execute(db_handle_t *handle, aql_adt_t *adt)
 {
@@ -171,6 +267,7 @@ aql_execute(db_handle_t *handle, aql_adt_t *adt)
       relation_release(handle->left_rel);
       break;
     }
+    handle->join_strategy = choose_join_strategy(handle, adt);
     result = relation_join(handle, adt);
     break;
 #endif /* DB_FEATURE_JOIN */
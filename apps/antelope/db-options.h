@@ -69,6 +69,12 @@
 #define DB_FEATURE_INTEGRITY		0
 #endif /* DB_FEATURE_INTEGRITY */
 
+/* Support hash joins, which do not require an index on the attribute
+   to join on. The hash table takes DB_HASH_JOIN_ENTRIES entries of RAM. */
+#ifndef DB_FEATURE_HASH_JOIN
+#define DB_FEATURE_HASH_JOIN		0
+#endif /* DB_FEATURE_HASH_JOIN */
+
 /*----------------------------------------------------------------------------*/
 
 /* Configuration parameters that may be trimmed to save space. */
@@ -208,6 +214,29 @@
 
 /*----------------------------------------------------------------------------*/
 
+/* Join options. */
+
+/* The number of tuples of the right relation that a hash join keeps in
+   its hash table. A larger relation is joined in several passes, each of
+   which scans the left relation once. */
+#ifndef DB_HASH_JOIN_ENTRIES
+#define DB_HASH_JOIN_ENTRIES		64
+#endif /* DB_HASH_JOIN_ENTRIES */
+
+/* The number of buckets in the hash table of a hash join. */
+#ifndef DB_HASH_JOIN_BUCKETS
+#define DB_HASH_JOIN_BUCKETS		31
+#endif /* DB_HASH_JOIN_BUCKETS */
+
+/* The join strategy to use: DB_JOIN_AUTO chooses the cheapest one, while
+   DB_JOIN_INDEX, DB_JOIN_HASH and DB_JOIN_MERGE select one whenever it
+   can be used for the join. */
+#ifndef DB_JOIN_STRATEGY
+#define DB_JOIN_STRATEGY		DB_JOIN_AUTO
+#endif /* DB_JOIN_STRATEGY */
+
+/*----------------------------------------------------------------------------*/
+
 /* LVM options. */
 
 /* The maximum length of a variable in LVM. This value should preferably
@@ -79,6 +79,28 @@ struct source_map {
 };
 
 static struct source_map source_map[AQL_ATTRIBUTE_LIMIT];
+
+#if DB_FEATURE_HASH_JOIN
+/*
+ * The hash table of a hash join holds the join attribute values and
+ * tuple IDs of a part of the right relation. Buckets and entries refer
+ * to entries by their index plus one, so that 0 ends a chain.
+ */
+struct hash_join_entry {
+  long key;
+  tuple_id_t tuple_id;
+  uint16_t next;
+};
+
+static struct hash_join_entry hash_join_entries[DB_HASH_JOIN_ENTRIES];
+static uint16_t hash_join_buckets[DB_HASH_JOIN_BUCKETS];
+/* The handle of the hash join that uses the table. */
+static db_handle_t *hash_join_owner;
+/* The first tuple of the right relation that is not in the table. */
+static tuple_id_t hash_join_next_build;
+/* The next entry to compare with the current left tuple. */
+static uint16_t hash_join_next_entry;
+#endif /* DB_FEATURE_HASH_JOIN */
 #endif /* DB_FEATURE_JOIN */
 
 static unsigned char row[DB_MAX_ATTRIBUTES_PER_RELATION * DB_MAX_ELEMENT_SIZE];
@@ -959,24 +981,65 @@ relation_select(void *handle_ptr, relation_t *rel, void *adt_ptr)
 }
 
 #if DB_FEATURE_JOIN
-db_result_t
-relation_process_join(void *handle_ptr)
+static db_result_t
+get_join_key(relation_t *rel, attribute_t *attr, unsigned char *row, long *key)
+{
+  attribute_value_t value;
+
+  if(DB_ERROR(relation_get_value(rel, attr, row, &value))) {
+    PRINTF("DB: Failed to get a value of the attribute \"%s\" to join on\n",
+	attr->name);
+    return DB_IMPLEMENTATION_ERROR;
+  }
+
+  *key = db_value_to_long(&value);
+  return DB_OK;
+}
+
+/* Produce a tuple of the join relation from the current left and
+   right rows. */
+static db_result_t
+emit_join_row(db_handle_t *handle)
 {
-  db_handle_t *handle;
-  db_result_t result;
-  relation_t *left_rel;
-  relation_t *right_rel;
   relation_t *join_rel;
   unsigned char *join_next_attribute_ptr;
   size_t element_size;
+  int i;
+
+  join_rel = handle->join_rel;
+
+  /* Use the source attribute map to fill in the physical representation
+     of the resulting tuple. */
+  join_next_attribute_ptr = join_row;
+
+  for(i = 0; i < join_rel->attribute_count; i++) {
+    element_size = source_map[i].attr->element_size;
+
+    memcpy(join_next_attribute_ptr, source_map[i].from_ptr, element_size);
+    join_next_attribute_ptr += element_size;
+  }
+
+  if(((aql_adt_t *)handle->adt)->flags & AQL_FLAG_ASSIGN) {
+    if(DB_ERROR(storage_put_row(join_rel, join_row))) {
+      return DB_STORAGE_ERROR;
+    }
+  }
+
+  handle->current_row++;
+  return DB_GOT_ROW;
+}
+
+static db_result_t
+process_index_join(db_handle_t *handle)
+{
+  db_result_t result;
+  relation_t *left_rel;
+  relation_t *right_rel;
   tuple_id_t right_tuple_id;
   attribute_value_t value;
-  int i;
 
-  handle = (db_handle_t *)handle_ptr;
   left_rel = handle->left_rel;
   right_rel = handle->right_rel;
-  join_rel = handle->join_rel;
 
   if(!(handle->flags & DB_HANDLE_FLAG_INDEX_STEP)) {
     goto inner_loop;
@@ -1030,29 +1093,239 @@ inner_loop:
         return DB_IMPLEMENTATION_ERROR;
       }
 
-      /* Use the source attribute map to fill in the physical representation
-	 of the resulting tuple. */
-      join_next_attribute_ptr = join_row;
+      return emit_join_row(handle);
+    }
+  }
 
-      for(i = 0; i < join_rel->attribute_count; i++) {
-	element_size = source_map[i].attr->element_size;
+  return DB_OK;
+}
 
-	memcpy(join_next_attribute_ptr, source_map[i].from_ptr, element_size);
-	join_next_attribute_ptr += element_size;
-      }
+#if DB_FEATURE_HASH_JOIN
+/* Fill the hash table with the next part of the right relation. Returns
+   the number of tuples added, or -1 on failure. */
+static int
+build_hash_table(db_handle_t *handle)
+{
+  db_result_t result;
+  struct hash_join_entry *entry;
+  unsigned bucket;
+  int count;
+
+  memset(hash_join_buckets, 0, sizeof(hash_join_buckets));
 
-      if(((aql_adt_t *)handle->adt)->flags & AQL_FLAG_ASSIGN) {
-        if(DB_ERROR(storage_put_row(join_rel, join_row))) {
+  for(count = 0; count < DB_HASH_JOIN_ENTRIES; count++) {
+    result = storage_get_row(handle->right_rel, &hash_join_next_build,
+                             right_row);
+    if(DB_ERROR(result)) {
+      PRINTF("DB: Failed to get a row in right relation %s!\n",
+             handle->right_rel->name);
+      return -1;
+    } else if(result == DB_FINISHED) {
+      break;
+    }
+
+    entry = &hash_join_entries[count];
+    if(DB_ERROR(get_join_key(handle->right_rel, handle->right_join_attr,
+                             right_row, &entry->key))) {
+      return -1;
+    }
+    entry->tuple_id = hash_join_next_build++;
+
+    bucket = (unsigned long)entry->key % DB_HASH_JOIN_BUCKETS;
+    entry->next = hash_join_buckets[bucket];
+    hash_join_buckets[bucket] = count + 1;
+  }
+
+  PRINTF("DB: Hash join table holds %d tuples of %s\n", count,
+         handle->right_rel->name);
+  return count;
+}
+
+static db_result_t
+start_hash_join(db_handle_t *handle)
+{
+  /* A new join takes over the table from any unfinished one. */
+  hash_join_owner = handle;
+  hash_join_next_build = 0;
+  hash_join_next_entry = 0;
+  handle->tuple_id = 0;
+
+  return build_hash_table(handle) < 0 ? DB_STORAGE_ERROR : DB_OK;
+}
+
+/*
+ * The hash join builds a table of as many tuples of the right relation
+ * as fit, and probes it with each tuple of the left relation. The
+ * remaining tuples of the right relation are joined in further passes,
+ * so that the RAM used is bounded without writing temporary files.
+ */
+static db_result_t
+process_hash_join(db_handle_t *handle)
+{
+  db_result_t result;
+  struct hash_join_entry *entry;
+  tuple_id_t right_tuple_id;
+  int count;
+
+  if(hash_join_owner != handle) {
+    PRINTF("DB: The hash join table is used by another join\n");
+    return DB_BUSY_ERROR;
+  }
+
+  for(;;) {
+    if(handle->flags & DB_HANDLE_FLAG_INDEX_STEP) {
+      result = storage_get_row(handle->left_rel, &handle->tuple_id, left_row);
+      if(DB_ERROR(result)) {
+        PRINTF("DB: Failed to get a row in left relation %s!\n",
+               handle->left_rel->name);
+        return result;
+      } else if(result == DB_FINISHED) {
+        /* All of the left relation has been joined with this part of
+           the right relation. */
+        count = build_hash_table(handle);
+        if(count < 0) {
           return DB_STORAGE_ERROR;
+        } else if(count == 0) {
+          hash_join_owner = NULL;
+          return DB_FINISHED;
         }
+        handle->tuple_id = 0;
+        continue;
       }
+      handle->tuple_id++;
 
-      handle->current_row++;
-      return DB_GOT_ROW;
+      if(DB_ERROR(get_join_key(handle->left_rel, handle->left_join_attr,
+                               left_row, &handle->join_key))) {
+        return DB_IMPLEMENTATION_ERROR;
+      }
+      hash_join_next_entry =
+        hash_join_buckets[(unsigned long)handle->join_key % DB_HASH_JOIN_BUCKETS];
+      handle->flags &= ~DB_HANDLE_FLAG_INDEX_STEP;
+    }
+
+    while(hash_join_next_entry != 0) {
+      entry = &hash_join_entries[hash_join_next_entry - 1];
+      hash_join_next_entry = entry->next;
+      if(entry->key != handle->join_key) {
+        continue;
+      }
+
+      right_tuple_id = entry->tuple_id;
+      result = storage_get_row(handle->right_rel, &right_tuple_id, right_row);
+      if(DB_ERROR(result)) {
+        PRINTF("DB: Failed to get a row in right relation %s!\n",
+               handle->right_rel->name);
+        return result;
+      } else if(result == DB_FINISHED) {
+        return DB_IMPLEMENTATION_ERROR;
+      }
+      return emit_join_row(handle);
     }
+
+    handle->flags |= DB_HANDLE_FLAG_INDEX_STEP;
   }
+}
+#endif /* DB_FEATURE_HASH_JOIN */
 
-  return DB_OK;
+/*
+ * The merge join requires inline indexes on the attribute to join on
+ * in both relations, which implies that the tuples of both are stored
+ * in ascending order of the attribute. Both relations are then read
+ * once in tuple order, except that the right tuples of a join attribute
+ * value are read again for each left tuple with the same value.
+ */
+static db_result_t
+process_merge_join(db_handle_t *handle)
+{
+  db_result_t result;
+  long key;
+
+  for(;;) {
+    if(handle->flags & DB_HANDLE_FLAG_INDEX_STEP) {
+      result = storage_get_row(handle->left_rel, &handle->tuple_id, left_row);
+      if(DB_ERROR(result)) {
+        PRINTF("DB: Failed to get a row in left relation %s!\n",
+               handle->left_rel->name);
+        return result;
+      } else if(result == DB_FINISHED) {
+        return DB_FINISHED;
+      }
+      handle->tuple_id++;
+
+      if(DB_ERROR(get_join_key(handle->left_rel, handle->left_join_attr,
+                               left_row, &key))) {
+        return DB_IMPLEMENTATION_ERROR;
+      }
+
+      if(handle->right_group_id != INVALID_TUPLE && key == handle->join_key) {
+        /* Join with the same right tuples as the previous left tuple. */
+        handle->right_tuple_id = handle->right_group_id;
+      } else {
+        /* Skip the right tuples with lower values. */
+        for(;;) {
+          result = storage_get_row(handle->right_rel, &handle->right_tuple_id,
+                                   right_row);
+          if(DB_ERROR(result)) {
+            return result;
+          } else if(result == DB_FINISHED) {
+            return DB_FINISHED;
+          }
+          if(DB_ERROR(get_join_key(handle->right_rel, handle->right_join_attr,
+                                   right_row, &handle->join_key))) {
+            return DB_IMPLEMENTATION_ERROR;
+          }
+          if(handle->join_key >= key) {
+            break;
+          }
+          handle->right_tuple_id++;
+        }
+        handle->right_group_id = handle->right_tuple_id;
+        if(handle->join_key != key) {
+          /* No right tuple matches this left tuple. */
+          continue;
+        }
+      }
+      handle->flags &= ~DB_HANDLE_FLAG_INDEX_STEP;
+    }
+
+    result = storage_get_row(handle->right_rel, &handle->right_tuple_id,
+                             right_row);
+    if(DB_ERROR(result)) {
+      return result;
+    }
+    if(result != DB_FINISHED) {
+      if(DB_ERROR(get_join_key(handle->right_rel, handle->right_join_attr,
+                               right_row, &key))) {
+        return DB_IMPLEMENTATION_ERROR;
+      }
+      if(key == handle->join_key) {
+        handle->right_tuple_id++;
+        return emit_join_row(handle);
+      }
+    }
+
+    /* The right tuples with this value have been joined. */
+    handle->flags |= DB_HANDLE_FLAG_INDEX_STEP;
+  }
+}
+
+db_result_t
+relation_process_join(void *handle_ptr)
+{
+  db_handle_t *handle;
+
+  handle = (db_handle_t *)handle_ptr;
+
+  switch(handle->join_strategy) {
+#if DB_FEATURE_HASH_JOIN
+  case DB_JOIN_HASH:
+    return process_hash_join(handle);
+#endif /* DB_FEATURE_HASH_JOIN */
+  case DB_JOIN_MERGE:
+    return process_merge_join(handle);
+  default:
+    return process_index_join(handle);
+  }
 }
 
 static db_result_t
@@ -1158,7 +1431,15 @@ relation_join(void *query_result, void *adt_ptr)
     return DB_RELATIONAL_ERROR;
   }
 
-  if(!index_exists(handle->right_join_attr)) {
+  handle->right_tuple_id = 0;
+  handle->right_group_id = INVALID_TUPLE;
+  if(handle->join_strategy == DB_JOIN_AUTO) {
+    handle->join_strategy = DB_JOIN_INDEX;
+  }
+  PRINTF("DB: Using join strategy %d\n", handle->join_strategy);
+
+  if(handle->join_strategy == DB_JOIN_INDEX &&
+     !index_exists(handle->right_join_attr)) {
     PRINTF("DB: The attribute to join on is not indexed\n");
     return DB_INDEX_ERROR;
   }
@@ -1189,6 +1470,13 @@ relation_join(void *query_result, void *adt_ptr)
     handle->ncolumns++;
   }
 
+#if DB_FEATURE_HASH_JOIN
+  if(handle->join_strategy == DB_JOIN_HASH &&
+     DB_ERROR(start_hash_join(handle))) {
+    return DB_STORAGE_ERROR;
+  }
+#endif /* DB_FEATURE_HASH_JOIN */
+
   return generate_join_result(handle);
 }
 #endif /* DB_FEATURE_JOIN */
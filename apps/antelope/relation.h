@@ -56,6 +56,12 @@ typedef enum db_direction {
 
 #define RELATION_HAS_TUPLES(rel) ((rel)->tuple_storage >= 0)
 
+/* Join strategies. */
+#define DB_JOIN_AUTO	0 /* Choose the strategy with the lowest cost. */
+#define DB_JOIN_INDEX	1 /* Index nested-loop join. */
+#define DB_JOIN_HASH	2 /* Hash join. */
+#define DB_JOIN_MERGE	3 /* Merge join over inline-indexed attributes. */
+
 /*
  * A relation consists of a name, a set of domains, a set of indexes,
  * and a set of keys. Each relation must have a primary key.
@@ -61,9 +61,13 @@ struct db_handle {
   relation_t *result_rel;
   attribute_t *left_join_attr;
   attribute_t *right_join_attr;
+  tuple_id_t right_tuple_id;
+  tuple_id_t right_group_id;
+  long join_key;
   tuple_t tuple;
   uint8_t flags;
   uint8_t ncolumns;
+  uint8_t join_strategy;
   void *adt;
 };
 typedef struct db_handle db_handle_t;
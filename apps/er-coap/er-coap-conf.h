@@ -69,6 +69,15 @@
 #endif /* COAP_MAX_OBSERVERS */
 
 /* Interval in notifies in which NON notifies are changed to CON notifies to check client. */
+#ifndef COAP_OBSERVE_REFRESH_INTERVAL
 #define COAP_OBSERVE_REFRESH_INTERVAL  20
+#endif /* COAP_OBSERVE_REFRESH_INTERVAL */
+
+/* Minimum time in clock ticks between two notifies to the same observer.
+   Changes in between are coalesced into one notify with the latest
+   representation, sent when the interval has passed. 0 disables. */
+#ifndef COAP_OBSERVE_MIN_INTERVAL
+#define COAP_OBSERVE_MIN_INTERVAL      0
+#endif /* COAP_OBSERVE_MIN_INTERVAL */
 
 #endif /* ER_COAP_CONF_H_ */
@@ -39,6 +39,7 @@
 #include <stdio.h>
 #include <string.h>
 #include "er-coap-observe.h"
+#include "sys/ctimer.h"
 
 #define DEBUG 0
 #if DEBUG
@@ -55,6 +56,17 @@
 /*---------------------------------------------------------------------------*/
 MEMB(observers_memb, coap_observer_t, COAP_MAX_OBSERVERS);
 LIST(observers_list);
+
+/* Notification rendered once per change, without Token, and where the
+   Observe option value starts (0 if none) */
+static uint8_t notification_buffer[COAP_MAX_PACKET_SIZE + 1];
+static uint16_t observe_offset;
+
+#if COAP_OBSERVE_MIN_INTERVAL
+static struct ctimer pending_timer;
+
+static void send_pending(void *ptr);
+#endif /* COAP_OBSERVE_MIN_INTERVAL */
 /*---------------------------------------------------------------------------*/
 /*- Internal API ------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -79,6 +91,11 @@ add_observer(uip_ipaddr_t *addr, uint16_t port, const uint8_t *token,
     o->token_len = token_len;
     memcpy(o->token, token, token_len);
     o->last_mid = 0;
+#if COAP_OBSERVE_MIN_INTERVAL
+    /* the response to the registration counts as a notify */
+    o->last_notify = clock_time();
+    o->pending = NULL;
+#endif /* COAP_OBSERVE_MIN_INTERVAL */
 
     PRINTF("Adding observer (%u/%u) for /%s [0x%02X%02X]\n",
            list_length(observers_list) + 1, COAP_MAX_OBSERVERS,
@@ -89,6 +106,12 @@ add_observer(uip_ipaddr_t *addr, uint16_t port, const uint8_t *token,
   return o;
 }
 /*---------------------------------------------------------------------------*/
+list_t
+coap_get_observers(void)
+{
+  return observers_list;
+}
+/*---------------------------------------------------------------------------*/
 /*- Removal -----------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 void
@@ -180,87 +203,235 @@ coap_remove_observer_by_mid(uip_ipaddr_t *addr, uint16_t port, uint16_t mid)
 /*---------------------------------------------------------------------------*/
 /*- Notification ------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
-void
-coap_notify_observers(resource_t *resource)
+static int
+observer_matches(coap_observer_t *obs, resource_t *resource,
+                 const char *url, int url_len)
 {
-  coap_notify_observers_sub(resource, NULL);
+  int obs_url_len = strlen(obs->url);
+
+  /* Do a match based on the parent/sub-resource match so that it is
+     possible to do parent-node observe */
+  return (obs_url_len == url_len
+          || (obs_url_len > url_len
+              && (resource->flags & HAS_SUB_RESOURCES)
+              && obs->url[url_len] == '/'))
+         && strncmp(url, obs->url, url_len) == 0;
 }
-void
-coap_notify_observers_sub(resource_t *resource, const char *subpath)
+/*---------------------------------------------------------------------------*/
+static uint16_t
+render_notification(resource_t *resource, const char *url)
 {
-  /* build notification */
   coap_packet_t notification[1]; /* this way the packet can be treated as pointer as usual */
   coap_packet_t request[1]; /* this way the packet can be treated as pointer as usual */
-  coap_observer_t *obs = NULL;
-  int url_len, obs_url_len;
-  char url[COAP_OBSERVER_URL_LEN];
-
-  url_len = strlen(resource->url);
-  strncpy(url, resource->url, COAP_OBSERVER_URL_LEN - 1);
-  if(url_len < COAP_OBSERVER_URL_LEN - 1 && subpath != NULL) {
-    strncpy(&url[url_len], subpath, COAP_OBSERVER_URL_LEN - url_len - 1);
-  }
-  /* Ensure url is null terminated because strncpy does not guarantee this */
-  url[COAP_OBSERVER_URL_LEN - 1] = '\0';
-  /* url now contains the notify URL that needs to match the observer */
-  PRINTF("Observe: Notification from %s\n", url);
+  coap_option_iterator_t it;
+  uint16_t len;
 
   coap_init_message(notification, COAP_TYPE_NON, CONTENT_2_05, 0);
   /* create a "fake" request for the URI */
   coap_init_message(request, COAP_TYPE_CON, COAP_GET, 0);
   coap_set_header_uri_path(request, url);
 
-  /* iterate over observers */
-  url_len = strlen(url);
-  for(obs = (coap_observer_t *)list_head(observers_list); obs;
-      obs = obs->next) {
-    obs_url_len = strlen(obs->url);
-
-    /* Do a match based on the parent/sub-resource match so that it is
-       possible to do parent-node observe */
-    if((obs_url_len == url_len
-        || (obs_url_len > url_len
-            && (resource->flags & HAS_SUB_RESOURCES)
-            && obs->url[url_len] == '/'))
-       && strncmp(url, obs->url, url_len) == 0) {
-      coap_transaction_t *transaction = NULL;
-
-      /*TODO implement special transaction for CON, sharing the same buffer to allow for more observers */
-
-      if((transaction = coap_new_transaction(coap_get_mid(), &obs->addr, obs->port))) {
-        if(obs->obs_counter % COAP_OBSERVE_REFRESH_INTERVAL == 0) {
-          PRINTF("           Force Confirmable for\n");
-          notification->type = COAP_TYPE_CON;
-        }
+  resource->get_handler(request, notification,
+                        notification_buffer + COAP_MAX_HEADER_SIZE,
+                        REST_MAX_CHUNK_SIZE, NULL);
 
-        PRINTF("           Observer ");
-        PRINT6ADDR(&obs->addr);
-        PRINTF(":%u\n", obs->port);
+  /* placeholder that takes the 3 bytes any observe counter may need */
+  if(notification->code < BAD_REQUEST_4_00) {
+    coap_set_header_observe(notification, 0xffffff);
+  }
+  len = coap_serialize_message(notification, notification_buffer);
 
-        /* update last MID for RST matching */
-        obs->last_mid = transaction->mid;
+  observe_offset = 0;
+  if(notification->code < BAD_REQUEST_4_00
+     && coap_option_iterator_init(&it, notification_buffer, len) == NO_ERROR) {
+    while(coap_option_iterator_next(&it) > 0) {
+      if(it.number == COAP_OPTION_OBSERVE) {
+        observe_offset = it.value - notification_buffer;
+        break;
+      }
+    }
+  }
+  return len;
+}
+/*---------------------------------------------------------------------------*/
+static void
+send_notification(coap_observer_t *obs, uint16_t len)
+{
+  coap_transaction_t *transaction = NULL;
+  coap_message_type_t type = COAP_TYPE_NON;
+  uint8_t *observe;
 
-        /* prepare response */
-        notification->mid = transaction->mid;
+  if(len + obs->token_len > COAP_MAX_PACKET_SIZE) {
+    return;
+  }
 
-        resource->get_handler(request, notification,
-                              transaction->packet + COAP_MAX_HEADER_SIZE,
-                              REST_MAX_CHUNK_SIZE, NULL);
+  /*TODO implement special transaction for CON, sharing the same buffer to allow for more observers */
 
-        if(notification->code < BAD_REQUEST_4_00) {
-          coap_set_header_observe(notification, (obs->obs_counter)++);
-          /* mask out to keep the CoAP observe option length <= 3 bytes */
-          obs->obs_counter &= 0xffffff;
-        }
-        coap_set_token(notification, obs->token, obs->token_len);
+  if((transaction = coap_new_transaction(coap_get_mid(), &obs->addr, obs->port))) {
+    if(obs->obs_counter % COAP_OBSERVE_REFRESH_INTERVAL == 0) {
+      PRINTF("           Force Confirmable for\n");
+      type = COAP_TYPE_CON;
+    }
+
+    PRINTF("           Observer ");
+    PRINT6ADDR(&obs->addr);
+    PRINTF(":%u\n", obs->port);
+
+    /* update last MID for RST matching */
+    obs->last_mid = transaction->mid;
+
+    /* copy the rendered notification, patching the observer fields in */
+    transaction->packet[0] = (1 << COAP_HEADER_VERSION_POSITION)
+      | (type << COAP_HEADER_TYPE_POSITION) | obs->token_len;
+    transaction->packet[1] = notification_buffer[1];
+    transaction->packet[2] = (uint8_t)(transaction->mid >> 8);
+    transaction->packet[3] = (uint8_t)(transaction->mid);
+    memcpy(transaction->packet + COAP_HEADER_LEN, obs->token, obs->token_len);
+    memcpy(transaction->packet + COAP_HEADER_LEN + obs->token_len,
+           notification_buffer + COAP_HEADER_LEN, len - COAP_HEADER_LEN);
+
+    if(observe_offset) {
+      observe = transaction->packet + observe_offset + obs->token_len;
+      observe[0] = (uint8_t)(obs->obs_counter >> 16);
+      observe[1] = (uint8_t)(obs->obs_counter >> 8);
+      observe[2] = (uint8_t)(obs->obs_counter);
+      (obs->obs_counter)++;
+      /* mask out to keep the CoAP observe option length <= 3 bytes */
+      obs->obs_counter &= 0xffffff;
+    }
+
+    transaction->packet_len = len + obs->token_len;
+
+    coap_send_transaction(transaction);
+  }
+}
+/*---------------------------------------------------------------------------*/
+#if COAP_OBSERVE_MIN_INTERVAL
+static void
+schedule_pending(void)
+{
+  coap_observer_t *obs = NULL;
+  clock_time_t now = clock_time();
+  clock_time_t wait = COAP_OBSERVE_MIN_INTERVAL;
+  clock_time_t elapsed;
+  int pending = 0;
 
-        transaction->packet_len =
-          coap_serialize_message(notification, transaction->packet);
+  for(obs = (coap_observer_t *)list_head(observers_list); obs;
+      obs = obs->next) {
+    if(obs->pending != NULL) {
+      elapsed = now - obs->last_notify;
+      if(elapsed >= COAP_OBSERVE_MIN_INTERVAL) {
+        wait = 0;
+      } else if(COAP_OBSERVE_MIN_INTERVAL - elapsed < wait) {
+        wait = COAP_OBSERVE_MIN_INTERVAL - elapsed;
+      }
+      pending = 1;
+    }
+  }
+  if(pending) {
+    ctimer_set(&pending_timer, wait, send_pending, NULL);
+  }
+}
+#endif /* COAP_OBSERVE_MIN_INTERVAL */
+/*---------------------------------------------------------------------------*/
+/*
+ * Notifies the observers of url, rendering the representation only once.
+ * With COAP_OBSERVE_MIN_INTERVAL, observers notified too recently are
+ * marked pending instead, and pending_only restricts the notifies to
+ * observers that are pending for this resource and URL.
+ */
+static void
+notify_observers(resource_t *resource, const char *url, int url_len,
+                 int pending_only)
+{
+  coap_observer_t *obs = NULL;
+  uint16_t len = 0;
+#if COAP_OBSERVE_MIN_INTERVAL
+  /* one time stamp keeps the observers of a notify in step */
+  clock_time_t now = clock_time();
+  int deferred = 0;
+#endif /* COAP_OBSERVE_MIN_INTERVAL */
+
+  for(obs = (coap_observer_t *)list_head(observers_list); obs;
+      obs = obs->next) {
+    if(!observer_matches(obs, resource, url, url_len)) {
+      continue;
+    }
+#if COAP_OBSERVE_MIN_INTERVAL
+    if(pending_only
+       && (obs->pending != resource || obs->pending_url_len != url_len)) {
+      continue;
+    }
+    if(now - obs->last_notify < COAP_OBSERVE_MIN_INTERVAL) {
+      /* coalesce, the notify sent later renders the latest state */
+      obs->pending = resource;
+      obs->pending_url_len = url_len;
+      deferred = 1;
+      continue;
+    }
+    obs->pending = NULL;
+    obs->last_notify = now;
+#endif /* COAP_OBSERVE_MIN_INTERVAL */
 
-        coap_send_transaction(transaction);
+    if(len == 0) {
+      len = render_notification(resource, url);
+      if(len == 0) {
+        break;
       }
     }
+    send_notification(obs, len);
+  }
+
+#if COAP_OBSERVE_MIN_INTERVAL
+  if(deferred && !pending_only) {
+    schedule_pending();
+  }
+#endif /* COAP_OBSERVE_MIN_INTERVAL */
+}
+/*---------------------------------------------------------------------------*/
+#if COAP_OBSERVE_MIN_INTERVAL
+static void
+send_pending(void *ptr)
+{
+  coap_observer_t *obs = NULL;
+  char url[COAP_OBSERVER_URL_LEN];
+
+  for(obs = (coap_observer_t *)list_head(observers_list); obs;
+      obs = obs->next) {
+    if(obs->pending != NULL
+       && clock_time() - obs->last_notify >= COAP_OBSERVE_MIN_INTERVAL) {
+      /* the notify URL is a prefix of the observer URL */
+      memcpy(url, obs->url, obs->pending_url_len);
+      url[obs->pending_url_len] = '\0';
+      notify_observers(obs->pending, url, obs->pending_url_len, 1);
+    }
+  }
+  schedule_pending();
+}
+#endif /* COAP_OBSERVE_MIN_INTERVAL */
+/*---------------------------------------------------------------------------*/
+void
+coap_notify_observers(resource_t *resource)
+{
+  coap_notify_observers_sub(resource, NULL);
+}
+void
+coap_notify_observers_sub(resource_t *resource, const char *subpath)
+{
+  int url_len;
+  char url[COAP_OBSERVER_URL_LEN];
+
+  url_len = strlen(resource->url);
+  strncpy(url, resource->url, COAP_OBSERVER_URL_LEN - 1);
+  if(url_len < COAP_OBSERVER_URL_LEN - 1 && subpath != NULL) {
+    strncpy(&url[url_len], subpath, COAP_OBSERVER_URL_LEN - url_len - 1);
   }
+  /* Ensure url is null terminated because strncpy does not guarantee this */
+  url[COAP_OBSERVER_URL_LEN - 1] = '\0';
+  /* url now contains the notify URL that needs to match the observer */
+  PRINTF("Observe: Notification from %s\n", url);
+
+  notify_observers(resource, url, strlen(url), 0);
 }
 /*---------------------------------------------------------------------------*/
 void
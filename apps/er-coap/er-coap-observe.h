@@ -65,6 +65,12 @@ typedef struct coap_observer {
 
   int32_t obs_counter;
 
+#if COAP_OBSERVE_MIN_INTERVAL
+  clock_time_t last_notify;
+  resource_t *pending;          /* resource with a coalesced change */
+  uint8_t pending_url_len;      /* length of the notify URL prefix */
+#endif /* COAP_OBSERVE_MIN_INTERVAL */
+
   struct etimer retrans_timer;
   uint8_t retrans_counter;
 } coap_observer_t;
@@ -439,10 +439,257 @@ coap_send_message(uip_ipaddr_t *addr, uint16_t port, uint8_t *data,
   udp_conn->rport = 0;
 }
 /*---------------------------------------------------------------------------*/
+/*- Streaming API -----------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+coap_status_t
+coap_option_iterator_init(coap_option_iterator_t *it, const uint8_t *data,
+                          uint16_t data_len)
+{
+  uint8_t token_len;
+
+  it->pos = data + data_len;
+  it->end = data + data_len;
+  it->number = 0;
+  it->value = NULL;
+  it->length = 0;
+
+  if(data_len < COAP_HEADER_LEN) {
+    coap_error_message = "Message shorter than CoAP header";
+    return BAD_REQUEST_4_00;
+  }
+  if(((COAP_HEADER_VERSION_MASK & data[0])
+      >> COAP_HEADER_VERSION_POSITION) != 1) {
+    coap_error_message = "CoAP version must be 1";
+    return BAD_REQUEST_4_00;
+  }
+  token_len = (COAP_HEADER_TOKEN_LEN_MASK & data[0])
+    >> COAP_HEADER_TOKEN_LEN_POSITION;
+  if(token_len > COAP_TOKEN_LEN) {
+    coap_error_message = "Token Length must not be more than 8";
+    return BAD_REQUEST_4_00;
+  }
+  if(data_len < COAP_HEADER_LEN + token_len) {
+    coap_error_message = "Token exceeds message";
+    return BAD_REQUEST_4_00;
+  }
+
+  it->pos = data + COAP_HEADER_LEN + token_len;
+  return NO_ERROR;
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Returns 1 and the next option, 0 at the end of the options with the
+ * payload in value/length (value is NULL without payload marker), or -1
+ * for a malformed option.
+ */
+int
+coap_option_iterator_next(coap_option_iterator_t *it)
+{
+  const uint8_t *p = it->pos;
+  unsigned int delta;
+  size_t length;
+
+  if(p >= it->end) {
+    it->value = NULL;
+    it->length = 0;
+    return 0;
+  }
+
+  /* payload marker 0xFF, currently only checking for 0xF* because rest is reserved */
+  if((p[0] & 0xF0) == 0xF0) {
+    it->value = p + 1;
+    it->length = it->end - it->value;
+    it->pos = it->end;
+    return 0;
+  }
+
+  delta = p[0] >> 4;
+  length = p[0] & 0x0F;
+  ++p;
+
+  if(delta == 13) {
+    if(it->end - p < 1) {
+      goto truncated;
+    }
+    delta += p[0];
+    ++p;
+  } else if(delta == 14) {
+    if(it->end - p < 2) {
+      goto truncated;
+    }
+    delta += 255 + (p[0] << 8) + p[1];
+    p += 2;
+  }
+
+  if(length == 13) {
+    if(it->end - p < 1) {
+      goto truncated;
+    }
+    length += p[0];
+    ++p;
+  } else if(length == 14) {
+    if(it->end - p < 2) {
+      goto truncated;
+    }
+    length += 255 + (p[0] << 8) + p[1];
+    p += 2;
+  } else if(length == 15) {
+    coap_error_message = "Reserved option length";
+    it->pos = it->end;
+    return -1;
+  }
+
+  if(length > it->end - p) {
+    goto truncated;
+  }
+
+  it->number += delta;
+  it->value = p;
+  it->length = length;
+  it->pos = p + length;
+  return 1;
+
+truncated:
+  coap_error_message = "Option exceeds message";
+  it->pos = it->end;
+  return -1;
+}
+/*---------------------------------------------------------------------------*/
+uint32_t
+coap_option_iterator_int(const coap_option_iterator_t *it)
+{
+  return coap_parse_int_option((uint8_t *)it->value, it->length);
+}
+/*---------------------------------------------------------------------------*/
+void
+coap_writer_init(coap_writer_t *w, uint8_t *buffer, size_t size,
+                 coap_message_type_t type, uint8_t code, uint16_t mid,
+                 const uint8_t *token, size_t token_len)
+{
+  w->buffer = buffer;
+  w->pos = buffer;
+  w->end = buffer + size;
+  w->number = 0;
+  w->payload = 0;
+  w->error = token_len > COAP_TOKEN_LEN || size < COAP_HEADER_LEN + token_len;
+  if(w->error) {
+    coap_error_message = "Buffer too small for CoAP header";
+    return;
+  }
+
+  buffer[0] = COAP_HEADER_VERSION_MASK & 1 << COAP_HEADER_VERSION_POSITION;
+  buffer[0] |= COAP_HEADER_TYPE_MASK & type << COAP_HEADER_TYPE_POSITION;
+  buffer[0] |= COAP_HEADER_TOKEN_LEN_MASK
+    & token_len << COAP_HEADER_TOKEN_LEN_POSITION;
+  buffer[1] = code;
+  buffer[2] = (uint8_t)(mid >> 8);
+  buffer[3] = (uint8_t)mid;
+  memcpy(buffer + COAP_HEADER_LEN, token, token_len);
+  w->pos = buffer + COAP_HEADER_LEN + token_len;
+}
+/*---------------------------------------------------------------------------*/
+/* Writes the header of the next option and returns where its value goes. */
+static uint8_t *
+coap_writer_option(coap_writer_t *w, unsigned int number, size_t length)
+{
+  unsigned int delta = number - w->number;
+  size_t header;
+
+  if(w->error || w->payload || number < w->number) {
+    /* options must be added in the order of their number */
+    coap_error_message = "Option out of order";
+    w->error = 1;
+    return NULL;
+  }
+
+  header = 1 + (delta > 268 ? 2 : delta > 12) + (length > 268 ? 2 : length > 12);
+  if(header + length > w->end - w->pos) {
+    coap_error_message = "Option exceeds buffer";
+    w->error = 1;
+    return NULL;
+  }
+
+  w->pos += coap_set_option_header(delta, length, w->pos);
+  w->number = number;
+  return w->pos;
+}
+/*---------------------------------------------------------------------------*/
+int
+coap_writer_add_option(coap_writer_t *w, unsigned int number,
+                       const void *value, size_t length)
+{
+  if(coap_writer_option(w, number, length) == NULL) {
+    return 0;
+  }
+  memcpy(w->pos, value, length);
+  w->pos += length;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+int
+coap_writer_add_int_option(coap_writer_t *w, unsigned int number,
+                           uint32_t value)
+{
+  size_t length;
+
+  length = value > 0xFFFFFF ? 4 : value > 0xFFFF ? 3 : value > 0xFF ? 2
+    : value > 0 ? 1 : 0;
+  if(coap_writer_option(w, number, length) == NULL) {
+    return 0;
+  }
+  while(length-- > 0) {
+    *w->pos++ = (uint8_t)(value >> (8 * length));
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/*
+ * Appends to the payload; can be called several times to gather the
+ * payload from several buffers. Data that already is in place is not
+ * copied.
+ */
+int
+coap_writer_add_payload(coap_writer_t *w, const void *data, size_t length)
+{
+  if(w->error) {
+    return 0;
+  }
+  if(length == 0) {
+    return 1;
+  }
+  if(length + !w->payload > w->end - w->pos) {
+    coap_error_message = "Payload exceeds buffer";
+    w->error = 1;
+    return 0;
+  }
+  if(!w->payload) {
+    *w->pos++ = 0xFF;
+    w->payload = 1;
+  }
+  if(data != w->pos) {
+    memmove(w->pos, data, length);
+  }
+  w->pos += length;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Returns the message length, or 0 if the message did not fit. */
+size_t
+coap_writer_finish(coap_writer_t *w)
+{
+  return w->error ? 0 : w->pos - w->buffer;
+}
+/*---------------------------------------------------------------------------*/
 coap_status_t
 coap_parse_message(void *packet, uint8_t *data, uint16_t data_len)
 {
   coap_packet_t *const coap_pkt = (coap_packet_t *)packet;
+  coap_option_iterator_t it;
+  coap_status_t status;
+  uint8_t *current_option;
+  unsigned int option_number;
+  size_t option_length;
+  int r;
 
   /* initialize packet */
   memset(coap_pkt, 0, sizeof(coap_packet_t));
@@ -450,29 +697,25 @@ coap_parse_message(void *packet, uint8_t *data, uint16_t data_len)
   /* pointer to packet bytes */
   coap_pkt->buffer = data;
 
-  /* parse header fields */
-  coap_pkt->version = (COAP_HEADER_VERSION_MASK & coap_pkt->buffer[0])
-    >> COAP_HEADER_VERSION_POSITION;
-  coap_pkt->type = (COAP_HEADER_TYPE_MASK & coap_pkt->buffer[0])
-    >> COAP_HEADER_TYPE_POSITION;
-  coap_pkt->token_len = (COAP_HEADER_TOKEN_LEN_MASK & coap_pkt->buffer[0])
-    >> COAP_HEADER_TOKEN_LEN_POSITION;
-  coap_pkt->code = coap_pkt->buffer[1];
-  coap_pkt->mid = coap_pkt->buffer[2] << 8 | coap_pkt->buffer[3];
-
-  if(coap_pkt->version != 1) {
-    coap_error_message = "CoAP version must be 1";
-    return BAD_REQUEST_4_00;
+  if(data_len >= COAP_HEADER_LEN) {
+    /* parse header fields */
+    coap_pkt->version = (COAP_HEADER_VERSION_MASK & coap_pkt->buffer[0])
+      >> COAP_HEADER_VERSION_POSITION;
+    coap_pkt->type = (COAP_HEADER_TYPE_MASK & coap_pkt->buffer[0])
+      >> COAP_HEADER_TYPE_POSITION;
+    coap_pkt->token_len = (COAP_HEADER_TOKEN_LEN_MASK & coap_pkt->buffer[0])
+      >> COAP_HEADER_TOKEN_LEN_POSITION;
+    coap_pkt->code = coap_pkt->buffer[1];
+    coap_pkt->mid = coap_pkt->buffer[2] << 8 | coap_pkt->buffer[3];
   }
 
-  if(coap_pkt->token_len > COAP_TOKEN_LEN) {
-    coap_error_message = "Token Length must not be more than 8";
-    return BAD_REQUEST_4_00;
+  /* checks the version, token length and message length */
+  status = coap_option_iterator_init(&it, data, data_len);
+  if(status != NO_ERROR) {
+    return status;
   }
 
-  uint8_t *current_option = data + COAP_HEADER_LEN;
-
-  memcpy(coap_pkt->token, current_option, coap_pkt->token_len);
+  memcpy(coap_pkt->token, data + COAP_HEADER_LEN, coap_pkt->token_len);
   PRINTF("Token (len %u) [0x%02X%02X%02X%02X%02X%02X%02X%02X]\n",
          coap_pkt->token_len, coap_pkt->token[0], coap_pkt->token[1],
          coap_pkt->token[2], coap_pkt->token[3], coap_pkt->token[4],
@@ -480,62 +723,18 @@ coap_parse_message(void *packet, uint8_t *data, uint16_t data_len)
          );                     /*FIXME always prints 8 bytes */
 
   /* parse options */
-  memset(coap_pkt->options, 0, sizeof(coap_pkt->options));
-  current_option += coap_pkt->token_len;
-
-  unsigned int option_number = 0;
-  unsigned int option_delta = 0;
-  size_t option_length = 0;
-
-  while(current_option < data + data_len) {
-    /* payload marker 0xFF, currently only checking for 0xF* because rest is reserved */
-    if((current_option[0] & 0xF0) == 0xF0) {
-      coap_pkt->payload = ++current_option;
-      coap_pkt->payload_len = data_len - (coap_pkt->payload - data);
-
-      /* also for receiving, the Erbium upper bound is REST_MAX_CHUNK_SIZE */
-      if(coap_pkt->payload_len > REST_MAX_CHUNK_SIZE) {
-        coap_pkt->payload_len = REST_MAX_CHUNK_SIZE;
-        /* null-terminate payload */
-      }
-      coap_pkt->payload[coap_pkt->payload_len] = '\0';
+  while((r = coap_option_iterator_next(&it)) > 0) {
+    /* the merged multi-options below are written in place */
+    current_option = (uint8_t *)it.value;
+    option_length = it.length;
+    option_number = it.number;
 
-      break;
-    }
+    PRINTF("OPTION %u (len %zu): ", option_number, option_length);
 
-    option_delta = current_option[0] >> 4;
-    option_length = current_option[0] & 0x0F;
-    ++current_option;
-
-    if(option_delta == 13) {
-      option_delta += current_option[0];
-      ++current_option;
-    } else if(option_delta == 14) {
-      option_delta += 255;
-      option_delta += current_option[0] << 8;
-      ++current_option;
-      option_delta += current_option[0];
-      ++current_option;
+    if(option_number <= COAP_OPTION_SIZE1) {
+      SET_OPTION(coap_pkt, option_number);
     }
 
-    if(option_length == 13) {
-      option_length += current_option[0];
-      ++current_option;
-    } else if(option_length == 14) {
-      option_length += 255;
-      option_length += current_option[0] << 8;
-      ++current_option;
-      option_length += current_option[0];
-      ++current_option;
-    }
-
-    option_number += option_delta;
-
-    PRINTF("OPTION %u (delta %u, len %zu): ", option_number, option_delta,
-           option_length);
-
-    SET_OPTION(coap_pkt, option_number);
-
     switch(option_number) {
     case COAP_OPTION_CONTENT_FORMAT:
       coap_pkt->content_format = coap_parse_int_option(current_option,
@@ -687,9 +886,22 @@ coap_parse_message(void *packet, uint8_t *data, uint16_t data_len)
         return BAD_OPTION_4_02;
       }
     }
+  }                             /* while */
+  if(r < 0) {
+    return BAD_REQUEST_4_00;
+  }
 
-    current_option += option_length;
-  }                             /* for */
+  if(it.value != NULL) {
+    coap_pkt->payload = (uint8_t *)it.value;
+    coap_pkt->payload_len = it.length;
+
+    /* also for receiving, the Erbium upper bound is REST_MAX_CHUNK_SIZE */
+    if(coap_pkt->payload_len > REST_MAX_CHUNK_SIZE) {
+      coap_pkt->payload_len = REST_MAX_CHUNK_SIZE;
+    }
+    /* null-terminate payload */
+    coap_pkt->payload[coap_pkt->payload_len] = '\0';
+  }
   PRINTF("-Done parsing-------\n");
 
   return NO_ERROR;
@@ -132,6 +132,25 @@ typedef struct {
   uint8_t *payload;
 } coap_packet_t;
 
+/* lazy iteration over the options of a raw message, without parsing it into a coap_packet_t */
+typedef struct {
+  const uint8_t *pos;    /* next option header */
+  const uint8_t *end;    /* end of the message */
+  unsigned int number;   /* number of the current option */
+  const uint8_t *value;  /* current option value, or payload at the end */
+  size_t length;         /* length of the value or payload */
+} coap_option_iterator_t;
+
+/* single-pass serialization straight into an output buffer, e.g., uip_appdata */
+typedef struct {
+  uint8_t *buffer;       /* start of the message */
+  uint8_t *pos;          /* next byte to write */
+  uint8_t *end;          /* end of the output buffer */
+  unsigned int number;   /* number of the last option written */
+  uint8_t payload;       /* payload marker written */
+  uint8_t error;         /* out of space or options out of order */
+} coap_writer_t;
+
 /* option format serialization */
 #define COAP_SERIALIZE_INT_OPTION(number, field, text) \
   if(IS_OPTION(coap_pkt, number)) { \
@@ -187,6 +206,23 @@ void coap_send_message(uip_ipaddr_t *addr, uint16_t port, uint8_t *data,
 coap_status_t coap_parse_message(void *request, uint8_t *data,
                                  uint16_t data_len);
 
+coap_status_t coap_option_iterator_init(coap_option_iterator_t *it,
+                                        const uint8_t *data,
+                                        uint16_t data_len);
+int coap_option_iterator_next(coap_option_iterator_t *it);
+uint32_t coap_option_iterator_int(const coap_option_iterator_t *it);
+
+void coap_writer_init(coap_writer_t *w, uint8_t *buffer, size_t size,
+                      coap_message_type_t type, uint8_t code, uint16_t mid,
+                      const uint8_t *token, size_t token_len);
+int coap_writer_add_option(coap_writer_t *w, unsigned int number,
+                           const void *value, size_t length);
+int coap_writer_add_int_option(coap_writer_t *w, unsigned int number,
+                               uint32_t value);
+int coap_writer_add_payload(coap_writer_t *w, const void *data,
+                            size_t length);
+size_t coap_writer_finish(coap_writer_t *w);
+
 int coap_get_query_variable(void *packet, const char *name,
                             const char **output);
 int coap_get_post_variable(void *packet, const char *name,
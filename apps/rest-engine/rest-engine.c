@@ -58,6 +58,152 @@ PROCESS(rest_engine_process, "REST Engine");
 /*---------------------------------------------------------------------------*/
 LIST(restful_services);
 LIST(restful_periodic_services);
+
+#if REST_PATH_INDEX_NODES
+/* A URI path segment; its children are the segments that follow it. */
+struct path_node {
+  struct path_node *child;
+  struct path_node *sibling;
+  const char *segment;     /* points into the URL of the first resource */
+  uint16_t segment_len;
+  uint16_t order;          /* activation order of the resource */
+  resource_t *resource;    /* resource with this path, if any */
+};
+
+MEMB(path_nodes, struct path_node, REST_PATH_INDEX_NODES);
+static struct path_node path_root;
+static uint16_t num_activated;
+/* A resource did not fit the index, so it is not used for dispatch. */
+static uint8_t path_index_full;
+#endif /* REST_PATH_INDEX_NODES */
+/*---------------------------------------------------------------------------*/
+#if REST_PATH_INDEX_NODES
+static struct path_node *
+path_index_child(struct path_node *node, const char *segment, size_t len)
+{
+  for(node = node->child; node != NULL; node = node->sibling) {
+    if(node->segment_len == len && memcmp(node->segment, segment, len) == 0) {
+      return node;
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+static void
+path_index_add(resource_t *resource)
+{
+  struct path_node *node, *child;
+  const char *segment, *end;
+
+  node = &path_root;
+  segment = resource->url;
+  for(;;) {
+    end = strchr(segment, '/');
+    if(end == NULL) {
+      end = segment + strlen(segment);
+    }
+    child = path_index_child(node, segment, end - segment);
+    if(child == NULL) {
+      child = memb_alloc(&path_nodes);
+      if(child == NULL) {
+        PRINTF("Path index full, dispatching by URL comparison\n");
+        path_index_full = 1;
+        return;
+      }
+      memset(child, 0, sizeof(*child));
+      child->segment = segment;
+      child->segment_len = end - segment;
+      child->sibling = node->child;
+      node->child = child;
+    }
+    node = child;
+    if(*end == '\0') {
+      break;
+    }
+    segment = end + 1;
+  }
+
+  /* As with the list, the first resource activated for a path wins. */
+  if(node->resource == NULL) {
+    node->resource = resource;
+    node->order = num_activated;
+  }
+  num_activated++;
+}
+/*---------------------------------------------------------------------------*/
+static resource_t *
+path_index_find(const char *url, int url_len)
+{
+  struct path_node *node, *found;
+  const char *segment, *end, *url_end;
+
+  found = NULL;
+  node = &path_root;
+  segment = url;
+  url_end = url + url_len;
+  for(;;) {
+    end = memchr(segment, '/', url_end - segment);
+    if(end == NULL) {
+      end = url_end;
+    }
+    node = path_index_child(node, segment, end - segment);
+    if(node == NULL) {
+      break;
+    }
+    /* The exact path and all parents with sub-resources match; the one
+       activated first is the one the list would have found. */
+    if(node->resource != NULL
+       && (end == url_end || (node->resource->flags & HAS_SUB_RESOURCES))
+       && (found == NULL || node->order < found->order)) {
+      found = node;
+    }
+    if(end == url_end) {
+      break;
+    }
+    segment = end + 1;
+  }
+  return found != NULL ? found->resource : NULL;
+}
+#endif /* REST_PATH_INDEX_NODES */
+/*---------------------------------------------------------------------------*/
+static resource_t *
+find_resource(const char *url, int url_len)
+{
+  resource_t *resource;
+  int res_url_len;
+
+#if REST_PATH_INDEX_NODES
+  if(!path_index_full) {
+    return path_index_find(url, url_len);
+  }
+#endif /* REST_PATH_INDEX_NODES */
+
+  for(resource = (resource_t *)list_head(restful_services);
+      resource; resource = resource->next) {
+
+    /* if the web service handles that kind of requests and urls matches */
+    res_url_len = strlen(resource->url);
+    if((url_len == res_url_len
+        || (url_len > res_url_len
+            && (resource->flags & HAS_SUB_RESOURCES)
+            && url[res_url_len] == '/'))
+       && strncmp(resource->url, url, res_url_len) == 0) {
+      return resource;
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+#if REST_WITH_STATS
+static void
+record_latency(resource_t *resource, rtimer_clock_t ticks)
+{
+  int i;
+
+  for(i = 0; i < REST_STATS_BUCKETS - 1 && ticks >= (1 << i); i++);
+  resource->stats.latency[i]++;
+}
+#endif /* REST_WITH_STATS */
 /*---------------------------------------------------------------------------*/
 /*- REST Engine API ---------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -80,6 +226,9 @@ rest_init_engine(void)
   initialized = 1;
 
   list_init(restful_services);
+#if REST_PATH_INDEX_NODES
+  memb_init(&path_nodes);
+#endif /* REST_PATH_INDEX_NODES */
 
   REST.set_service_callback(rest_invoke_restful_service);
 
@@ -104,6 +253,9 @@ rest_activate_resource(resource_t *resource, char *path)
 {
   resource->url = path;
   list_add(restful_services, resource);
+#if REST_PATH_INDEX_NODES
+  path_index_add(resource);
+#endif /* REST_PATH_INDEX_NODES */
 
   PRINTF("Activating: %s\n", resource->url);
 
@@ -141,45 +293,47 @@ rest_invoke_restful_service(void *request, void *response, uint8_t *buffer,
 
   resource_t *resource = NULL;
   const char *url = NULL;
-  int url_len, res_url_len;
+  int url_len;
+#if REST_WITH_STATS
+  rtimer_clock_t start;
+#endif /* REST_WITH_STATS */
 
   url_len = REST.get_url(request, &url);
-  for(resource = (resource_t *)list_head(restful_services);
-      resource; resource = resource->next) {
+  resource = find_resource(url, url_len);
+  if(resource != NULL) {
+    found = 1;
+    rest_resource_flags_t method = REST.get_method_type(request);
 
-    /* if the web service handles that kind of requests and urls matches */
-    res_url_len = strlen(resource->url);
-    if((url_len == res_url_len
-        || (url_len > res_url_len
-            && (resource->flags & HAS_SUB_RESOURCES)
-            && url[res_url_len] == '/'))
-       && strncmp(resource->url, url, res_url_len) == 0) {
-      found = 1;
-      rest_resource_flags_t method = REST.get_method_type(request);
-
-      PRINTF("/%s, method %u, resource->flags %u\n", resource->url,
-             (uint16_t)method, resource->flags);
-
-      if((method & METHOD_GET) && resource->get_handler != NULL) {
-        /* call handler function */
-        resource->get_handler(request, response, buffer, buffer_size, offset);
-      } else if((method & METHOD_POST) && resource->post_handler != NULL) {
-        /* call handler function */
-        resource->post_handler(request, response, buffer, buffer_size,
+    PRINTF("/%s, method %u, resource->flags %u\n", resource->url,
+           (uint16_t)method, resource->flags);
+
+#if REST_WITH_STATS
+    start = RTIMER_NOW();
+#endif /* REST_WITH_STATS */
+    if((method & METHOD_GET) && resource->get_handler != NULL) {
+      /* call handler function */
+      resource->get_handler(request, response, buffer, buffer_size, offset);
+    } else if((method & METHOD_POST) && resource->post_handler != NULL) {
+      /* call handler function */
+      resource->post_handler(request, response, buffer, buffer_size,
+                             offset);
+    } else if((method & METHOD_PUT) && resource->put_handler != NULL) {
+      /* call handler function */
+      resource->put_handler(request, response, buffer, buffer_size, offset);
+    } else if((method & METHOD_DELETE) && resource->delete_handler != NULL) {
+      /* call handler function */
+      resource->delete_handler(request, response, buffer, buffer_size,
                                offset);
-      } else if((method & METHOD_PUT) && resource->put_handler != NULL) {
-        /* call handler function */
-        resource->put_handler(request, response, buffer, buffer_size, offset);
-      } else if((method & METHOD_DELETE) && resource->delete_handler != NULL) {
-        /* call handler function */
-        resource->delete_handler(request, response, buffer, buffer_size,
-                                 offset);
-      } else {
-        allowed = 0;
-        REST.set_response_status(response, REST.status.METHOD_NOT_ALLOWED);
-      }
-      break;
+    } else {
+      allowed = 0;
+      REST.set_response_status(response, REST.status.METHOD_NOT_ALLOWED);
+    }
+#if REST_WITH_STATS
+    resource->stats.requests++;
+    if(allowed) {
+      record_latency(resource, RTIMER_NOW() - start);
     }
+#endif /* REST_WITH_STATS */
   }
   if(!found) {
     REST.set_response_status(response, REST.status.NOT_FOUND);
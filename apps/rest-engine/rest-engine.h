@@ -62,6 +62,38 @@
 #define REST_MAX_CHUNK_SIZE     64
 #endif
 
+/*
+ * Number of path segment nodes for indexing resources by their URI path.
+ * Each distinct segment prefix of an activated path takes one node, e.g.,
+ * "sensors/light" and "sensors/temp" take three. With 0, requests are
+ * dispatched by comparing the URL of every resource in turn, which is
+ * also the fallback when the nodes run out.
+ */
+#ifdef REST_CONF_PATH_INDEX_NODES
+#define REST_PATH_INDEX_NODES REST_CONF_PATH_INDEX_NODES
+#else
+#define REST_PATH_INDEX_NODES 0
+#endif
+
+/*
+ * Count the requests dispatched to each resource and keep a histogram
+ * of the time its handlers take.
+ */
+#ifdef REST_CONF_WITH_STATS
+#define REST_WITH_STATS REST_CONF_WITH_STATS
+#else
+#define REST_WITH_STATS 0
+#endif
+
+/* Histogram bucket i counts handlers that took less than 2^i rtimer ticks
+   (bucket 0: less than one tick); the last bucket counts all longer ones. */
+#define REST_STATS_BUCKETS 8
+
+struct rest_resource_stats {
+  uint32_t requests;
+  uint16_t latency[REST_STATS_BUCKETS];
+};
+
 struct resource_s;
 struct periodic_resource_s;
 
@@ -95,6 +127,9 @@ struct resource_s {
     restful_trigger_handler trigger;
     restful_trigger_handler resume;
   };
+#if REST_WITH_STATS
+  struct rest_resource_stats stats; /* left out of the RESOURCE macros: starts zeroed */
+#endif
 };
 typedef struct resource_s resource_t;
 
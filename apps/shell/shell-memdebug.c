@@ -40,6 +40,7 @@
 
 #include "contiki.h"
 #include "shell-memdebug.h"
+#include "lib/memb.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -55,6 +56,11 @@ SHELL_COMMAND(peek_command,
 	      "peek",
 	      "peek <address>: read a byte from address <address>",
 	      &shell_peek_process);
+PROCESS(shell_memb_process, "memb");
+SHELL_COMMAND(memb_command,
+	      "memb",
+	      "memb: show memory block pools: block size, blocks, in use, most in use, failed allocations",
+	      &shell_memb_process);
 /*---------------------------------------------------------------------------*/
 PROCESS_THREAD(shell_poke_process, ev, data)
 {
@@ -119,6 +125,28 @@ PROCESS_THREAD(shell_peek_process, ev, data)
   PROCESS_END();
 }
 /*---------------------------------------------------------------------------*/
+PROCESS_THREAD(shell_memb_process, ev, data)
+{
+#if MEMB_WITH_STATS
+  struct memb *m;
+  char buf[64];
+#endif /* MEMB_WITH_STATS */
+
+  PROCESS_BEGIN();
+
+#if MEMB_WITH_STATS
+  for(m = memb_pool_list(); m != NULL; m = m->next) {
+    snprintf(buf, sizeof(buf), "%s %u %u %u %u %u", m->name,
+             m->size, m->num, m->nused, m->max_used, m->failures);
+    shell_output_str(&memb_command, buf, "");
+  }
+#else /* MEMB_WITH_STATS */
+  shell_output_str(&memb_command, "memb statistics are off, see MEMB_CONF_WITH_STATS", "");
+#endif /* MEMB_WITH_STATS */
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
 void
 shell_memdebug_init(void)
 {
@@ -126,3 +154,9 @@ shell_memdebug_init(void)
   shell_register_command(&peek_command);
 }
 /*---------------------------------------------------------------------------*/
+void
+shell_memb_init(void)
+{
+  shell_register_command(&memb_command);
+}
+/*---------------------------------------------------------------------------*/
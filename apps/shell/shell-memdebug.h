@@ -43,5 +43,6 @@
 #include "shell.h"
 
 void shell_memdebug_init(void);
+void shell_memb_init(void);
 
 #endif /* SHELL_MEMDEBUG_H_ */
@@ -84,6 +84,24 @@
 #define COFFEE_EXTENDED_WEAR_LEVELLING  1
 #endif
 
+/*
+ * The number of slots in a RAM index that maps file names to the pages
+ * of their headers, so that opening a file does not require scanning
+ * the storage. Each slot also caches the end offset of its file. The
+ * index is built on first use; if it fills up, Coffee falls back to
+ * scanning until the storage is formatted. 0 disables the index.
+ */
+#ifdef COFFEE_CONF_NAME_INDEX_SIZE
+#define COFFEE_NAME_INDEX_SIZE COFFEE_CONF_NAME_INDEX_SIZE
+#endif
+#ifndef COFFEE_NAME_INDEX_SIZE
+#define COFFEE_NAME_INDEX_SIZE 0
+#endif
+
+#if COFFEE_NAME_INDEX_SIZE & (COFFEE_NAME_INDEX_SIZE - 1)
+#error COFFEE_NAME_INDEX_SIZE must be a power of two.
+#endif
+
 #if COFFEE_START & (COFFEE_SECTOR_SIZE - 1)
 #error COFFEE_START must point to the first byte in a sector.
 #endif
@@ -168,6 +186,9 @@ struct file {
   int16_t record_count;
   uint8_t references;
   uint8_t flags;
+#if COFFEE_NAME_INDEX_SIZE
+  uint16_t name_hash;
+#endif
 };
 
 /* The file descriptor structure. */
@@ -206,6 +227,23 @@ static struct file_desc coffee_fd_set[COFFEE_FD_SET_SIZE];
 static coffee_page_t next_free;
 static char gc_wait;
 
+#if COFFEE_NAME_INDEX_SIZE
+/* An index slot of an active file, free if page is INVALID_PAGE. */
+struct name_index_entry {
+  cfs_offset_t end;
+  coffee_page_t page;
+  uint16_t hash;
+};
+
+#define INDEX_UNBUILT   0
+#define INDEX_VALID     1
+#define INDEX_OVERFLOW  2
+
+static struct name_index_entry name_index[COFFEE_NAME_INDEX_SIZE];
+static unsigned name_index_count;
+static uint8_t name_index_state;
+#endif /* COFFEE_NAME_INDEX_SIZE */
+
 /*---------------------------------------------------------------------------*/
 static void
 write_header(struct file_header *hdr, coffee_page_t page)
@@ -413,6 +451,139 @@ next_file(coffee_page_t page, struct file_header *hdr)
   return page + hdr->max_pages;
 }
 /*---------------------------------------------------------------------------*/
+#if COFFEE_NAME_INDEX_SIZE
+static uint16_t
+name_hash(const char *name)
+{
+  uint32_t h;
+  int i;
+
+  /* FNV-1a over the characters that fit in a file header. */
+  h = 2166136261UL;
+  for(i = 0; i < COFFEE_NAME_LENGTH && name[i] != '\0'; i++) {
+    h ^= (uint8_t)name[i];
+    h *= 16777619UL;
+  }
+  return (uint16_t)(h ^ (h >> 16));
+}
+/*---------------------------------------------------------------------------*/
+static void
+index_clear(void)
+{
+  unsigned i;
+
+  for(i = 0; i < COFFEE_NAME_INDEX_SIZE; i++) {
+    name_index[i].page = INVALID_PAGE;
+  }
+  name_index_count = 0;
+}
+/*---------------------------------------------------------------------------*/
+static void
+index_add(coffee_page_t page, uint16_t hash, cfs_offset_t end)
+{
+  unsigned i;
+
+  if(name_index_state != INDEX_VALID) {
+    return;
+  }
+
+  /* Keep a free slot to terminate the probe sequences. */
+  if(name_index_count >= COFFEE_NAME_INDEX_SIZE - 1) {
+    PRINTF("Coffee: The name index is full\n");
+    name_index_state = INDEX_OVERFLOW;
+    return;
+  }
+
+  for(i = hash & (COFFEE_NAME_INDEX_SIZE - 1);
+      name_index[i].page != INVALID_PAGE;
+      i = (i + 1) & (COFFEE_NAME_INDEX_SIZE - 1));
+  name_index[i].page = page;
+  name_index[i].hash = hash;
+  name_index[i].end = end;
+  name_index_count++;
+}
+/*---------------------------------------------------------------------------*/
+static struct name_index_entry *
+index_lookup(coffee_page_t page, uint16_t hash)
+{
+  unsigned i;
+
+  if(name_index_state != INDEX_VALID) {
+    return NULL;
+  }
+
+  for(i = hash & (COFFEE_NAME_INDEX_SIZE - 1);
+      name_index[i].page != INVALID_PAGE;
+      i = (i + 1) & (COFFEE_NAME_INDEX_SIZE - 1)) {
+    if(name_index[i].page == page) {
+      return &name_index[i];
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+static void
+index_remove(coffee_page_t page, uint16_t hash)
+{
+  struct name_index_entry *entry;
+  unsigned i, j, home;
+
+  entry = index_lookup(page, hash);
+  if(entry == NULL) {
+    return;
+  }
+
+  /* Move later entries of the probe sequence into the hole, so that
+     lookups can stop at the first free slot. */
+  i = entry - name_index;
+  for(j = (i + 1) & (COFFEE_NAME_INDEX_SIZE - 1);
+      name_index[j].page != INVALID_PAGE;
+      j = (j + 1) & (COFFEE_NAME_INDEX_SIZE - 1)) {
+    home = name_index[j].hash & (COFFEE_NAME_INDEX_SIZE - 1);
+    if(((j - home) & (COFFEE_NAME_INDEX_SIZE - 1)) >=
+       ((j - i) & (COFFEE_NAME_INDEX_SIZE - 1))) {
+      name_index[i] = name_index[j];
+      i = j;
+    }
+  }
+  name_index[i].page = INVALID_PAGE;
+  name_index_count--;
+}
+/*---------------------------------------------------------------------------*/
+static void
+index_build(void)
+{
+  struct file_header hdr;
+  coffee_page_t page;
+
+  index_clear();
+  name_index_state = INDEX_VALID;
+
+  for(page = 0; page < COFFEE_PAGE_COUNT && name_index_state == INDEX_VALID;
+      page = next_file(page, &hdr)) {
+    read_header(&hdr, page);
+    if(HDR_ACTIVE(hdr) && !HDR_LOG(hdr)) {
+      index_add(page, name_hash(hdr.name), UNKNOWN_OFFSET);
+    }
+  }
+  PRINTF("Coffee: Indexed %u files\n", name_index_count);
+}
+/*---------------------------------------------------------------------------*/
+/* Save the end offset of a file object that is about to be reused. */
+static void
+index_save_end(struct file *file)
+{
+  struct name_index_entry *entry;
+
+  if(!FILE_FREE(file)) {
+    entry = index_lookup(file->page, file->name_hash);
+    if(entry != NULL) {
+      entry->end = file->end;
+    }
+  }
+}
+#endif /* COFFEE_NAME_INDEX_SIZE */
+/*---------------------------------------------------------------------------*/
 static struct file *
 load_file(coffee_page_t start, struct file_header *hdr)
 {
@@ -442,6 +613,10 @@ load_file(coffee_page_t start, struct file_header *hdr)
   }
 
   file = &coffee_files[i];
+#if COFFEE_NAME_INDEX_SIZE
+  index_save_end(file);
+  file->name_hash = name_hash(hdr->name);
+#endif
   file->page = start;
   file->end = UNKNOWN_OFFSET;
   file->max_pages = hdr->max_pages;
@@ -452,6 +627,47 @@ load_file(coffee_page_t start, struct file_header *hdr)
   return file;
 }
 /*---------------------------------------------------------------------------*/
+#if COFFEE_NAME_INDEX_SIZE
+static struct file *
+find_indexed_file(const char *name)
+{
+  int i;
+  unsigned slot;
+  uint16_t hash;
+  struct file_header hdr;
+  struct file *file;
+
+  hash = name_hash(name);
+  for(slot = hash & (COFFEE_NAME_INDEX_SIZE - 1);
+      name_index[slot].page != INVALID_PAGE;
+      slot = (slot + 1) & (COFFEE_NAME_INDEX_SIZE - 1)) {
+    if(name_index[slot].hash != hash) {
+      continue;
+    }
+
+    read_header(&hdr, name_index[slot].page);
+    if(!HDR_ACTIVE(hdr) || HDR_LOG(hdr) || strcmp(name, hdr.name) != 0) {
+      continue;
+    }
+
+    for(i = 0; i < COFFEE_MAX_OPEN_FILES; i++) {
+      if(!FILE_FREE(&coffee_files[i]) &&
+         coffee_files[i].page == name_index[slot].page) {
+        return &coffee_files[i];
+      }
+    }
+
+    file = load_file(name_index[slot].page, &hdr);
+    if(file != NULL) {
+      file->end = name_index[slot].end;
+    }
+    return file;
+  }
+
+  return NULL;
+}
+#endif /* COFFEE_NAME_INDEX_SIZE */
+/*---------------------------------------------------------------------------*/
 static struct file *
 find_file(const char *name)
 {
@@ -459,6 +675,15 @@ find_file(const char *name)
   struct file_header hdr;
   coffee_page_t page;
 
+#if COFFEE_NAME_INDEX_SIZE
+  if(name_index_state == INDEX_UNBUILT) {
+    index_build();
+  }
+  if(name_index_state == INDEX_VALID) {
+    return find_indexed_file(name);
+  }
+#endif /* COFFEE_NAME_INDEX_SIZE */
+
   /* First check if the file metadata is cached. */
   for(i = 0; i < COFFEE_MAX_OPEN_FILES; i++) {
     if(FILE_FREE(&coffee_files[i])) {
@@ -575,6 +800,14 @@ remove_by_page(coffee_page_t page, int remove_log,
 
   gc_wait = 0;
 
+#if COFFEE_NAME_INDEX_SIZE
+  /* The garbage collector only erases obsolete pages, so the index
+     needs no other update. */
+  if(!HDR_LOG(hdr)) {
+    index_remove(page, name_hash(hdr.name));
+  }
+#endif /* COFFEE_NAME_INDEX_SIZE */
+
   /* Close all file descriptors that reference the removed file. */
   if(close_fds) {
     for(i = 0; i < COFFEE_FD_SET_SIZE; i++) {
@@ -637,6 +870,12 @@ reserve(const char *name, coffee_page_t pages,
   hdr.flags = HDR_FLAG_ALLOCATED | flags;
   write_header(&hdr, page);
 
+#if COFFEE_NAME_INDEX_SIZE
+  if(!HDR_LOG(hdr)) {
+    index_add(page, name_hash(hdr.name), 0);
+  }
+#endif /* COFFEE_NAME_INDEX_SIZE */
+
   PRINTF("Coffee: Reserved %u pages starting from %u for file %s\n",
          (unsigned)pages, (unsigned)page, name);
 
@@ -1338,6 +1577,10 @@ cfs_coffee_format(void)
   memset(&coffee_fd_set, 0, sizeof(coffee_fd_set));
   next_free = 0;
   gc_wait = 1;
+#if COFFEE_NAME_INDEX_SIZE
+  index_clear();
+  name_index_state = INDEX_VALID;
+#endif
 
   PRINTF(" done!\n");
 
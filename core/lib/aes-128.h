@@ -65,6 +65,15 @@ struct aes_128_driver {
    * \brief Encrypts.
    */
   void (* encrypt)(uint8_t *plaintext_and_result);
+
+  /**
+   * \brief Encrypts two independent blocks.
+   *
+   *        Lets drivers that can overlap the rounds of two blocks do so,
+   *        e.g. for the CBC-MAC and CTR blocks of CCM*. May be NULL, in
+   *        which case encrypt is called for each block.
+   */
+  void (* encrypt_pair)(uint8_t *a_and_result, uint8_t *b_and_result);
 };
 
 /**
@@ -74,4 +83,14 @@ void aes_128_set_padded_key(uint8_t *key, uint8_t key_len);
 
 extern const struct aes_128_driver AES_128;
 
+/**
+ * \brief Software AES-128 using 32-bit lookup tables
+ *
+ *        Four table lookups per column and round replace the byte-wise
+ *        ShiftRows and MixColumns of aes_128_driver, at the cost of 1 kB
+ *        of constant data. The lookups depend on the data, so it is not
+ *        constant time on CPUs with a data cache.
+ */
+extern const struct aes_128_driver aes_128_ttable_driver;
+
 #endif /* AES_128_H_ */
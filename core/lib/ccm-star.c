@@ -59,85 +59,47 @@ set_iv(uint8_t *iv,
   iv[15] = counter;
 }
 /*---------------------------------------------------------------------------*/
-/* XORs the block m[pos] ... m[pos + 15] with K_{counter} */
 static void
-ctr_step(const uint8_t *nonce,
-    uint8_t pos,
-    uint8_t *m_and_result,
-    uint8_t m_len,
-    uint8_t counter)
+encrypt_pair(uint8_t *a, uint8_t *b)
 {
-  uint8_t a[AES_128_BLOCK_SIZE];
-  uint8_t i;
-  
-  set_iv(a, CCM_STAR_ENCRYPTION_FLAGS, nonce, counter);
-  AES_128.encrypt(a);
-  
-  for(i = 0; (pos + i < m_len) && (i < AES_128_BLOCK_SIZE); i++) {
-    m_and_result[pos + i] ^= a[i];
+  if(AES_128.encrypt_pair) {
+    AES_128.encrypt_pair(a, b);
+  } else {
+    AES_128.encrypt(a);
+    AES_128.encrypt(b);
   }
 }
 /*---------------------------------------------------------------------------*/
+/* Absorbs the additional authenticated data into the CBC-MAC state x.
+   Leaves x with its last block XORed in but not yet encrypted. */
 static void
-mic(const uint8_t *nonce,
-    const uint8_t *m, uint8_t m_len,
+mic_header(const uint8_t *nonce,
+    uint8_t m_len,
     const uint8_t *a, uint8_t a_len,
-    uint8_t *result,
+    uint8_t *x,
     uint8_t mic_len)
 {
-  uint8_t x[AES_128_BLOCK_SIZE];
   uint8_t pos;
   uint8_t i;
   
   set_iv(x, CCM_STAR_AUTH_FLAGS(a_len, mic_len), nonce, m_len);
-  AES_128.encrypt(x);
   
   if(a_len) {
+    AES_128.encrypt(x);
     x[1] = x[1] ^ a_len;
     for(i = 2; (i - 2 < a_len) && (i < AES_128_BLOCK_SIZE); i++) {
       x[i] ^= a[i - 2];
     }
     
-    AES_128.encrypt(x);
-    
     pos = 14;
     while(pos < a_len) {
+      AES_128.encrypt(x);
       for(i = 0; (pos + i < a_len) && (i < AES_128_BLOCK_SIZE); i++) {
         x[i] ^= a[pos + i];
       }
       pos += AES_128_BLOCK_SIZE;
-      AES_128.encrypt(x);
-    }
-  }
-  
-  if(m_len) {
-    pos = 0;
-    while(pos < m_len) {
-      for(i = 0; (pos + i < m_len) && (i < AES_128_BLOCK_SIZE); i++) {
-        x[i] ^= m[pos + i];
-      }
-      pos += AES_128_BLOCK_SIZE;
-      AES_128.encrypt(x);
     }
   }
-  
-  ctr_step(nonce, 0, x, AES_128_BLOCK_SIZE, 0);
-  
-  memcpy(result, x, mic_len);
-}
-/*---------------------------------------------------------------------------*/
-static void
-ctr(const uint8_t *nonce, uint8_t *m, uint8_t m_len)
-{
-  uint8_t pos;
-  uint8_t counter;
-  
-  pos = 0;
-  counter = 1;
-  while(pos < m_len) {
-    ctr_step(nonce, pos, m, m_len, counter++);
-    pos += AES_128_BLOCK_SIZE;
-  }
 }
 /*---------------------------------------------------------------------------*/
 static void
@@ -146,6 +108,13 @@ set_key(const uint8_t *key)
   AES_128.set_key(key);
 }
 /*---------------------------------------------------------------------------*/
+/*
+ * The CBC-MAC and the CTR encryption each take one block cipher call per
+ * 16 bytes of m. The pending CBC-MAC block is encrypted together with the
+ * key stream block of the next 16 bytes, and the final one together with
+ * the block that encrypts the MIC, so drivers with encrypt_pair can
+ * overlap them. Without a MIC, the CBC-MAC is skipped.
+ */
 static void
 aead(const uint8_t* nonce,
     uint8_t* m, uint8_t m_len,
@@ -153,20 +122,47 @@ aead(const uint8_t* nonce,
     uint8_t *result, uint8_t mic_len,
     int forward)
 {
-  if(!forward) {
-    /* decrypt */
-    ctr(nonce, m, m_len);
+  uint8_t x[AES_128_BLOCK_SIZE];
+  uint8_t s[AES_128_BLOCK_SIZE];
+  uint8_t pos;
+  uint8_t counter;
+  uint8_t i;
+  
+  if(mic_len) {
+    mic_header(nonce, m_len, a, a_len, x, mic_len);
   }
   
-  mic(nonce,
-    m, m_len,
-    a, a_len,
-    result,
-    mic_len);
+  pos = 0;
+  counter = 1;
+  while(pos < m_len) {
+    set_iv(s, CCM_STAR_ENCRYPTION_FLAGS, nonce, counter++);
+    if(mic_len) {
+      encrypt_pair(x, s);
+    } else {
+      AES_128.encrypt(s);
+    }
+    for(i = 0; (pos + i < m_len) && (i < AES_128_BLOCK_SIZE); i++) {
+      if(!mic_len) {
+        m[pos + i] ^= s[i];
+      } else if(forward) {
+        /* authenticate, then encrypt */
+        x[i] ^= m[pos + i];
+        m[pos + i] ^= s[i];
+      } else {
+        /* decrypt, then authenticate */
+        m[pos + i] ^= s[i];
+        x[i] ^= m[pos + i];
+      }
+    }
+    pos += AES_128_BLOCK_SIZE;
+  }
   
-  if(forward) {
-    /* encrypt */
-    ctr(nonce, m, m_len);
+  if(mic_len) {
+    set_iv(s, CCM_STAR_ENCRYPTION_FLAGS, nonce, 0);
+    encrypt_pair(x, s);
+    for(i = 0; i < mic_len; i++) {
+      result[i] = x[i] ^ s[i];
+    }
   }
 }
 /*---------------------------------------------------------------------------*/
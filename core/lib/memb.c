@@ -47,57 +47,135 @@
 #include "contiki.h"
 #include "lib/memb.h"
 
+/* Index of the lowest set bit of a nonzero word */
+#ifdef __GNUC__
+#define FIRST_SET(w) __builtin_ctz(w)
+#else /* __GNUC__ */
+static int
+first_set(memb_word_t w)
+{
+  int i = 0;
+
+  while((w & 1) == 0) {
+    w >>= 1;
+    i++;
+  }
+  return i;
+}
+#define FIRST_SET(w) first_set(w)
+#endif /* __GNUC__ */
+
+#define BIT(i) ((memb_word_t)1 << ((i) % MEMB_WORD_BITS))
+
+#if MEMB_WITH_STATS
+static struct memb *pools;
+static struct memb *pools_tail;
+/*---------------------------------------------------------------------------*/
+static void
+pool_register(struct memb *m)
+{
+  if(m->next != NULL || m == pools_tail) {
+    /* Already registered */
+    return;
+  }
+  if(pools_tail == NULL) {
+    pools = m;
+  } else {
+    pools_tail->next = m;
+  }
+  pools_tail = m;
+}
+/*---------------------------------------------------------------------------*/
+struct memb *
+memb_pool_list(void)
+{
+  return pools;
+}
+#endif /* MEMB_WITH_STATS */
 /*---------------------------------------------------------------------------*/
 void
 memb_init(struct memb *m)
 {
-  memset(m->count, 0, m->num);
+  memset(m->used, 0, MEMB_WORDS(m->num) * sizeof(memb_word_t));
   memset(m->mem, 0, m->size * m->num);
+  m->nused = 0;
+  m->free_word = 0;
+#if MEMB_WITH_STATS
+  pool_register(m);
+#endif /* MEMB_WITH_STATS */
 }
 /*---------------------------------------------------------------------------*/
 void *
 memb_alloc(struct memb *m)
 {
+  unsigned short w;
+  memb_word_t free_bits;
   int i;
 
-  for(i = 0; i < m->num; ++i) {
-    if(m->count[i] == 0) {
-      /* If this block was unused, we increase the reference count to
-	 indicate that it now is used and return a pointer to the
-	 memory block. */
-      ++(m->count[i]);
-      return (void *)((char *)m->mem + (i * m->size));
+#if MEMB_WITH_STATS
+  pool_register(m);
+#endif /* MEMB_WITH_STATS */
+
+  if(m->nused < m->num) {
+    /* Words before free_word are full, so the first free block is found
+       by looking at one word per MEMB_WORD_BITS blocks from there. */
+    for(w = m->free_word; w < MEMB_WORDS(m->num); w++) {
+      free_bits = ~m->used[w];
+      if(free_bits != 0) {
+        i = w * MEMB_WORD_BITS + FIRST_SET(free_bits);
+        if(i >= m->num) {
+          /* Only the unused bits past the last block are clear */
+          break;
+        }
+        /* This block was unused, mark it as used and return a pointer
+           to it. */
+        m->used[w] |= BIT(i);
+        m->free_word = w;
+        m->nused++;
+#if MEMB_WITH_STATS
+        if(m->nused > m->max_used) {
+          m->max_used = m->nused;
+        }
+#endif /* MEMB_WITH_STATS */
+        return (void *)((char *)m->mem + (i * m->size));
+      }
     }
   }
 
   /* No free block was found, so we return NULL to indicate failure to
      allocate block. */
+#if MEMB_WITH_STATS
+  m->failures++;
+#endif /* MEMB_WITH_STATS */
   return NULL;
 }
 /*---------------------------------------------------------------------------*/
 char
 memb_free(struct memb *m, void *ptr)
 {
+  unsigned long offset;
   int i;
-  char *ptr2;
 
-  /* Walk through the list of blocks and try to find the block to
-     which the pointer "ptr" points to. */
-  ptr2 = (char *)m->mem;
-  for(i = 0; i < m->num; ++i) {
-    
-    if(ptr2 == (char *)ptr) {
-      /* We've found to block to which "ptr" points so we decrease the
-	 reference count and return the new value of it. */
-      if(m->count[i] > 0) {
-	/* Make sure that we don't deallocate free memory. */
-	--(m->count[i]);
-      }
-      return m->count[i];
+  /* Find the block from its offset rather than by walking the blocks. */
+  if(!memb_inmemb(m, ptr)) {
+    return -1;
+  }
+  offset = (char *)ptr - (char *)m->mem;
+  if(offset % m->size != 0) {
+    return -1;
+  }
+  i = offset / m->size;
+
+  /* Make sure that we don't deallocate free memory. */
+  if(m->used[i / MEMB_WORD_BITS] & BIT(i)) {
+    m->used[i / MEMB_WORD_BITS] &= ~BIT(i);
+    m->nused--;
+    if(i / MEMB_WORD_BITS < m->free_word) {
+      m->free_word = i / MEMB_WORD_BITS;
     }
-    ptr2 += m->size;
   }
-  return -1;
+  /* The block is no longer referenced */
+  return 0;
 }
 /*---------------------------------------------------------------------------*/
 int
@@ -110,15 +188,6 @@ memb_inmemb(struct memb *m, void *ptr)
 int
 memb_numfree(struct memb *m)
 {
-  int i;
-  int num_free = 0;
-
-  for(i = 0; i < m->num; ++i) {
-    if(m->count[i] == 0) {
-      ++num_free;
-    }
-  }
-
-  return num_free;
+  return m->num - m->nused;
 }
 /** @} */
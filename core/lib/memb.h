@@ -65,6 +65,33 @@
 
 #include "sys/cc.h"
 
+/**
+ * Keep per-pool statistics: the number of blocks in use, the
+ * high-water mark and the number of failed allocations. Pools are
+ * registered when first initialized or allocated from, and can be
+ * listed with memb_pool_list(), e.g. by the "memb" shell command.
+ */
+#ifdef MEMB_CONF_WITH_STATS
+#define MEMB_WITH_STATS MEMB_CONF_WITH_STATS
+#else /* MEMB_CONF_WITH_STATS */
+#define MEMB_WITH_STATS 0
+#endif /* MEMB_CONF_WITH_STATS */
+
+/**
+ * The word in which a pool records which of its blocks are in use,
+ * one bit per block.
+ */
+typedef unsigned int memb_word_t;
+
+#define MEMB_WORD_BITS (sizeof(memb_word_t) * 8)
+#define MEMB_WORDS(num) (((num) + MEMB_WORD_BITS - 1) / MEMB_WORD_BITS)
+
+#if MEMB_WITH_STATS
+#define MEMB_STATS_INIT(name) , NULL, #name, 0, 0
+#else /* MEMB_WITH_STATS */
+#define MEMB_STATS_INIT(name)
+#endif /* MEMB_WITH_STATS */
+
 /**
  * Declare a memory block.
  *
@@ -87,17 +114,26 @@ MEMB(connections, struct connection, 16);
  *
  */
 #define MEMB(name, structure, num) \
-        static char CC_CONCAT(name,_memb_count)[num]; \
+        static memb_word_t CC_CONCAT(name,_memb_used)[MEMB_WORDS(num)]; \
         static structure CC_CONCAT(name,_memb_mem)[num]; \
         static struct memb name = {sizeof(structure), num, \
-                                          CC_CONCAT(name,_memb_count), \
-                                          (void *)CC_CONCAT(name,_memb_mem)}
+                                          CC_CONCAT(name,_memb_used), \
+                                          (void *)CC_CONCAT(name,_memb_mem), \
+                                          0, 0 MEMB_STATS_INIT(name)}
 
 struct memb {
   unsigned short size;
   unsigned short num;
-  char *count;
+  memb_word_t *used;       /* one bit per block, set when allocated */
   void *mem;
+  unsigned short nused;    /* number of blocks in use */
+  unsigned short free_word; /* no free block before this word of used */
+#if MEMB_WITH_STATS
+  struct memb *next;       /* next registered pool */
+  const char *name;
+  unsigned short max_used; /* high-water mark of nused */
+  unsigned short failures; /* allocations that found no free block */
+#endif /* MEMB_WITH_STATS */
 };
 
 /**
@@ -130,8 +166,22 @@ char  memb_free(struct memb *m, void *ptr);
 
 int memb_inmemb(struct memb *m, void *ptr);
 
+/**
+ * Get the number of free blocks in a memory block.
+ *
+ * \param m A memory block previously declared with MEMB().
+ */
 int  memb_numfree(struct memb *m);
 
+#if MEMB_WITH_STATS
+/**
+ * Get the first of the memory blocks registered for statistics.
+ * The others follow through the next field, the last one has
+ * next set to NULL.
+ */
+struct memb *memb_pool_list(void);
+#endif /* MEMB_WITH_STATS */
+
 /** @} */
 /** @} */
 
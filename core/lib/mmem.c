@@ -55,10 +55,224 @@
 #define MMEM_SIZE 4096
 #endif
 
-LIST(mmemlist);
 unsigned int avail_memory;
+static unsigned int used_memory;
+static unsigned int compactions;
+static unsigned int failures;
+
+#if MMEM_WITH_SIZE_CLASSES
+
+#ifdef MMEM_CONF_NUM_CLASSES
+#define MMEM_NUM_CLASSES MMEM_CONF_NUM_CLASSES
+#else
+#define MMEM_NUM_CLASSES 24
+#endif
+
+/*
+ * The memory is an array of units, each large enough for a pointer.
+ * A block is one header unit followed by the units of its size
+ * class. The header of an allocated block points to its struct mmem;
+ * the header of a freed block is NULL and its first two units hold
+ * the next free block of the same class and the class itself. Blocks
+ * are carved from the top of the memory when their free list is
+ * empty. Class c has (2 + (c & 1)) << (c >> 1) units: 2, 3, 4, 6, 8,
+ * 12, ..., so that rounding wastes at most a third of a block.
+ */
+union unit {
+  struct mmem *owner;
+  union unit *next;
+  unsigned int cls;
+};
+
+#define UNITS (MMEM_SIZE / sizeof(union unit))
+#define CLASS_UNITS(c) ((2U + ((c) & 1)) << ((c) >> 1))
+
+static union unit memory[UNITS];
+static union unit *free_list[MMEM_NUM_CLASSES];
+/* First unit that has never been carved into a block since the last
+   compaction. */
+static unsigned int top;
+/* Units held by freed blocks, including their headers. */
+static unsigned int free_units;
+/* Units held by allocated blocks, including their headers. */
+static unsigned int alloc_units;
+
+/*---------------------------------------------------------------------------*/
+static int
+size_class(unsigned int size)
+{
+  unsigned int units;
+  int c;
+
+  units = (size + sizeof(union unit) - 1) / sizeof(union unit);
+  for(c = 0; c < MMEM_NUM_CLASSES; c++) {
+    if(CLASS_UNITS(c) >= units) {
+      return c;
+    }
+  }
+  return -1;
+}
+/*---------------------------------------------------------------------------*/
+/* Slide the allocated blocks down over the freed ones, which leaves
+   the free lists empty. */
+void
+mmem_compact(void)
+{
+  unsigned int i, dst, units;
+  struct mmem *m;
+
+  dst = 0;
+  for(i = 0; i < top; i += units) {
+    m = memory[i].owner;
+    if(m == NULL) {
+      units = 1 + CLASS_UNITS(memory[i + 2].cls);
+      continue;
+    }
+    units = 1 + CLASS_UNITS(size_class(m->size));
+    if(dst != i) {
+      memmove(&memory[dst], &memory[i], units * sizeof(union unit));
+      m->ptr = &memory[dst + 1];
+    }
+    dst += units;
+  }
+  top = dst;
+  free_units = 0;
+  memset(free_list, 0, sizeof(free_list));
+  compactions++;
+}
+/*---------------------------------------------------------------------------*/
+int
+mmem_alloc(struct mmem *m, unsigned int size)
+{
+  union unit *b;
+  unsigned int units;
+  int c;
+
+  c = size_class(size);
+  if(c < 0) {
+    failures++;
+    return 0;
+  }
+  units = 1 + CLASS_UNITS(c);
+
+  if(free_list[c] != NULL) {
+    /* Reuse a freed block of the same class. */
+    b = free_list[c];
+    free_list[c] = b[1].next;
+    free_units -= units;
+  } else {
+    if(UNITS - top < units && UNITS - top + free_units >= units) {
+      mmem_compact();
+    }
+    if(UNITS - top < units) {
+      failures++;
+      return 0;
+    }
+    b = &memory[top];
+    top += units;
+  }
+
+  b[0].owner = m;
+  m->ptr = &b[1];
+  m->size = size;
+  alloc_units += units;
+  used_memory += size;
+  avail_memory = (UNITS - alloc_units) * sizeof(union unit);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+void
+mmem_free(struct mmem *m)
+{
+  union unit *b;
+  int c;
+
+  b = (union unit *)m->ptr - 1;
+  c = size_class(m->size);
+
+  b[0].owner = NULL;
+  b[1].next = free_list[c];
+  b[2].cls = c;
+  free_list[c] = b;
+
+  free_units += 1 + CLASS_UNITS(c);
+  alloc_units -= 1 + CLASS_UNITS(c);
+  used_memory -= m->size;
+  avail_memory = (UNITS - alloc_units) * sizeof(union unit);
+}
+/*---------------------------------------------------------------------------*/
+void
+mmem_stats(struct mmem_stats *stats)
+{
+  stats->size = UNITS * sizeof(union unit);
+  stats->used = used_memory;
+  stats->overhead = alloc_units * sizeof(union unit) - used_memory;
+  stats->free = free_units * sizeof(union unit);
+  stats->top = (UNITS - top) * sizeof(union unit);
+  stats->compactions = compactions;
+  stats->failures = failures;
+}
+/*---------------------------------------------------------------------------*/
+void
+mmem_init(void)
+{
+  static int inited = 0;
+  if(inited) {
+    return;
+  }
+  top = 0;
+  free_units = 0;
+  alloc_units = 0;
+  avail_memory = UNITS * sizeof(union unit);
+  inited = 1;
+}
+#else /* MMEM_WITH_SIZE_CLASSES */
+
+LIST(mmemlist);
 static char memory[MMEM_SIZE];
+#if MMEM_DEFERRED_COMPACTION
+/* Bytes of freed blocks that have not been compacted yet. */
+static unsigned int holes;
+#else
+#define holes 0
+#endif /* MMEM_DEFERRED_COMPACTION */
 
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief      Compact the managed memory
+ *
+ *             This function moves all allocated blocks to the start
+ *             of the managed memory, so that the memory of freed
+ *             blocks becomes one contiguous area again. The pointers
+ *             of the blocks are updated. Without
+ *             MMEM_CONF_DEFERRED_COMPACTION, the memory is always
+ *             compacted and this function does nothing.
+ *
+ */
+void
+mmem_compact(void)
+{
+#if MMEM_DEFERRED_COMPACTION
+  struct mmem *n;
+  char *dst;
+
+  if(holes == 0) {
+    return;
+  }
+
+  /* The list is in address order, as blocks are added at the end. */
+  dst = memory;
+  for(n = list_head(mmemlist); n != NULL; n = n->next) {
+    if(n->ptr != dst) {
+      memmove(dst, n->ptr, n->size);
+      n->ptr = dst;
+    }
+    dst += n->size;
+  }
+  holes = 0;
+  compactions++;
+#endif /* MMEM_DEFERRED_COMPACTION */
+}
 /*---------------------------------------------------------------------------*/
 /**
  * \brief      Allocate a managed memory block
@@ -84,22 +298,30 @@ mmem_alloc(struct mmem *m, unsigned int size)
 {
   /* Check if we have enough memory left for this allocation. */
   if(avail_memory < size) {
+    failures++;
     return 0;
   }
 
+  /* Close the holes left by freed blocks if the allocation does not
+     fit after the last block. */
+  if(avail_memory - holes < size) {
+    mmem_compact();
+  }
+
   /* We had enough memory so we add this memory block to the end of
      the list of allocated memory blocks. */
   list_add(mmemlist, m);
 
   /* Set up the pointer so that it points to the first available byte
      in the memory block. */
-  m->ptr = &memory[MMEM_SIZE - avail_memory];
+  m->ptr = &memory[MMEM_SIZE - avail_memory + holes];
 
   /* Remember the size of this memory block. */
   m->size = size;
 
   /* Decrease the amount of available memory. */
   avail_memory -= size;
+  used_memory += size;
 
   /* Return non-zero to indicate that we were able to allocate
      memory. */
@@ -118,6 +340,10 @@ mmem_alloc(struct mmem *m, unsigned int size)
 void
 mmem_free(struct mmem *m)
 {
+#if MMEM_DEFERRED_COMPACTION
+  /* Leave a hole, to be closed by mmem_compact(). */
+  holes += m->size;
+#else /* MMEM_DEFERRED_COMPACTION */
   struct mmem *n;
 
   if(m->next != NULL) {
@@ -132,13 +358,37 @@ mmem_free(struct mmem *m)
       n->ptr = (void *)((char *)n->ptr - m->size);
     }
   }
+#endif /* MMEM_DEFERRED_COMPACTION */
 
   avail_memory += m->size;
+  used_memory -= m->size;
 
   /* Remove the memory block from the list. */
   list_remove(mmemlist, m);
 }
 /*---------------------------------------------------------------------------*/
+/**
+ * \brief      Get usage and fragmentation statistics
+ * \param stats A pointer to the structure to fill in
+ *
+ *             This function reports how much of the managed memory
+ *             is in use, how much is lost to block headers and
+ *             rounding, and how much is held by freed blocks that
+ *             are waiting to be reused or compacted.
+ *
+ */
+void
+mmem_stats(struct mmem_stats *stats)
+{
+  stats->size = MMEM_SIZE;
+  stats->used = used_memory;
+  stats->overhead = 0;
+  stats->free = holes;
+  stats->top = avail_memory - holes;
+  stats->compactions = compactions;
+  stats->failures = failures;
+}
+/*---------------------------------------------------------------------------*/
 /**
  * \brief      Initialize the managed memory module
  * \author     Adam Dunkels
@@ -159,6 +409,7 @@ mmem_init(void)
   avail_memory = MMEM_SIZE;
   inited = 1;
 }
+#endif /* MMEM_WITH_SIZE_CLASSES */
 /*---------------------------------------------------------------------------*/
 
 /** @} */
@@ -44,6 +44,15 @@
  * stays in place. Therefore, a level of indirection is used: access
  * to allocated memory must always be done using a special macro.
  *
+ * Compacting on every free costs a move of all memory allocated
+ * after the freed block. With MMEM_CONF_DEFERRED_COMPACTION, freed
+ * blocks are left as holes that are compacted in one pass when an
+ * allocation does not fit, or when mmem_compact() is called. With
+ * MMEM_CONF_WITH_SIZE_CLASSES, blocks are instead rounded up to a
+ * size class and freed blocks are kept on one free list per class for
+ * reuse, so that allocating and freeing take constant time; memory
+ * is only compacted when an allocation does not fit otherwise.
+ *
  * \note This module has not been heavily tested.
  * @{
  */
@@ -59,6 +68,29 @@
 #ifndef MMEM_H_
 #define MMEM_H_
 
+#include "contiki-conf.h"
+
+/**
+ * Keep freed blocks on per size class free lists instead of
+ * compacting the memory when they are freed.
+ */
+#ifdef MMEM_CONF_WITH_SIZE_CLASSES
+#define MMEM_WITH_SIZE_CLASSES MMEM_CONF_WITH_SIZE_CLASSES
+#else /* MMEM_CONF_WITH_SIZE_CLASSES */
+#define MMEM_WITH_SIZE_CLASSES 0
+#endif /* MMEM_CONF_WITH_SIZE_CLASSES */
+
+/**
+ * Leave freed blocks in place and compact them all at once, when an
+ * allocation does not fit or mmem_compact() is called. Always the
+ * case with size classes.
+ */
+#ifdef MMEM_CONF_DEFERRED_COMPACTION
+#define MMEM_DEFERRED_COMPACTION MMEM_CONF_DEFERRED_COMPACTION
+#else /* MMEM_CONF_DEFERRED_COMPACTION */
+#define MMEM_DEFERRED_COMPACTION 0
+#endif /* MMEM_CONF_DEFERRED_COMPACTION */
+
 /*---------------------------------------------------------------------------*/
 /**
  * \brief      Get a pointer to the managed memory
@@ -80,12 +112,28 @@ struct mmem {
   void *ptr;
 };
 
+/**
+ * Usage and fragmentation of the managed memory, as filled in by
+ * mmem_stats(). All sizes are in bytes.
+ */
+struct mmem_stats {
+  unsigned int size;        /* size of the managed memory */
+  unsigned int used;        /* requested by allocated blocks */
+  unsigned int overhead;    /* headers and size class rounding */
+  unsigned int free;        /* freed blocks not yet reused or compacted */
+  unsigned int top;         /* contiguous free memory after all blocks */
+  unsigned int compactions; /* compaction passes */
+  unsigned int failures;    /* allocations that did not fit */
+};
+
 /* XXX: tagga minne med "interrupt usage", vilke gr att man r
    speciellt varsam under free(). */
 
 int  mmem_alloc(struct mmem *m, unsigned int size);
 void mmem_free(struct mmem *);
 void mmem_init(void);
+void mmem_compact(void);
+void mmem_stats(struct mmem_stats *stats);
 
 #endif /* MMEM_H_ */
 
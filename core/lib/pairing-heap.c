@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Pairing heap library
+ */
+
+/**
+ * \addtogroup pairing-heap
+ * @{
+ */
+
+#include "lib/pairing-heap.h"
+
+/*---------------------------------------------------------------------------*/
+static struct pairing_heap_node *
+meld(struct pairing_heap *heap,
+     struct pairing_heap_node *a, struct pairing_heap_node *b)
+{
+  struct pairing_heap_node *t;
+
+  if(a == NULL) {
+    return b;
+  }
+  if(b == NULL) {
+    return a;
+  }
+  if(heap->before(b, a)) {
+    t = a;
+    a = b;
+    b = t;
+  }
+  /* b becomes the first child of a. */
+  b->prev = a;
+  b->next = a->child;
+  if(a->child != NULL) {
+    a->child->prev = b;
+  }
+  a->child = b;
+  return a;
+}
+/*---------------------------------------------------------------------------*/
+static struct pairing_heap_node *
+merge_pairs(struct pairing_heap *heap, struct pairing_heap_node *first)
+{
+  struct pairing_heap_node *a, *b, *pairs, *result;
+
+  /* Meld the siblings pairwise from left to right, stacking up the
+     results through their next pointers. */
+  pairs = NULL;
+  while(first != NULL) {
+    a = first;
+    b = a->next;
+    first = b != NULL ? b->next : NULL;
+    a->next = a->prev = NULL;
+    if(b != NULL) {
+      b->next = b->prev = NULL;
+    }
+    a = meld(heap, a, b);
+    a->next = pairs;
+    pairs = a;
+  }
+
+  /* Meld the pairs from right to left into a single heap. */
+  result = NULL;
+  while(pairs != NULL) {
+    a = pairs;
+    pairs = a->next;
+    a->next = NULL;
+    result = meld(heap, result, a);
+  }
+  return result;
+}
+/*---------------------------------------------------------------------------*/
+void
+pairing_heap_init(struct pairing_heap *heap, pairing_heap_before_t before)
+{
+  heap->root = NULL;
+  heap->before = before;
+}
+/*---------------------------------------------------------------------------*/
+void
+pairing_heap_insert(struct pairing_heap *heap, struct pairing_heap_node *node)
+{
+  node->child = node->next = node->prev = NULL;
+  node->heap = heap;
+  heap->root = meld(heap, heap->root, node);
+}
+/*---------------------------------------------------------------------------*/
+void
+pairing_heap_remove(struct pairing_heap *heap, struct pairing_heap_node *node)
+{
+  struct pairing_heap_node *sub;
+
+  sub = merge_pairs(heap, node->child);
+  if(node == heap->root) {
+    heap->root = sub;
+  } else {
+    /* Unlink the node from the child list of its parent. */
+    if(node->prev->child == node) {
+      node->prev->child = node->next;
+    } else {
+      node->prev->next = node->next;
+    }
+    if(node->next != NULL) {
+      node->next->prev = node->prev;
+    }
+    heap->root = meld(heap, heap->root, sub);
+  }
+  node->child = node->next = node->prev = NULL;
+  node->heap = NULL;
+}
+/*---------------------------------------------------------------------------*/
+struct pairing_heap_node *
+pairing_heap_pop(struct pairing_heap *heap)
+{
+  struct pairing_heap_node *node;
+
+  node = heap->root;
+  if(node != NULL) {
+    pairing_heap_remove(heap, node);
+  }
+  return node;
+}
+/*---------------------------------------------------------------------------*/
+int
+pairing_heap_contains(struct pairing_heap *heap,
+                      struct pairing_heap_node *node)
+{
+  return node->heap == heap;
+}
+/*---------------------------------------------------------------------------*/
+void
+pairing_heap_remove_if(struct pairing_heap *heap,
+                       int (*match)(struct pairing_heap_node *, void *),
+                       void *arg)
+{
+  struct pairing_heap_node *n, *c, *next, *pending;
+
+  /* Take the heap apart and meld back the nodes that do not match. */
+  pending = heap->root;
+  heap->root = NULL;
+  while(pending != NULL) {
+    n = pending;
+    pending = n->next;
+    for(c = n->child; c != NULL; c = next) {
+      next = c->next;
+      c->next = pending;
+      pending = c;
+    }
+    n->child = n->next = n->prev = NULL;
+    if(!match(n, arg)) {
+      heap->root = meld(heap, heap->root, n);
+    } else {
+      n->heap = NULL;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+/** @} */
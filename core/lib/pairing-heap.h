@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Header file for the pairing heap library
+ */
+
+/** \addtogroup lib
+    @{ */
+/**
+ * \defgroup pairing-heap Pairing heap library
+ *
+ * The pairing heap library keeps elements ordered by a user-supplied
+ * comparison function. Insertion and lookup of the first element
+ * take constant time, and removal of any element takes O(log n)
+ * amortized time.
+ *
+ * The heap is intrusive: elements embed a struct pairing_heap_node
+ * and no memory is allocated by the library. The element that
+ * contains a node is obtained with pairing_heap_entry().
+ *
+ * @{
+ */
+
+#ifndef PAIRING_HEAP_H_
+#define PAIRING_HEAP_H_
+
+#include <stddef.h>
+
+struct pairing_heap_node {
+  struct pairing_heap_node *child;
+  struct pairing_heap_node *next;
+  /* The parent for a first child, otherwise the previous sibling.
+     NULL for the root and for nodes that are not in a heap. */
+  struct pairing_heap_node *prev;
+  /* The heap that holds the node, NULL if none */
+  struct pairing_heap *heap;
+};
+
+/**
+ * Comparison function: returns non-zero if a is to be ordered
+ * before b.
+ */
+typedef int (*pairing_heap_before_t)(const struct pairing_heap_node *a,
+                                     const struct pairing_heap_node *b);
+
+struct pairing_heap {
+  struct pairing_heap_node *root;
+  pairing_heap_before_t before;
+};
+
+/**
+ * Get the element that contains a heap node.
+ *
+ * \param node   A pointer to the heap node.
+ * \param type   The type of the element.
+ * \param member The name of the heap node member in the element.
+ */
+#define pairing_heap_entry(node, type, member) \
+  ((type *)((char *)(node) - offsetof(type, member)))
+
+/**
+ * Get the first node of a heap, or NULL if the heap is empty.
+ */
+#define pairing_heap_head(heap) ((heap)->root)
+
+void pairing_heap_init(struct pairing_heap *heap,
+                       pairing_heap_before_t before);
+void pairing_heap_insert(struct pairing_heap *heap,
+                         struct pairing_heap_node *node);
+void pairing_heap_remove(struct pairing_heap *heap,
+                         struct pairing_heap_node *node);
+struct pairing_heap_node *pairing_heap_pop(struct pairing_heap *heap);
+
+/**
+ * Check if a node is in a heap. This is recorded in the node when it
+ * is inserted and removed, so the links of a node that is not in the
+ * heap are never followed, whatever they hold.
+ */
+int pairing_heap_contains(struct pairing_heap *heap,
+                          struct pairing_heap_node *node);
+
+/**
+ * Remove all nodes for which match() returns non-zero. Takes O(n)
+ * time.
+ */
+void pairing_heap_remove_if(struct pairing_heap *heap,
+                            int (*match)(struct pairing_heap_node *,
+                                         void *),
+                            void *arg);
+
+#endif /* PAIRING_HEAP_H_ */
+
+/** @} */
+/** @} */
@@ -406,7 +406,7 @@ eventhandler(process_event_t ev, process_data_t data)
       for(cptr = &uip_udp_conns[0];
           cptr < &uip_udp_conns[UIP_UDP_CONNS]; ++cptr) {
         if(cptr->appstate.p == p) {
-          cptr->lport = 0;
+          uip_udp_remove(cptr);
         }
       }
     }
@@ -813,6 +813,10 @@ PROCESS_THREAD(tcpip_process, ev, data)
 {
   PROCESS_BEGIN();
 
+  /* Let the stack go ahead of application processes when the kernel
+     has priority levels. */
+  process_set_priority(PROCESS_CURRENT(), PROCESS_PRIORITY_HIGH);
+
 #if UIP_TCP
   {
     unsigned char i;
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Internet checksum engine.
+ *
+ *         The data is summed in native byte order a word at a time into
+ *         an accumulator wide enough that no carry is lost, and the
+ *         carries are folded back in once at the end (RFC 1071, section
+ *         2). The result is byte swapped to host order when needed.
+ */
+
+#include "net/ip/uip.h"
+#include "net/ip/uip-chksum.h"
+
+#include <limits.h>
+
+/*
+ * Sum 32-bit words into a 64-bit accumulator. The default is to do so
+ * on hosts with a 64-bit long; elsewhere 16-bit words are summed into
+ * a 32-bit accumulator, which cannot overflow for any uIP packet.
+ */
+#ifdef UIP_CONF_CHKSUM_WIDE
+#define UIP_CHKSUM_WIDE UIP_CONF_CHKSUM_WIDE
+#else /* UIP_CONF_CHKSUM_WIDE */
+#define UIP_CHKSUM_WIDE (ULONG_MAX > 0xffffffffUL)
+#endif /* UIP_CONF_CHKSUM_WIDE */
+
+/* Use SSE2 or AVX2 when the compiler targets them. */
+#ifdef UIP_CONF_CHKSUM_SIMD
+#define UIP_CHKSUM_SIMD UIP_CONF_CHKSUM_SIMD
+#else /* UIP_CONF_CHKSUM_SIMD */
+#define UIP_CHKSUM_SIMD 1
+#endif /* UIP_CONF_CHKSUM_SIMD */
+
+#if UIP_CHKSUM_WIDE
+typedef uint64_t chksum_acc_t;
+typedef uint32_t chksum_word_t;
+#else /* UIP_CHKSUM_WIDE */
+typedef uint32_t chksum_acc_t;
+typedef uint16_t chksum_word_t;
+#endif /* UIP_CHKSUM_WIDE */
+
+#if UIP_CHKSUM_SIMD && defined(__AVX2__)
+#include <immintrin.h>
+#define SIMD_BLOCK 64
+#elif UIP_CHKSUM_SIMD && defined(__SSE2__)
+#include <emmintrin.h>
+#define SIMD_BLOCK 32
+#endif
+
+/*
+ * A native load of the big endian word (a, b) yields (b, a) on a
+ * little endian host, so the folded sum must be swapped. Starting at
+ * an odd address shifts every later byte into the other half of its
+ * word, which flips the need for the swap; the leading byte is then
+ * added in the half it would have had.
+ */
+#if UIP_BYTE_ORDER == UIP_LITTLE_ENDIAN
+#define NATIVE_SWAP      1
+#define LEAD_BYTE(b)     ((chksum_acc_t)(b) << 8)
+#define TAIL_BYTE(b)     ((chksum_acc_t)(b))
+#else /* UIP_BYTE_ORDER == UIP_LITTLE_ENDIAN */
+#define NATIVE_SWAP      0
+#define LEAD_BYTE(b)     ((chksum_acc_t)(b))
+#define TAIL_BYTE(b)     ((chksum_acc_t)(b) << 8)
+#endif /* UIP_BYTE_ORDER == UIP_LITTLE_ENDIAN */
+
+/*---------------------------------------------------------------------------*/
+static uint16_t
+fold(chksum_acc_t acc)
+{
+#if UIP_CHKSUM_WIDE
+  acc = (acc & 0xffffffffUL) + (acc >> 32);
+  acc = (acc & 0xffffffffUL) + (acc >> 32);
+#endif /* UIP_CHKSUM_WIDE */
+  acc = (acc & 0xffff) + (acc >> 16);
+  acc = (acc & 0xffff) + (acc >> 16);
+  return (uint16_t)acc;
+}
+/*---------------------------------------------------------------------------*/
+#ifdef SIMD_BLOCK
+/*
+ * Sum blocks of two vectors. The low and high 16-bit words of each
+ * 32-bit lane go to separate accumulators, which gain at most
+ * 2 * 0xffff per block, so a 64 kB buffer cannot overflow them.
+ */
+static chksum_acc_t
+sum_simd(const uint8_t *data, uint16_t blocks)
+{
+  uint32_t lanes[SIMD_BLOCK / 8];
+  chksum_acc_t acc;
+  int i;
+#if SIMD_BLOCK == 64
+  const __m256i mask = _mm256_set1_epi32(0xffff);
+  __m256i lo = _mm256_setzero_si256();
+  __m256i hi = _mm256_setzero_si256();
+  __m256i v0, v1;
+
+  while(blocks-- > 0) {
+    v0 = _mm256_loadu_si256((const __m256i *)data);
+    v1 = _mm256_loadu_si256((const __m256i *)(data + 32));
+    lo = _mm256_add_epi32(lo, _mm256_add_epi32(_mm256_and_si256(v0, mask),
+                                               _mm256_and_si256(v1, mask)));
+    hi = _mm256_add_epi32(hi, _mm256_add_epi32(_mm256_srli_epi32(v0, 16),
+                                               _mm256_srli_epi32(v1, 16)));
+    data += SIMD_BLOCK;
+  }
+  _mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi32(lo, hi));
+#else /* SIMD_BLOCK == 64 */
+  const __m128i mask = _mm_set1_epi32(0xffff);
+  __m128i lo = _mm_setzero_si128();
+  __m128i hi = _mm_setzero_si128();
+  __m128i v0, v1;
+
+  while(blocks-- > 0) {
+    v0 = _mm_loadu_si128((const __m128i *)data);
+    v1 = _mm_loadu_si128((const __m128i *)(data + 16));
+    lo = _mm_add_epi32(lo, _mm_add_epi32(_mm_and_si128(v0, mask),
+                                         _mm_and_si128(v1, mask)));
+    hi = _mm_add_epi32(hi, _mm_add_epi32(_mm_srli_epi32(v0, 16),
+                                         _mm_srli_epi32(v1, 16)));
+    data += SIMD_BLOCK;
+  }
+  _mm_storeu_si128((__m128i *)lanes, _mm_add_epi32(lo, hi));
+#endif /* SIMD_BLOCK == 64 */
+
+  acc = 0;
+  for(i = 0; i < SIMD_BLOCK / 8; i++) {
+    acc += lanes[i];
+  }
+  return acc;
+}
+#endif /* SIMD_BLOCK */
+/*---------------------------------------------------------------------------*/
+uint16_t
+uip_chksum_add(uint16_t sum, const uint8_t *data, uint16_t len)
+{
+  const chksum_word_t *w;
+  chksum_acc_t acc;
+  uint16_t result;
+  uint8_t swap;
+
+  acc = 0;
+  swap = NATIVE_SWAP;
+
+  if(len > 0 && ((uintptr_t)data & 1)) {
+    acc = LEAD_BYTE(*data);
+    data++;
+    len--;
+    swap = !swap;
+  }
+
+#ifdef SIMD_BLOCK
+  if(len >= SIMD_BLOCK) {
+    acc += sum_simd(data, len / SIMD_BLOCK);
+    data += len - len % SIMD_BLOCK;
+    len %= SIMD_BLOCK;
+  }
+#endif /* SIMD_BLOCK */
+
+#if UIP_CHKSUM_WIDE
+  if(len >= 2 && ((uintptr_t)data & 2)) {
+    acc += *(const uint16_t *)data;
+    data += 2;
+    len -= 2;
+  }
+#endif /* UIP_CHKSUM_WIDE */
+
+  w = (const chksum_word_t *)data;
+  while(len >= 4 * sizeof(chksum_word_t)) {
+    acc += w[0];
+    acc += w[1];
+    acc += w[2];
+    acc += w[3];
+    w += 4;
+    len -= 4 * sizeof(chksum_word_t);
+  }
+  while(len >= sizeof(chksum_word_t)) {
+    acc += *w++;
+    len -= sizeof(chksum_word_t);
+  }
+  data = (const uint8_t *)w;
+
+#if UIP_CHKSUM_WIDE
+  if(len >= 2) {
+    acc += *(const uint16_t *)data;
+    data += 2;
+    len -= 2;
+  }
+#endif /* UIP_CHKSUM_WIDE */
+
+  if(len == 1) {
+    acc += TAIL_BYTE(*data);
+  }
+
+  result = fold(acc);
+  if(swap) {
+    result = (uint16_t)((result << 8) | (result >> 8));
+  }
+
+  result += sum;
+  if(result < sum) {
+    result++;      /* carry */
+  }
+  return result;
+}
+/*---------------------------------------------------------------------------*/
+uint16_t
+uip_chksum_update16(uint16_t chksum, uint16_t old_word, uint16_t new_word)
+{
+  uint32_t acc;
+
+  acc = (uint32_t)(uint16_t)~chksum + (uint16_t)~old_word + new_word;
+  acc = (acc & 0xffff) + (acc >> 16);
+  acc = (acc & 0xffff) + (acc >> 16);
+  return (uint16_t)~acc;
+}
+/*---------------------------------------------------------------------------*/
+uint16_t
+uip_chksum_update(uint16_t chksum, const uint8_t *old_data,
+                  const uint8_t *new_data, uint16_t len)
+{
+  return uip_chksum_update16(chksum, uip_chksum_add(0, old_data, len),
+                             uip_chksum_add(0, new_data, len));
+}
+/*---------------------------------------------------------------------------*/
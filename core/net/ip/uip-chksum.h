@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Header file for the Internet checksum engine: word-at-a-time
+ *         summing (RFC 1071) and incremental update (RFC 1624).
+ */
+
+#ifndef UIP_CHKSUM_H_
+#define UIP_CHKSUM_H_
+
+#include "contiki-conf.h"
+#include <stdint.h>
+
+/**
+ * \brief      Add data to a 16-bit one's complement sum
+ * \param sum  The sum so far, in host byte order
+ * \param data The data to add, interpreted as big endian 16-bit words
+ * \param len  The length of the data in bytes
+ * \return     The new sum, in host byte order, not complemented
+ *
+ *             This computes the same value as the byte-pair loop in
+ *             uip6.c, but the data may start at any address and an
+ *             odd trailing byte is padded with zero.
+ */
+uint16_t uip_chksum_add(uint16_t sum, const uint8_t *data, uint16_t len);
+
+/**
+ * \brief          Update a checksum after a 16-bit field has changed
+ * \param chksum   The checksum field before the change
+ * \param old_word The 16-bit word before the change
+ * \param new_word The 16-bit word after the change
+ * \return         The checksum field after the change
+ *
+ *             Implements equation 3 of RFC 1624, HC' = ~(~HC + ~m + m'),
+ *             which never produces 0x0000 from a nonzero sum. One's
+ *             complement arithmetic does not depend on byte order, so
+ *             the three arguments may be in either byte order as long
+ *             as they agree; the result is in that same order.
+ */
+uint16_t uip_chksum_update16(uint16_t chksum, uint16_t old_word,
+                             uint16_t new_word);
+
+/**
+ * \brief          Update a checksum after a region has been rewritten
+ * \param chksum   The checksum field before the change, in host byte order
+ * \param old_data The region before the change
+ * \param new_data The region after the change
+ * \param len      The length of the region in bytes
+ * \return         The checksum field after the change, in host byte order
+ *
+ *             The region must start at the same 16-bit word offset in
+ *             the packet as the checksummed data does, e.g. an address
+ *             in an IPv6 header rewritten by a translator.
+ */
+uint16_t uip_chksum_update(uint16_t chksum, const uint8_t *old_data,
+                           const uint8_t *new_data, uint16_t len);
+
+#endif /* UIP_CHKSUM_H_ */
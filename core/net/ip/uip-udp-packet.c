@@ -54,7 +54,10 @@ uip_udp_packet_send(struct uip_udp_conn *c, const void *data, int len)
   if(data != NULL && len <= (UIP_BUFSIZE - (UIP_LLH_LEN + UIP_IPUDPH_LEN))) {
     uip_udp_conn = c;
     uip_slen = len;
-    memmove(&uip_buf[UIP_LLH_LEN + UIP_IPUDPH_LEN], data, len);
+    if(data != &uip_buf[UIP_LLH_LEN + UIP_IPUDPH_LEN]) {
+      /* Not already written in place, e.g., at uip_appdata. */
+      memmove(&uip_buf[UIP_LLH_LEN + UIP_IPUDPH_LEN], data, len);
+    }
     uip_process(UIP_UDP_SEND_CONN);
 
 #if UIP_IPV6_MULTICAST
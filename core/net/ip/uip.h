@@ -725,7 +725,8 @@ CCIF void uip_send(const void *data, int len);
  *
  * Will reduce to non-zero if the previously sent data has been
  * acknowledged by the remote host. This means that the application
- * can send new data.
+ * can send new data. With UIP_CONF_TCP_WINDOW_SEGMENTS above one, the
+ * data has been copied to the retransmission buffer instead.
  *
  * \hideinitializer
  */
@@ -779,7 +780,9 @@ CCIF void uip_send(const void *data, int len);
  * Reduces to non-zero if the previously sent data has been lost in
  * the network, and the application should retransmit it. The
  * application should send the exact same data as it did the last
- * time, using the uip_send() function.
+ * time, using the uip_send() function. Never set with
+ * UIP_CONF_TCP_WINDOW_SEGMENTS above one, where uIP retransmits by
+ * itself.
  *
  * \hideinitializer
  */
@@ -856,7 +859,11 @@ struct uip_udp_conn *uip_udp_new(const uip_ipaddr_t *ripaddr, uint16_t rport);
  *
  * \hideinitializer
  */
+#if UIP_DEMUX_HASH
+#define uip_udp_remove(conn) uip_udp_bind(conn, 0)
+#else /* UIP_DEMUX_HASH */
 #define uip_udp_remove(conn) (conn)->lport = 0
+#endif /* UIP_DEMUX_HASH */
 
 /**
  * Bind a UDP connection to a local port.
@@ -868,7 +875,11 @@ struct uip_udp_conn *uip_udp_new(const uip_ipaddr_t *ripaddr, uint16_t rport);
  *
  * \hideinitializer
  */
+#if UIP_DEMUX_HASH
+void uip_udp_bind(struct uip_udp_conn *conn, uint16_t port);
+#else /* UIP_DEMUX_HASH */
 #define uip_udp_bind(conn, port) (conn)->lport = port
+#endif /* UIP_DEMUX_HASH */
 
 /**
  * Send a UDP datagram of length len on the current connection.
@@ -316,6 +316,29 @@ void uip_log(char *msg);
 /** Minimum number of default routers */
 #define UIP_CONF_DS6_DEFRT_NBU       2
 #endif
+
+/**
+ * Demultiplex incoming UDP and TCP packets through hash tables instead
+ * of scanning all connections (default: no).
+ *
+ * UDP connections are hashed by local port, TCP connections by local
+ * port and remote address and port, and listening TCP ports by port.
+ * Worth it when UIP_CONF_UDP_CONNS or UIP_CONF_MAX_CONNECTIONS is
+ * large. The local port of a UDP connection must then only be changed
+ * with uip_udp_bind() and uip_udp_remove().
+ */
+#if defined(UIP_CONF_DEMUX_HASH) && NETSTACK_CONF_WITH_IPV6
+#define UIP_DEMUX_HASH                UIP_CONF_DEMUX_HASH
+#else
+#define UIP_DEMUX_HASH                0
+#endif
+
+#ifdef UIP_CONF_DEMUX_BUCKETS
+/** Number of hash buckets of each demultiplexing table */
+#define UIP_DEMUX_BUCKETS             UIP_CONF_DEMUX_BUCKETS
+#else
+#define UIP_DEMUX_BUCKETS             32
+#endif
 /** @} */
 
 /*------------------------------------------------------------------------------*/
@@ -500,6 +523,27 @@ void uip_log(char *msg);
 #define UIP_RECEIVE_WINDOW (UIP_CONF_RECEIVE_WINDOW)
 #endif
 
+/**
+ * The number of full-sized segments a TCP connection may have in
+ * flight (default: 1).
+ *
+ * With one segment, uIP keeps no copy of sent data and asks the
+ * application to regenerate it with UIP_REXMIT. With more, each
+ * connection gets a retransmission buffer of this many UIP_TCP_MSS
+ * sized segments that uIP sends from, resends from on timeout or
+ * three duplicate ACKs, and releases as cumulative ACKs arrive. The
+ * application then never sees UIP_REXMIT, and uip_acked() means that
+ * the data of the last uip_send() has been buffered. Only implemented
+ * for IPv6.
+ *
+ * \hideinitializer
+ */
+#if defined(UIP_CONF_TCP_WINDOW_SEGMENTS) && NETSTACK_CONF_WITH_IPV6
+#define UIP_TCP_WINDOW_SEGMENTS (UIP_CONF_TCP_WINDOW_SEGMENTS)
+#else
+#define UIP_TCP_WINDOW_SEGMENTS 1
+#endif
+
 /**
  * How long a connection should stay in the TIME_WAIT state.
  *
@@ -619,6 +663,24 @@ void uip_log(char *msg);
 #define UIP_BYTE_ORDER     (UIP_LITTLE_ENDIAN)
 #endif /* UIP_CONF_BYTE_ORDER */
 
+/**
+ * Use the word-at-a-time checksum engine in uip-chksum.c.
+ *
+ * When set, the generic checksum routines of uIP (those used when
+ * UIP_ARCH_CHKSUM is not set) sum the data a 16- or 32-bit word at a
+ * time into a wide accumulator and fold the carries once at the end,
+ * instead of adding one byte pair at a time with a carry check. On
+ * x86 the engine also has an SSE2/AVX2 path. It costs a few hundred
+ * bytes of code, so it is off by default.
+ *
+ * \hideinitializer
+ */
+#ifdef UIP_CONF_CHKSUM_FAST
+#define UIP_CHKSUM_FAST    (UIP_CONF_CHKSUM_FAST)
+#else /* UIP_CONF_CHKSUM_FAST */
+#define UIP_CHKSUM_FAST    0
+#endif /* UIP_CONF_CHKSUM_FAST */
+
 /** @} */
 /*------------------------------------------------------------------------------*/
 
@@ -61,6 +61,7 @@
 #include "ip64-slip-interface.h"
 #include "ip64-dns64.h"
 #include "net/ipv6/uip-ds6.h"
+#include "net/ip/uip-chksum.h"
 #include "ip64-ipv4-dhcp.h"
 #include "contiki-net.h"
 
@@ -271,6 +272,9 @@ ip64_set_ipv6_address(const uip_ip6addr_t *addr)
 static uint16_t
 chksum(uint16_t sum, const uint8_t *data, uint16_t len)
 {
+#if UIP_CHKSUM_FAST
+  return uip_chksum_add(sum, data, len);
+#else /* UIP_CHKSUM_FAST */
   uint16_t t;
   const uint8_t *dataptr;
   const uint8_t *last_byte;
@@ -297,6 +301,7 @@ chksum(uint16_t sum, const uint8_t *data, uint16_t len)
 
   /* Return sum in host byte order. */
   return sum;
+#endif /* UIP_CHKSUM_FAST */
 }
 /*---------------------------------------------------------------------------*/
 static uint16_t
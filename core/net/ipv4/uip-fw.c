@@ -58,6 +58,7 @@
 
 #include "net/ip/uip.h"
 #include "net/ip/uip_arch.h"
+#include "net/ip/uip-chksum.h"
 #include "net/ipv4/uip-fw.h"
 #ifdef AODV_COMPLIANCE
 #include "net/ipv4/uaodv-def.h"
@@ -461,15 +462,13 @@ uip_fw_forward(void)
     time_exceeded();
   }
   
+  /* Update the IP checksum (RFC 1624) for the TTL decrement below. */
+  BUF->ipchksum = uip_chksum_update16(BUF->ipchksum,
+                                      UIP_HTONS(BUF->ttl << 8),
+                                      UIP_HTONS((BUF->ttl - 1) << 8));
+
   /* Decrement the TTL (time-to-live) value in the IP header */
   BUF->ttl = BUF->ttl - 1;
-  
-  /* Update the IP checksum. */
-  if(BUF->ipchksum >= UIP_HTONS(0xffff - 0x0100)) {
-    BUF->ipchksum = BUF->ipchksum + UIP_HTONS(0x0100) + 1;
-  } else {
-    BUF->ipchksum = BUF->ipchksum + UIP_HTONS(0x0100);
-  }
 
   if(uip_len > 0) {
     uip_appdata = &uip_buf[UIP_LLH_LEN + UIP_TCPIP_HLEN];
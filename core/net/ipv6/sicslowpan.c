@@ -69,6 +69,10 @@
 #include "net/rime/rime.h"
 #include "net/ipv6/sicslowpan.h"
 #include "net/netstack.h"
+#if UIP_CONF_IPV6_RPL
+#include "net/rpl/rpl.h"
+#include "net/rpl/rpl-dag-root.h"
+#endif /* UIP_CONF_IPV6_RPL */
 
 #include <stdio.h>
 
@@ -251,6 +255,36 @@ static uint16_t my_tag;
 /* Assuming that the worst growth for uncompression is 38 bytes */
 #define SICSLOWPAN_FIRST_FRAGMENT_SIZE (SICSLOWPAN_FRAGMENT_SIZE + 38)
 
+/* With fragment forwarding, fragments of packets routed through this node
+ * are sent on as they arrive instead of being reassembled first. */
+#ifdef SICSLOWPAN_CONF_FRAG_FORWARDING
+#define SICSLOWPAN_FRAG_FORWARDING SICSLOWPAN_CONF_FRAG_FORWARDING
+#else
+#define SICSLOWPAN_FRAG_FORWARDING 0
+#endif
+
+/* The number of packets whose fragments can be forwarded at the same time */
+#ifdef SICSLOWPAN_CONF_FRAG_FORWARD_ENTRIES
+#define SICSLOWPAN_FRAG_FORWARD_ENTRIES SICSLOWPAN_CONF_FRAG_FORWARD_ENTRIES
+#else
+#define SICSLOWPAN_FRAG_FORWARD_ENTRIES 4
+#endif
+
+#if SICSLOWPAN_FRAG_FORWARDING && !UIP_CONF_ROUTER
+#error SICSLOWPAN_CONF_FRAG_FORWARDING requires UIP_CONF_ROUTER
+#endif
+
+/* Reassembly progress is tracked in units of 8 bytes, the unit of the
+   fragment offset */
+#define SICSLOWPAN_FRAG_UNITS ((UIP_BUFSIZE - UIP_LLH_LEN + 7) / 8)
+
+/* Marks the end of a fragment buffer chain */
+#define FRAG_BUF_NONE 0xff
+
+#if SICSLOWPAN_FRAGMENT_BUFFERS >= FRAG_BUF_NONE
+#error SICSLOWPAN_CONF_FRAGMENT_BUFFERS must be less than 255
+#endif
+
 /* all information needed for reassembly */
 struct sicslowpan_frag_info {
   /** When reassembling, the source address of the fragments being merged */
@@ -261,8 +295,13 @@ struct sicslowpan_frag_info {
   uint16_t tag;
   /** Total length of the fragmented packet */
   uint16_t len;
-  /** Current length of reassembled fragments */
-  uint16_t reassembled_len;
+  /** Number of 8-byte units of the packet received so far */
+  uint16_t received_units;
+  /** Units of the packet received so far, to detect completion and
+      duplicate fragments */
+  uint8_t received[(SICSLOWPAN_FRAG_UNITS + 7) / 8];
+  /** First buffer of the chain holding the fragments after the first */
+  uint8_t bufs;
   /** Reassembly %process %timer. */
   struct timer reass_timer;
 
@@ -276,31 +315,56 @@ struct sicslowpan_frag_info {
 static struct sicslowpan_frag_info frag_info[SICSLOWPAN_REASS_CONTEXTS];
 
 struct sicslowpan_frag_buf {
-  /* the index of the frag_info */
-  uint8_t index;
+  /* the next buffer of the same context, or of the free pool */
+  uint8_t next;
   /* Fragment offset */
   uint8_t offset;
-  /* Length of this fragment (if zero this buffer is not allocated) */
+  /* Length of this fragment */
   uint8_t len;
   uint8_t data[SICSLOWPAN_FRAGMENT_SIZE];
 };
 
 static struct sicslowpan_frag_buf frag_buf[SICSLOWPAN_FRAGMENT_BUFFERS];
 
+/* First buffer of the pool of free fragment buffers */
+static uint8_t free_bufs;
+
+#if UIP_STATISTICS == 1
+struct sicslowpan_reass_stats sicslowpan_reass_stats;
+#endif /* UIP_STATISTICS == 1 */
+
+/*---------------------------------------------------------------------------*/
+static void
+init_fragments(void)
+{
+  int i;
+
+  for(i = 0; i < SICSLOWPAN_REASS_CONTEXTS; i++) {
+    frag_info[i].len = 0;
+    frag_info[i].bufs = FRAG_BUF_NONE;
+  }
+  for(i = 0; i < SICSLOWPAN_FRAGMENT_BUFFERS; i++) {
+    frag_buf[i].next = i + 1 < SICSLOWPAN_FRAGMENT_BUFFERS ? i + 1 : FRAG_BUF_NONE;
+  }
+  free_bufs = SICSLOWPAN_FRAGMENT_BUFFERS > 0 ? 0 : FRAG_BUF_NONE;
+}
 /*---------------------------------------------------------------------------*/
 static int
 clear_fragments(uint8_t frag_info_index)
 {
-  int i, clear_count;
+  int clear_count;
+  uint8_t i, next;
+
   clear_count = 0;
   frag_info[frag_info_index].len = 0;
-  for(i = 0; i < SICSLOWPAN_FRAGMENT_BUFFERS; i++) {
-    if(frag_buf[i].len > 0 && frag_buf[i].index == frag_info_index) {
-      /* deallocate the buffer */
-      frag_buf[i].len = 0;
-      clear_count++;
-    }
+  /* Give the buffers of the context back to the pool */
+  for(i = frag_info[frag_info_index].bufs; i != FRAG_BUF_NONE; i = next) {
+    next = frag_buf[i].next;
+    frag_buf[i].next = free_bufs;
+    free_bufs = i;
+    clear_count++;
   }
+  frag_info[frag_info_index].bufs = FRAG_BUF_NONE;
   return clear_count;
 }
 /*---------------------------------------------------------------------------*/
@@ -313,32 +377,113 @@ timeout_fragments(int not_context)
     if(frag_info[i].len > 0 && i != not_context &&
        timer_expired(&frag_info[i].reass_timer)) {
       /* This context can be freed */
+      UIP_STAT(++sicslowpan_reass_stats.timeouts);
       count += clear_fragments(i);
     }
   }
   return count;
 }
 /*---------------------------------------------------------------------------*/
+/* Mark the units covered by len bytes at offset as received. Returns 0 if
+   the fragment starts in a unit received before. */
+static int
+mark_received(uint8_t index, uint8_t offset, uint16_t len)
+{
+  struct sicslowpan_frag_info *info = &frag_info[index];
+  uint16_t unit, end;
+
+  if(info->received[offset >> 3] & (1 << (offset & 7))) {
+    return 0;
+  }
+  end = offset + (len + 7) / 8;
+  if(end > (info->len + 7) / 8) {
+    /* Extraneous bytes at the end of the last fragment */
+    end = (info->len + 7) / 8;
+  }
+  for(unit = offset; unit < end; unit++) {
+    if(!(info->received[unit >> 3] & (1 << (unit & 7)))) {
+      info->received[unit >> 3] |= 1 << (unit & 7);
+      info->received_units++;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Returns non-zero if all the units of the packet have been received */
+static int
+is_reassembled(uint8_t index)
+{
+  return frag_info[index].received_units >= (frag_info[index].len + 7) / 8;
+}
+/*---------------------------------------------------------------------------*/
 static int
 store_fragment(uint8_t index, uint8_t offset)
+{
+  uint8_t i = free_bufs;
+
+  if(i == FRAG_BUF_NONE) {
+    /* failed */
+    return -1;
+  }
+  free_bufs = frag_buf[i].next;
+
+  /* copy over the data from packetbuf into the fragment buffer and store offset and len */
+  frag_buf[i].offset = offset; /* frag offset */
+  frag_buf[i].len = packetbuf_datalen() - packetbuf_hdr_len;
+  memcpy(frag_buf[i].data, packetbuf_ptr + packetbuf_hdr_len,
+         packetbuf_datalen() - packetbuf_hdr_len);
+  frag_buf[i].next = frag_info[index].bufs;
+  frag_info[index].bufs = i;
+
+  PRINTF("Fragsize: %d\n", frag_buf[i].len);
+  /* return the length of the stored fragment */
+  return frag_buf[i].len;
+}
+/*---------------------------------------------------------------------------*/
+/* Start the reassembly of a packet of frag_size bytes from the sender in
+   packetbuf. Returns the index of the context, or -1. */
+static int8_t
+start_reassembly(uint16_t tag, uint16_t frag_size)
 {
   int i;
-  for(i = 0; i < SICSLOWPAN_FRAGMENT_BUFFERS; i++) {
-    if(frag_buf[i].len == 0) {
-      /* copy over the data from packetbuf into the fragment buffer and store offset and len */
-      frag_buf[i].offset = offset; /* frag offset */
-      frag_buf[i].len = packetbuf_datalen() - packetbuf_hdr_len;
-      frag_buf[i].index = index;
-      memcpy(frag_buf[i].data, packetbuf_ptr + packetbuf_hdr_len,
-             packetbuf_datalen() - packetbuf_hdr_len);
-
-      PRINTF("Fragsize: %d\n", frag_buf[i].len);
-      /* return the length of the stored fragment */
-      return frag_buf[i].len;
+  int8_t found = -1;
+
+  if(frag_size > UIP_BUFSIZE - UIP_LLH_LEN) {
+    PRINTF("*** Fragmented packet too large - tag: %d size: %d\n", tag, frag_size);
+    UIP_STAT(++sicslowpan_reass_stats.drop);
+    return -1;
+  }
+  for(i = 0; i < SICSLOWPAN_REASS_CONTEXTS; i++) {
+    /* clear all fragment info with expired timer to free all fragment buffers */
+    if(frag_info[i].len > 0 && timer_expired(&frag_info[i].reass_timer)) {
+      UIP_STAT(++sicslowpan_reass_stats.timeouts);
+      clear_fragments(i);
+    }
+
+    /* We use len as indication on used or not used */
+    if(found < 0 && frag_info[i].len == 0) {
+      /* We remember the first free fragment info but must continue
+         the loop to free any other expired fragment buffers. */
+      found = i;
     }
   }
-  /* failed */
-  return -1;
+
+  if(found < 0) {
+    PRINTF("*** Failed to store new fragment session - tag: %d\n", tag);
+    UIP_STAT(++sicslowpan_reass_stats.drop);
+    return -1;
+  }
+
+  /* Found a free fragment info to store data in */
+  frag_info[found].len = frag_size;
+  frag_info[found].tag = tag;
+  frag_info[found].first_frag_len = 0;
+  frag_info[found].received_units = 0;
+  memset(frag_info[found].received, 0, sizeof(frag_info[found].received));
+  linkaddr_copy(&frag_info[found].sender,
+                packetbuf_addr(PACKETBUF_ADDR_SENDER));
+  timer_set(&frag_info[found].reass_timer, SICSLOWPAN_REASS_MAXAGE * CLOCK_SECOND / 16);
+  return found;
 }
 /*---------------------------------------------------------------------------*/
 /* add a new fragment to the buffer */
@@ -349,51 +494,73 @@ add_fragment(uint16_t tag, uint16_t frag_size, uint8_t offset)
   int len;
   int8_t found = -1;
 
-  if(offset == 0) {
-    /* This is a first fragment - check if we can add this */
-    for(i = 0; i < SICSLOWPAN_REASS_CONTEXTS; i++) {
-      /* clear all fragment info with expired timer to free all fragment buffers */
-      if(frag_info[i].len > 0 && timer_expired(&frag_info[i].reass_timer)) {
-	clear_fragments(i);
-      }
-
-      /* We use len as indication on used or not used */
-      if(found < 0 && frag_info[i].len == 0) {
-        /* We remember the first free fragment info but must continue
-           the loop to free any other expired fragment buffers. */
+  /* Find the context of the packet. The first fragment starts the
+     reassembly, and with fragment forwarding, so does a following
+     fragment that overtook it on a forwarding router. */
+  for(i = 0; i < SICSLOWPAN_REASS_CONTEXTS; i++) {
+    if(frag_info[i].tag == tag && frag_info[i].len > 0 &&
+       linkaddr_cmp(&frag_info[i].sender, packetbuf_addr(PACKETBUF_ADDR_SENDER))) {
+      /* Tag and Sender match - this must be the correct info to store in */
+      if(timer_expired(&frag_info[i].reass_timer)) {
+        /* A stale context, the sender has reused the tag */
+        UIP_STAT(++sicslowpan_reass_stats.timeouts);
+        clear_fragments(i);
+      } else {
         found = i;
       }
+      break;
     }
+  }
 
-    if(found < 0) {
-      PRINTF("*** Failed to store new fragment session - tag: %d\n", tag);
+  if(found >= 0 && frag_info[found].len != frag_size) {
+    PRINTF("*** Fragment size mismatch - tag: %d size: %d\n", tag, frag_size);
+    UIP_STAT(++sicslowpan_reass_stats.drop);
+    return -1;
+  }
+
+  if(offset == 0) {
+    if(found >= 0 && (frag_info[found].received[0] & 1)) {
+      /* The first fragment has been received already */
+      UIP_STAT(++sicslowpan_reass_stats.duplicates);
       return -1;
     }
-
-    /* Found a free fragment info to store data in */
-    frag_info[found].len = frag_size;
-    frag_info[found].tag = tag;
-    linkaddr_copy(&frag_info[found].sender,
-                  packetbuf_addr(PACKETBUF_ADDR_SENDER));
-    timer_set(&frag_info[found].reass_timer, SICSLOWPAN_REASS_MAXAGE * CLOCK_SECOND / 16);
+    if(found < 0) {
+      found = start_reassembly(tag, frag_size);
+    }
     /* first fragment can not be stored immediately but is moved into
        the buffer while uncompressing */
     return found;
   }
 
-  /* This is a N-fragment - should find the info */
-  for(i = 0; i < SICSLOWPAN_REASS_CONTEXTS; i++) {
-    if(frag_info[i].tag == tag && frag_info[i].len > 0 &&
-       linkaddr_cmp(&frag_info[i].sender, packetbuf_addr(PACKETBUF_ADDR_SENDER))) {
-      /* Tag and Sender match - this must be the correct info to store in */
-      found = i;
-      break;
-    }
+  i = found;
+  if((uint16_t)(offset << 3) >= frag_size ||
+     (uint16_t)(offset << 3) + packetbuf_datalen() - packetbuf_hdr_len >
+     UIP_BUFSIZE - UIP_LLH_LEN ||
+     packetbuf_datalen() - packetbuf_hdr_len > SICSLOWPAN_FRAGMENT_SIZE) {
+    PRINTF("*** Fragment does not fit - tag: %d offset: %d\n", tag, offset);
+    UIP_STAT(++sicslowpan_reass_stats.drop);
+    return -1;
   }
 
-  if(found < 0) {
+  if(i < 0) {
+#if SICSLOWPAN_FRAG_FORWARDING
+    /* A following fragment that arrived before the first one */
+    i = start_reassembly(tag, frag_size);
+    if(i < 0) {
+      return -1;
+    }
+#else /* SICSLOWPAN_FRAG_FORWARDING */
     /* no entry found for storing the new fragment */
     PRINTF("*** Failed to store N-fragment - could not find session - tag: %d offset: %d\n", tag, offset);
+    UIP_STAT(++sicslowpan_reass_stats.drop);
+    return -1;
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+  }
+
+  if(frag_info[i].received[offset >> 3] & (1 << (offset & 7))) {
+    /* A retransmitted fragment, we have it already */
+    PRINTF("*** Duplicate fragment - tag: %d offset: %d\n", tag, offset);
+    UIP_STAT(++sicslowpan_reass_stats.duplicates);
     return -1;
   }
 
@@ -403,12 +570,14 @@ add_fragment(uint16_t tag, uint16_t frag_size, uint8_t offset)
     len = store_fragment(i, offset);
   }
   if(len > 0) {
-    frag_info[i].reassembled_len += len;
+    mark_received(i, offset, len);
     return i;
   } else {
-    /* should we also clear all fragments since we failed to store
-       this fragment? */
+    /* The packet can not be reassembled without this fragment, free
+       the buffers of the context for other packets */
     PRINTF("*** Failed to store fragment - packet reassembly will fail tag:%d l\n", frag_info[i].tag);
+    UIP_STAT(++sicslowpan_reass_stats.drop);
+    clear_fragments(i);
     return -1;
   }
 }
@@ -418,20 +587,19 @@ add_fragment(uint16_t tag, uint16_t frag_size, uint8_t offset)
 static void
 copy_frags2uip(int context)
 {
-  int i;
+  uint8_t i;
 
   /* Copy from the fragment context info buffer first */
   memcpy((uint8_t *)UIP_IP_BUF, (uint8_t *)frag_info[context].first_frag,
 	 frag_info[context].first_frag_len);
-  for(i = 0; i < SICSLOWPAN_FRAGMENT_BUFFERS; i++) {
-    /* And also copy all matching fragments */
-    if(frag_buf[i].len > 0 && frag_buf[i].index == context) {
-      memcpy((uint8_t *)UIP_IP_BUF + (uint16_t)(frag_buf[i].offset << 3),
-	     (uint8_t *)frag_buf[i].data, frag_buf[i].len);
-    }
+  for(i = frag_info[context].bufs; i != FRAG_BUF_NONE; i = frag_buf[i].next) {
+    /* And also copy all fragments of the context */
+    memcpy((uint8_t *)UIP_IP_BUF + (uint16_t)(frag_buf[i].offset << 3),
+	   (uint8_t *)frag_buf[i].data, frag_buf[i].len);
   }
   /* deallocate all the fragments for this context */
   clear_fragments(context);
+  UIP_STAT(++sicslowpan_reass_stats.reassembled);
 }
 #endif /* SICSLOWPAN_CONF_FRAG */
 
@@ -1487,6 +1655,272 @@ output(const uip_lladdr_t *localdest)
   return 1;
 }
 
+#if SICSLOWPAN_CONF_FRAG && SICSLOWPAN_FRAG_FORWARDING
+/*--------------------------------------------------------------------*/
+/** \name Fragment forwarding
+ *
+ * The first fragment of a packet that is routed through this node is
+ * uncompressed to find the next hop, and sent on with a new tag. The
+ * following fragments are sent on as they arrive, with their tag
+ * rewritten, instead of being reassembled. Packets that need more than
+ * a header update, such as packets for this node, packets with a
+ * routing header or packets to be forwarded by the RPL root, are
+ * reassembled as usual.
+ * @{
+ */
+struct sicslowpan_frag_forward {
+  /** Sender and tag of the incoming fragments */
+  linkaddr_t sender;
+  uint16_t tag;
+  /** Size of the packet, 0 if the entry is unused */
+  uint16_t len;
+  /** Bytes of the packet sent on so far */
+  uint16_t forwarded;
+  /** Next hop and tag of the outgoing fragments */
+  linkaddr_t next_hop;
+  uint16_t new_tag;
+  /** Entries of packets that never complete are reused after this */
+  struct timer lifetime;
+};
+
+static struct sicslowpan_frag_forward frag_forward[SICSLOWPAN_FRAG_FORWARD_ENTRIES];
+
+/*--------------------------------------------------------------------*/
+static struct sicslowpan_frag_forward *
+forward_lookup(const linkaddr_t *sender, uint16_t tag)
+{
+  int i;
+
+  for(i = 0; i < SICSLOWPAN_FRAG_FORWARD_ENTRIES; i++) {
+    if(frag_forward[i].len > 0 && frag_forward[i].tag == tag &&
+       linkaddr_cmp(&frag_forward[i].sender, sender)) {
+      if(timer_expired(&frag_forward[i].lifetime)) {
+        /* The packet never completed, the sender has reused the tag */
+        frag_forward[i].len = 0;
+        return NULL;
+      }
+      return &frag_forward[i];
+    }
+  }
+  return NULL;
+}
+/*--------------------------------------------------------------------*/
+static struct sicslowpan_frag_forward *
+forward_alloc(void)
+{
+  int i;
+
+  for(i = 0; i < SICSLOWPAN_FRAG_FORWARD_ENTRIES; i++) {
+    if(frag_forward[i].len == 0 || timer_expired(&frag_forward[i].lifetime)) {
+      return &frag_forward[i];
+    }
+  }
+  return NULL;
+}
+/*--------------------------------------------------------------------*/
+/* Check if the packet whose first fragment is in uip_buf can be forwarded
+   fragment by fragment. Has no side effects, so that the packet can still
+   be reassembled if not. */
+static int
+forward_check(void)
+{
+  if(uip_is_addr_mcast(&UIP_IP_BUF->destipaddr) ||
+     uip_is_addr_linklocal(&UIP_IP_BUF->destipaddr) ||
+     uip_is_addr_linklocal(&UIP_IP_BUF->srcipaddr) ||
+     uip_ds6_is_my_addr(&UIP_IP_BUF->destipaddr) ||
+     uip_ds6_is_my_addr(&UIP_IP_BUF->srcipaddr) ||
+     UIP_IP_BUF->ttl <= 1) {
+    /* Let the IP stack handle it, or send the ICMP error */
+    return 0;
+  }
+
+#if UIP_CONF_IPV6_RPL
+  if(rpl_dag_root_is_root()) {
+    /* The root may have to insert a source routing header */
+    return 0;
+  }
+  if(UIP_IP_BUF->proto == UIP_PROTO_HBHO) {
+    /* The RPL option is processed once forwarding is certain */
+    return 1;
+  }
+#endif /* UIP_CONF_IPV6_RPL */
+
+  return UIP_IP_BUF->proto == UIP_PROTO_UDP ||
+    UIP_IP_BUF->proto == UIP_PROTO_TCP ||
+    UIP_IP_BUF->proto == UIP_PROTO_ICMP6;
+}
+/*--------------------------------------------------------------------*/
+/* Find the link-layer address of the next hop of the packet in uip_buf */
+static const uip_lladdr_t *
+forward_next_hop(void)
+{
+  uip_ipaddr_t *nexthop;
+  uip_ds6_route_t *route;
+  uip_ds6_nbr_t *nbr;
+
+  if(uip_ds6_is_addr_onlink(&UIP_IP_BUF->destipaddr)) {
+    nexthop = &UIP_IP_BUF->destipaddr;
+  } else if((route = uip_ds6_route_lookup(&UIP_IP_BUF->destipaddr)) != NULL) {
+    nexthop = uip_ds6_route_nexthop(route);
+  } else {
+    nexthop = uip_ds6_defrt_choose();
+  }
+  if(nexthop == NULL) {
+    return NULL;
+  }
+
+  /* Neighbors that need address resolution are left to the IP stack */
+  nbr = uip_ds6_nbr_lookup(nexthop);
+  if(nbr == NULL || nbr->state == NBR_INCOMPLETE) {
+    return NULL;
+  }
+  return uip_ds6_nbr_get_ll(nbr);
+}
+/*--------------------------------------------------------------------*/
+/* Forward the first fragment held by a reassembly context, and free the
+   context. Returns 0 if the packet must be reassembled instead. */
+static int
+forward_first_fragment(int context)
+{
+  struct sicslowpan_frag_info *info = &frag_info[context];
+  struct sicslowpan_frag_forward *f;
+  const uip_lladdr_t *next_hop;
+  int framer_hdrlen;
+  int payload_len;
+
+  if(info->bufs != FRAG_BUF_NONE || is_reassembled(context)) {
+    /* Following fragments arrived first and are held here: sending only
+       the first fragment on would lose them */
+    return 0;
+  }
+
+  memcpy((uint8_t *)UIP_IP_BUF, info->first_frag, info->first_frag_len);
+  uip_len = info->len;
+
+  if(!forward_check() ||
+     (next_hop = forward_next_hop()) == NULL ||
+     (f = forward_alloc()) == NULL) {
+    return 0;
+  }
+
+  /* Compress the header for the next hop, as output() does */
+  UIP_IP_BUF->ttl--;
+  uncomp_hdr_len = 0;
+  packetbuf_hdr_len = 0;
+  packetbuf_clear();
+  packetbuf_ptr = packetbuf_dataptr();
+#if SICSLOWPAN_COMPRESSION == SICSLOWPAN_COMPRESSION_HC06
+  compress_hdr_iphc((linkaddr_t *)next_hop);
+#else /* SICSLOWPAN_COMPRESSION == SICSLOWPAN_COMPRESSION_HC06 */
+  compress_hdr_ipv6((linkaddr_t *)next_hop);
+#endif /* SICSLOWPAN_COMPRESSION == SICSLOWPAN_COMPRESSION_HC06 */
+
+  /* The offsets of the next fragments are fixed, so the new first
+     fragment must carry the same part of the packet */
+  payload_len = info->first_frag_len - uncomp_hdr_len;
+  packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, (const linkaddr_t *)next_hop);
+  framer_hdrlen = NETSTACK_FRAMER.length();
+  if(framer_hdrlen < 0) {
+    framer_hdrlen = SICSLOWPAN_FIXED_HDRLEN;
+  }
+  if(payload_len < 0 ||
+     SICSLOWPAN_FRAG1_HDR_LEN + packetbuf_hdr_len + payload_len >
+     MAC_MAX_PAYLOAD - framer_hdrlen) {
+    PRINTF("sicslowpan: first fragment too large to forward\n");
+    return 0;
+  }
+
+#if UIP_CONF_IPV6_RPL
+  /* The packet is forwarded from here on, so process the RPL option as
+     the IP stack would, once. The option is not compressed, and is sent
+     on with the payload below. */
+  if(UIP_IP_BUF->proto == UIP_PROTO_HBHO) {
+    uip_ext_len = 0;
+    if(!rpl_verify_hbh_header(2) || !rpl_update_header()) {
+      PRINTF("sicslowpan: RPL option error, dropping packet\n");
+      UIP_STAT(++uip_stat.ip.drop);
+      clear_fragments(context);
+      uip_clear_buf();
+      return 1;
+    }
+  }
+#endif /* UIP_CONF_IPV6_RPL */
+
+  linkaddr_copy(&f->sender, &info->sender);
+  f->tag = info->tag;
+  f->len = info->len;
+  f->forwarded = info->first_frag_len;
+  linkaddr_copy(&f->next_hop, (const linkaddr_t *)next_hop);
+  f->new_tag = my_tag++;
+  timer_set(&f->lifetime, SICSLOWPAN_REASS_MAXAGE * CLOCK_SECOND / 16);
+
+  memmove(packetbuf_ptr + SICSLOWPAN_FRAG1_HDR_LEN, packetbuf_ptr, packetbuf_hdr_len);
+  SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_DISPATCH_SIZE,
+        ((SICSLOWPAN_DISPATCH_FRAG1 << 8) | f->len));
+  SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_TAG, f->new_tag);
+  packetbuf_hdr_len += SICSLOWPAN_FRAG1_HDR_LEN;
+  memcpy(packetbuf_ptr + packetbuf_hdr_len,
+         (uint8_t *)UIP_IP_BUF + uncomp_hdr_len, payload_len);
+  packetbuf_set_datalen(packetbuf_hdr_len + payload_len);
+
+  clear_fragments(context);
+  uip_clear_buf();
+
+  PRINTFI("sicslowpan: forwarding first fragment, tag %d to %d\n",
+          f->tag, f->new_tag);
+  UIP_STAT(++uip_stat.ip.forwarded);
+  UIP_STAT(++sicslowpan_reass_stats.forwarded);
+  send_packet(&f->next_hop);
+  return 1;
+}
+/*--------------------------------------------------------------------*/
+/* Forward the following fragment in packetbuf if its packet is being
+   forwarded. Returns 0 if it must go to reassembly instead, 1 if it was
+   sent on or dropped. */
+static int
+forward_next_fragment(uint16_t tag, uint16_t frag_size, uint8_t offset)
+{
+  struct sicslowpan_frag_forward *f;
+  uint8_t *frag;
+  uint16_t len;
+
+  f = forward_lookup(packetbuf_addr(PACKETBUF_ADDR_SENDER), tag);
+  if(f == NULL) {
+    return 0;
+  }
+
+  if(frag_size != f->len || (uint16_t)(offset << 3) >= f->len) {
+    PRINTF("*** Fragment does not fit - tag: %d offset: %d\n", tag, offset);
+    UIP_STAT(++sicslowpan_reass_stats.drop);
+    return 1;
+  }
+
+  /* Fragments may arrive in any order, so the entry is freed once all
+     the bytes of the packet have been sent on, and not at the fragment
+     that ends the packet */
+  f->forwarded += packetbuf_datalen() - SICSLOWPAN_FRAGN_HDR_LEN;
+  if(f->forwarded >= f->len) {
+    f->len = 0;
+  }
+
+  /* Send the fragment in a cleared packetbuf, as output() does, so that
+     attributes of the received frame, such as the pending bit or its
+     security, are not carried over. Clearing keeps the bytes in place. */
+  frag = packetbuf_dataptr();
+  len = packetbuf_datalen();
+  packetbuf_clear();
+  packetbuf_ptr = packetbuf_dataptr();
+  memmove(packetbuf_ptr, frag, len);
+  packetbuf_set_datalen(len);
+
+  SET16(PACKETBUF_FRAG_PTR, PACKETBUF_FRAG_TAG, f->new_tag);
+  UIP_STAT(++sicslowpan_reass_stats.forwarded);
+  send_packet(&f->next_hop);
+  return 1;
+}
+/** @} */
+#endif /* SICSLOWPAN_CONF_FRAG && SICSLOWPAN_FRAG_FORWARDING */
+
 /*--------------------------------------------------------------------*/
 /** \brief Process a received 6lowpan packet.
  *
@@ -1583,6 +2017,12 @@ input(void)
       PRINTFI("last_fragment?: packetbuf_payload_len %d frag_size %d\n",
               packetbuf_datalen() - packetbuf_hdr_len, frag_size);
 
+#if SICSLOWPAN_FRAG_FORWARDING
+      if(forward_next_fragment(frag_tag, frag_size, frag_offset)) {
+        return;
+      }
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+
       /* Add the fragment to the fragmentation context (this will also
          copy the payload) */
       frag_context = add_fragment(frag_tag, frag_size, frag_offset);
@@ -1595,7 +2035,7 @@ input(void)
          we should not store more */
       buffer = NULL;
 
-      if(frag_info[frag_context].reassembled_len >= frag_size) {
+      if(is_reassembled(frag_context)) {
         last_fragment = 1;
       }
       is_fragment = 1;
@@ -1678,13 +2118,21 @@ input(void)
   if(frag_size > 0) {
     /* Add the size of the header only for the first fragment. */
     if(first_fragment != 0) {
-      frag_info[frag_context].reassembled_len = uncomp_hdr_len + packetbuf_payload_len;
       frag_info[frag_context].first_frag_len = uncomp_hdr_len + packetbuf_payload_len;
+      mark_received(frag_context, 0, frag_info[frag_context].first_frag_len);
+#if SICSLOWPAN_FRAG_FORWARDING
+      if(forward_first_fragment(frag_context)) {
+        return;
+      }
+#endif /* SICSLOWPAN_FRAG_FORWARDING */
+      if(is_reassembled(frag_context)) {
+        /* The following fragments arrived first */
+        last_fragment = 1;
+      }
     }
     /* For the last fragment, we are OK if there is extrenous bytes at
        the end of the packet. */
     if(last_fragment != 0) {
-      frag_info[frag_context].reassembled_len = frag_size;
       /* copy to uip */
       copy_frags2uip(frag_context);
     }
@@ -1745,6 +2193,10 @@ sicslowpan_init(void)
 
   tcpip_set_outputfunc(output);
 
+#if SICSLOWPAN_CONF_FRAG
+  init_fragments();
+#endif /* SICSLOWPAN_CONF_FRAG */
+
 #if SICSLOWPAN_COMPRESSION == SICSLOWPAN_COMPRESSION_HC06
 /* Preinitialize any address contexts for better header compression
  * (Saves up to 13 bytes per 6lowpan packet)
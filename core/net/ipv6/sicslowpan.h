@@ -319,6 +319,27 @@ struct sicslowpan_nh_compressor {
 
 };
 
+/**
+ * The 6lowpan fragment reassembly statistics, gathered if
+ * UIP_STATISTICS is set to 1.
+ */
+struct sicslowpan_reass_stats {
+  uip_stats_t reassembled; /**< Number of packets reassembled. */
+  uip_stats_t timeouts;    /**< Number of reassemblies abandoned because
+                                they did not complete in time. */
+  uip_stats_t drop;        /**< Number of fragments dropped for lack of
+                                a context or buffer, or because they did
+                                not fit in the packet. */
+  uip_stats_t duplicates;  /**< Number of fragments dropped because they
+                                had been received already. */
+  uip_stats_t forwarded;   /**< Number of fragments forwarded without
+                                reassembly. */
+};
+
+#if UIP_STATISTICS == 1
+extern struct sicslowpan_reass_stats sicslowpan_reass_stats;
+#endif /* UIP_STATISTICS == 1 */
+
 int sicslowpan_get_last_rssi(void);
 
 extern const struct network_driver sicslowpan_driver;
@@ -71,6 +71,82 @@ void LINK_NEIGHBOR_CALLBACK(const linkaddr_t *addr, int status, int numtx);
 
 NBR_TABLE_GLOBAL(uip_ds6_nbr_t, ds6_neighbors);
 
+#if UIP_DS6_NBR_HASH_SIZE
+#if UIP_DS6_NBR_HASH_SIZE <= NBR_TABLE_MAX_NEIGHBORS || \
+  (UIP_DS6_NBR_HASH_SIZE & (UIP_DS6_NBR_HASH_SIZE - 1)) != 0
+#error UIP_DS6_NBR_CONF_HASH_SIZE must be a power of two larger than NBR_TABLE_CONF_MAX_NEIGHBORS
+#endif
+/* Open-addressing index from IPv6 address to nbr cache entry. Each slot
+ * holds the entry index plus one, 0 marks an empty slot. Collisions are
+ * resolved with linear probing, and removals shift the following entries
+ * back so that no tombstones are needed. Entries are added to the index
+ * in uip_ds6_nbr_add() and removed in uip_ds6_nbr_rm(), which is also
+ * the callback nbr-table calls when it evicts a neighbor. */
+#if NBR_TABLE_MAX_NEIGHBORS < 255
+typedef uint8_t nbr_index_slot_t;
+#else
+typedef uint16_t nbr_index_slot_t;
+#endif
+static nbr_index_slot_t ipaddr_index[UIP_DS6_NBR_HASH_SIZE];
+
+#define NBR_FROM_SLOT(s) (&((uip_ds6_nbr_t *)ds6_neighbors->data)[(s) - 1])
+#define SLOT_FROM_NBR(n) ((n) - (uip_ds6_nbr_t *)ds6_neighbors->data + 1)
+/*---------------------------------------------------------------------------*/
+/* Get the first index slot to probe for an IPv6 address */
+static unsigned
+slot_from_ipaddr(const uip_ipaddr_t *ipaddr)
+{
+  uint16_t h;
+
+  /* Neighbors mostly differ in the interface identifier, so only that
+     part is hashed. */
+  h = ipaddr->u16[4] ^ ipaddr->u16[5] ^ ipaddr->u16[6] ^ ipaddr->u16[7];
+  return (h ^ (h >> 8)) & (UIP_DS6_NBR_HASH_SIZE - 1);
+}
+/*---------------------------------------------------------------------------*/
+static void
+index_add(uip_ds6_nbr_t *nbr)
+{
+  unsigned slot = slot_from_ipaddr(&nbr->ipaddr);
+
+  while(ipaddr_index[slot] != 0) {
+    slot = (slot + 1) & (UIP_DS6_NBR_HASH_SIZE - 1);
+  }
+  ipaddr_index[slot] = SLOT_FROM_NBR(nbr);
+}
+/*---------------------------------------------------------------------------*/
+static void
+index_rm(uip_ds6_nbr_t *nbr)
+{
+  unsigned slot, next, home;
+  nbr_index_slot_t entry = SLOT_FROM_NBR(nbr);
+
+  slot = slot_from_ipaddr(&nbr->ipaddr);
+  while(ipaddr_index[slot] != entry) {
+    if(ipaddr_index[slot] == 0) {
+      return;
+    }
+    slot = (slot + 1) & (UIP_DS6_NBR_HASH_SIZE - 1);
+  }
+
+  /* Move back entries whose probe sequence passes the freed slot */
+  next = slot;
+  for(;;) {
+    next = (next + 1) & (UIP_DS6_NBR_HASH_SIZE - 1);
+    if(ipaddr_index[next] == 0) {
+      break;
+    }
+    home = slot_from_ipaddr(&NBR_FROM_SLOT(ipaddr_index[next])->ipaddr);
+    if(((next - home) & (UIP_DS6_NBR_HASH_SIZE - 1)) >=
+       ((next - slot) & (UIP_DS6_NBR_HASH_SIZE - 1))) {
+      ipaddr_index[slot] = ipaddr_index[next];
+      slot = next;
+    }
+  }
+  ipaddr_index[slot] = 0;
+}
+#endif /* UIP_DS6_NBR_HASH_SIZE */
+
 /*---------------------------------------------------------------------------*/
 void
 uip_ds6_neighbors_init(void)
@@ -84,10 +160,23 @@ uip_ds6_nbr_add(const uip_ipaddr_t *ipaddr, const uip_lladdr_t *lladdr,
                 uint8_t isrouter, uint8_t state, nbr_table_reason_t reason,
                 void *data)
 {
-  uip_ds6_nbr_t *nbr = nbr_table_add_lladdr(ds6_neighbors, (linkaddr_t*)lladdr
-                                            , reason, data);
+  uip_ds6_nbr_t *nbr;
+
+#if UIP_DS6_NBR_HASH_SIZE
+  /* nbr_table_add_lladdr() reuses the entry of a neighbor that is
+     already in the table with this link-layer address */
+  nbr = nbr_table_get_from_lladdr(ds6_neighbors, (linkaddr_t*)lladdr);
+  if(nbr != NULL) {
+    index_rm(nbr);
+  }
+#endif /* UIP_DS6_NBR_HASH_SIZE */
+  nbr = nbr_table_add_lladdr(ds6_neighbors, (linkaddr_t*)lladdr
+                             , reason, data);
   if(nbr) {
     uip_ipaddr_copy(&nbr->ipaddr, ipaddr);
+#if UIP_DS6_NBR_HASH_SIZE
+    index_add(nbr);
+#endif /* UIP_DS6_NBR_HASH_SIZE */
 #if UIP_ND6_SEND_RA || !UIP_CONF_ROUTER
     nbr->isrouter = isrouter;
 #endif /* UIP_ND6_SEND_RA || !UIP_CONF_ROUTER */
@@ -131,6 +220,9 @@ uip_ds6_nbr_rm(uip_ds6_nbr_t *nbr)
     uip_packetqueue_free(&nbr->packethandle);
 #endif /* UIP_CONF_IPV6_QUEUE_PKT */
     NEIGHBOR_STATE_CHANGED(nbr);
+#if UIP_DS6_NBR_HASH_SIZE
+    index_rm(nbr);
+#endif /* UIP_DS6_NBR_HASH_SIZE */
     return nbr_table_remove(ds6_neighbors, nbr);
   }
   return 0;
@@ -168,6 +260,20 @@ uip_ds6_nbr_num(void)
 uip_ds6_nbr_t *
 uip_ds6_nbr_lookup(const uip_ipaddr_t *ipaddr)
 {
+#if UIP_DS6_NBR_HASH_SIZE
+  unsigned slot;
+
+  if(ipaddr != NULL) {
+    slot = slot_from_ipaddr(ipaddr);
+    while(ipaddr_index[slot] != 0) {
+      if(uip_ipaddr_cmp(&NBR_FROM_SLOT(ipaddr_index[slot])->ipaddr, ipaddr)) {
+        return NBR_FROM_SLOT(ipaddr_index[slot]);
+      }
+      slot = (slot + 1) & (UIP_DS6_NBR_HASH_SIZE - 1);
+    }
+  }
+  return NULL;
+#else /* UIP_DS6_NBR_HASH_SIZE */
   uip_ds6_nbr_t *nbr = nbr_table_head(ds6_neighbors);
   if(ipaddr != NULL) {
     while(nbr != NULL) {
@@ -178,6 +284,7 @@ uip_ds6_nbr_lookup(const uip_ipaddr_t *ipaddr)
     }
   }
   return NULL;
+#endif /* UIP_DS6_NBR_HASH_SIZE */
 }
 /*---------------------------------------------------------------------------*/
 uip_ds6_nbr_t *
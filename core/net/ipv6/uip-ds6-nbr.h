@@ -64,6 +64,18 @@
 
 NBR_TABLE_DECLARE(ds6_neighbors);
 
+/** \brief Number of slots of the IPv6 address index of the nbr cache
+ *
+ * When non-zero, uip_ds6_nbr_lookup() finds neighbors through an
+ * open-addressing index from IPv6 address to nbr cache entry instead of
+ * comparing the address with every entry. Must be a power of two larger
+ * than NBR_TABLE_MAX_NEIGHBORS. */
+#ifdef UIP_DS6_NBR_CONF_HASH_SIZE
+#define UIP_DS6_NBR_HASH_SIZE UIP_DS6_NBR_CONF_HASH_SIZE
+#else /* UIP_DS6_NBR_CONF_HASH_SIZE */
+#define UIP_DS6_NBR_HASH_SIZE 0
+#endif /* UIP_DS6_NBR_CONF_HASH_SIZE */
+
 /** \brief An entry in the nbr cache */
 typedef struct uip_ds6_nbr {
   uip_ipaddr_t ipaddr;
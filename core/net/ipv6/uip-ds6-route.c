@@ -75,6 +75,15 @@ MEMB(routememb, uip_ds6_route_t, UIP_DS6_ROUTE_NB);
 static int num_routes = 0;
 static void rm_routelist_callback(nbr_table_item_t *ptr);
 
+#if UIP_DS6_ROUTE_HASH_SIZE
+/* Host routes are indexed by destination address in a hash table,
+   and all other routes are kept on the prefix list. Both are chained
+   through the index_next field. */
+static uip_ds6_route_t *host_routes[UIP_DS6_ROUTE_HASH_SIZE];
+static uip_ds6_route_t *prefix_routes;
+static uint32_t use_counter;
+#endif /* UIP_DS6_ROUTE_HASH_SIZE */
+
 #endif /* (UIP_CONF_MAX_ROUTES != 0) */
 
 /* Default routes are held on the defaultrouterlist and their
@@ -162,6 +171,10 @@ uip_ds6_route_init(void)
 #if (UIP_CONF_MAX_ROUTES != 0)
   memb_init(&routememb);
   list_init(routelist);
+#if UIP_DS6_ROUTE_HASH_SIZE
+  memset(host_routes, 0, sizeof(host_routes));
+  prefix_routes = NULL;
+#endif /* UIP_DS6_ROUTE_HASH_SIZE */
   nbr_table_register(nbr_routes,
                      (nbr_table_callback *)rm_routelist_callback);
 #endif /* (UIP_CONF_MAX_ROUTES != 0) */
@@ -174,6 +187,91 @@ uip_ds6_route_init(void)
 #endif
 }
 #if (UIP_CONF_MAX_ROUTES != 0)
+#if UIP_DS6_ROUTE_HASH_SIZE
+/*---------------------------------------------------------------------------*/
+static uip_ds6_route_t **
+index_chain(const uip_ipaddr_t *ipaddr, uint8_t length)
+{
+  uint16_t h;
+
+  if(length != 128) {
+    return &prefix_routes;
+  }
+  /* Routes to the nodes of a network mostly differ in the interface
+     identifier, so only that part is hashed. */
+  h = ipaddr->u16[4] ^ ipaddr->u16[5] ^ ipaddr->u16[6] ^ ipaddr->u16[7];
+  return &host_routes[(h ^ (h >> 8)) % UIP_DS6_ROUTE_HASH_SIZE];
+}
+/*---------------------------------------------------------------------------*/
+static void
+index_add(uip_ds6_route_t *r)
+{
+  uip_ds6_route_t **chain;
+
+  chain = index_chain(&r->ipaddr, r->length);
+  r->index_next = *chain;
+  *chain = r;
+  r->last_used = ++use_counter;
+}
+/*---------------------------------------------------------------------------*/
+static void
+index_rm(uip_ds6_route_t *r)
+{
+  uip_ds6_route_t **chain;
+
+  for(chain = index_chain(&r->ipaddr, r->length);
+      *chain != NULL; chain = &(*chain)->index_next) {
+    if(*chain == r) {
+      *chain = r->index_next;
+      break;
+    }
+  }
+  r->index_next = NULL;
+}
+/*---------------------------------------------------------------------------*/
+static uip_ds6_route_t *
+index_lookup(const uip_ipaddr_t *addr)
+{
+  uip_ds6_route_t *r;
+  uip_ds6_route_t *found_route;
+  uint8_t longestmatch;
+
+  /* A host route is always the longest match. */
+  for(r = *index_chain(addr, 128); r != NULL; r = r->index_next) {
+    if(uip_ipaddr_cmp(addr, &r->ipaddr)) {
+      return r;
+    }
+  }
+
+  found_route = NULL;
+  longestmatch = 0;
+  for(r = prefix_routes; r != NULL; r = r->index_next) {
+    if(r->length >= longestmatch &&
+       uip_ipaddr_prefixcmp(addr, &r->ipaddr, r->length)) {
+      longestmatch = r->length;
+      found_route = r;
+    }
+  }
+  return found_route;
+}
+#if UIP_DS6_ROUTE_REMOVE_LEAST_RECENTLY_USED
+/*---------------------------------------------------------------------------*/
+static uip_ds6_route_t *
+least_recently_used(void)
+{
+  uip_ds6_route_t *r;
+  uip_ds6_route_t *oldest;
+
+  oldest = list_head(routelist);
+  for(r = oldest; r != NULL; r = list_item_next(r)) {
+    if((int32_t)(r->last_used - oldest->last_used) < 0) {
+      oldest = r;
+    }
+  }
+  return oldest;
+}
+#endif /* UIP_DS6_ROUTE_REMOVE_LEAST_RECENTLY_USED */
+#endif /* UIP_DS6_ROUTE_HASH_SIZE */
 /*---------------------------------------------------------------------------*/
 static uip_lladdr_t *
 uip_ds6_route_nexthop_lladdr(uip_ds6_route_t *route)
@@ -254,15 +352,19 @@ uip_ds6_route_t *
 uip_ds6_route_lookup(uip_ipaddr_t *addr)
 {
 #if (UIP_CONF_MAX_ROUTES != 0)
-  uip_ds6_route_t *r;
   uip_ds6_route_t *found_route;
+#if !UIP_DS6_ROUTE_HASH_SIZE
+  uip_ds6_route_t *r;
   uint8_t longestmatch;
+#endif /* !UIP_DS6_ROUTE_HASH_SIZE */
 
   PRINTF("uip-ds6-route: Looking up route for ");
   PRINT6ADDR(addr);
   PRINTF("\n");
 
-
+#if UIP_DS6_ROUTE_HASH_SIZE
+  found_route = index_lookup(addr);
+#else /* UIP_DS6_ROUTE_HASH_SIZE */
   found_route = NULL;
   longestmatch = 0;
   for(r = uip_ds6_route_head();
@@ -278,6 +380,7 @@ uip_ds6_route_lookup(uip_ipaddr_t *addr)
       }
     }
   }
+#endif /* UIP_DS6_ROUTE_HASH_SIZE */
 
   if(found_route != NULL) {
     PRINTF("uip-ds6-route: Found route: ");
@@ -289,6 +392,11 @@ uip_ds6_route_lookup(uip_ipaddr_t *addr)
     PRINTF("uip-ds6-route: No route found\n");
   }
 
+#if UIP_DS6_ROUTE_HASH_SIZE
+  if(found_route != NULL) {
+    found_route->last_used = ++use_counter;
+  }
+#else /* UIP_DS6_ROUTE_HASH_SIZE */
   if(found_route != NULL && found_route != list_head(routelist)) {
     /* If we found a route, we put it at the start of the routeslist
        list. The list is ordered by how recently we looked them up:
@@ -298,6 +406,7 @@ uip_ds6_route_lookup(uip_ipaddr_t *addr)
     list_remove(routelist, found_route);
     list_push(routelist, found_route);
   }
+#endif /* UIP_DS6_ROUTE_HASH_SIZE */
 
   return found_route;
 #else /* (UIP_CONF_MAX_ROUTES != 0) */
@@ -355,7 +464,11 @@ uip_ds6_route_add(uip_ipaddr_t *ipaddr, uint8_t length,
 #if UIP_DS6_ROUTE_REMOVE_LEAST_RECENTLY_USED
       /* Removing the oldest route entry from the route table. The
          least recently used route is the first route on the list. */
+#if UIP_DS6_ROUTE_HASH_SIZE
+      oldest = least_recently_used();
+#else /* UIP_DS6_ROUTE_HASH_SIZE */
       oldest = list_tail(routelist);
+#endif /* UIP_DS6_ROUTE_HASH_SIZE */
 #endif
       if(oldest == NULL) {
         return NULL;
@@ -436,6 +549,9 @@ uip_ds6_route_add(uip_ipaddr_t *ipaddr, uint8_t length,
 
   uip_ipaddr_copy(&(r->ipaddr), ipaddr);
   r->length = length;
+#if UIP_DS6_ROUTE_HASH_SIZE
+  index_add(r);
+#endif /* UIP_DS6_ROUTE_HASH_SIZE */
 
 #ifdef UIP_DS6_ROUTE_STATE_TYPE
   memset(&r->state, 0, sizeof(UIP_DS6_ROUTE_STATE_TYPE));
@@ -479,6 +595,9 @@ uip_ds6_route_rm(uip_ds6_route_t *route)
 
     /* Remove the route from the route list */
     list_remove(routelist, route);
+#if UIP_DS6_ROUTE_HASH_SIZE
+    index_rm(route);
+#endif /* UIP_DS6_ROUTE_HASH_SIZE */
 
     /* Find the corresponding neighbor_route and remove it. */
     for(neighbor_route = list_head(route->neighbor_routes->route_list);
@@ -88,6 +88,19 @@ void uip_ds6_notification_rm(struct uip_ds6_notification *n);
 #define UIP_DS6_ROUTE_NB 4
 #endif /* UIP_CONF_MAX_ROUTES */
 
+/** \brief Number of buckets of the host route index
+ *
+ * When non-zero, /128 host routes are indexed in a hash table with
+ * this many buckets and all other routes are kept on a separate
+ * prefix list, so that uip_ds6_route_lookup() does not need to scan
+ * the whole routing table. Route use is then tracked with a counter
+ * instead of by reordering the route list. */
+#ifdef UIP_DS6_ROUTE_CONF_HASH_SIZE
+#define UIP_DS6_ROUTE_HASH_SIZE UIP_DS6_ROUTE_CONF_HASH_SIZE
+#else /* UIP_DS6_ROUTE_CONF_HASH_SIZE */
+#define UIP_DS6_ROUTE_HASH_SIZE 0
+#endif /* UIP_DS6_ROUTE_CONF_HASH_SIZE */
+
 /** \brief define some additional RPL related route state and
  *  neighbor callback for RPL - if not a DS6_ROUTE_STATE is already set */
 #ifndef UIP_DS6_ROUTE_STATE_TYPE
@@ -157,6 +170,11 @@ typedef struct uip_ds6_route {
 #ifdef UIP_DS6_ROUTE_STATE_TYPE
   UIP_DS6_ROUTE_STATE_TYPE state;
 #endif
+#if UIP_DS6_ROUTE_HASH_SIZE
+  /* Next route in the same hash bucket, or on the prefix list */
+  struct uip_ds6_route *index_next;
+  uint32_t last_used;
+#endif /* UIP_DS6_ROUTE_HASH_SIZE */
   uint8_t length;
 } uip_ds6_route_t;
 
@@ -75,6 +75,7 @@
 #include "net/ip/uip.h"
 #include "net/ip/uip_arch.h"
 #include "net/ip/uipopt.h"
+#include "net/ip/uip-chksum.h"
 #include "net/ipv6/uip-icmp6.h"
 #include "net/ipv6/uip-nd6.h"
 #include "net/ipv6/uip-ds6.h"
@@ -89,6 +90,10 @@
 #include "net/ipv6/uip-ds6-nbr.h"
 #endif /* UIP_ND6_SEND_NS */
 
+#if UIP_TCP && UIP_TCP_WINDOW_SEGMENTS > 1
+#include "net/ip/tcpip.h"
+#endif /* UIP_TCP && UIP_TCP_WINDOW_SEGMENTS > 1 */
+
 #include <string.h>
 
 /*---------------------------------------------------------------------------*/
@@ -325,6 +330,9 @@ uip_add32(uint8_t *op32, uint16_t op16)
 static uint16_t
 chksum(uint16_t sum, const uint8_t *data, uint16_t len)
 {
+#if UIP_CHKSUM_FAST
+  return uip_chksum_add(sum, data, len);
+#else /* UIP_CHKSUM_FAST */
   uint16_t t;
   const uint8_t *dataptr;
   const uint8_t *last_byte;
@@ -351,6 +359,7 @@ chksum(uint16_t sum, const uint8_t *data, uint16_t len)
 
   /* Return sum in host byte order. */
   return sum;
+#endif /* UIP_CHKSUM_FAST */
 }
 /*---------------------------------------------------------------------------*/
 uint16_t
@@ -428,6 +437,447 @@ uip_udpchksum(void)
 #endif /* UIP_UDP && UIP_UDP_CHECKSUMS */
 #endif /* UIP_ARCH_CHKSUM */
 /*---------------------------------------------------------------------------*/
+#if UIP_DEMUX_HASH
+/*
+ * Demultiplexing hash tables. Each has a head per bucket and, per
+ * connection slot, the next slot in the same bucket. Chains are kept
+ * sorted by slot, so the first match is the one a scan of the whole
+ * connection table would find.
+ */
+#define DEMUX_END       0xffff
+#define DEMUX_UNLINKED  0xfffe
+
+#if UIP_UDP
+static uint16_t udp_heads[UIP_DEMUX_BUCKETS];
+static uint16_t udp_next[UIP_UDP_CONNS];
+#endif /* UIP_UDP */
+#if UIP_TCP
+static uint16_t tcp_heads[UIP_DEMUX_BUCKETS];
+static uint16_t tcp_next[UIP_CONNS];
+static uint16_t listen_heads[UIP_DEMUX_BUCKETS];
+static uint16_t listen_next[UIP_LISTENPORTS];
+#endif /* UIP_TCP */
+/*---------------------------------------------------------------------------*/
+static uint16_t
+demux_hash(uint16_t lport, uint16_t rport, const uip_ipaddr_t *ripaddr)
+{
+  uint32_t h;
+  uint8_t i;
+
+  h = 2166136261UL;
+  h = (h ^ (lport & 0xff)) * 16777619UL;
+  h = (h ^ (lport >> 8)) * 16777619UL;
+  h = (h ^ (rport & 0xff)) * 16777619UL;
+  h = (h ^ (rport >> 8)) * 16777619UL;
+  if(ripaddr != NULL) {
+    /* The interface identifier tells peers apart well enough */
+    for(i = 8; i < 16; i++) {
+      h = (h ^ ripaddr->u8[i]) * 16777619UL;
+    }
+  }
+  return h % UIP_DEMUX_BUCKETS;
+}
+/*---------------------------------------------------------------------------*/
+static void
+demux_init(uint16_t *heads, uint16_t *next, uint16_t slots)
+{
+  uint16_t i;
+
+  for(i = 0; i < UIP_DEMUX_BUCKETS; i++) {
+    heads[i] = DEMUX_END;
+  }
+  for(i = 0; i < slots; i++) {
+    next[i] = DEMUX_UNLINKED;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+demux_link(uint16_t *heads, uint16_t *next, uint16_t bucket, uint16_t slot)
+{
+  uint16_t *p;
+
+  p = &heads[bucket];
+  while(*p != DEMUX_END && *p < slot) {
+    p = &next[*p];
+  }
+  next[slot] = *p;
+  *p = slot;
+}
+/*---------------------------------------------------------------------------*/
+static void
+demux_unlink(uint16_t *heads, uint16_t *next, uint16_t bucket, uint16_t slot)
+{
+  uint16_t *p;
+
+  if(next[slot] == DEMUX_UNLINKED) {
+    return;
+  }
+  p = &heads[bucket];
+  while(*p != DEMUX_END && *p != slot) {
+    p = &next[*p];
+  }
+  if(*p == slot) {
+    *p = next[slot];
+  }
+  next[slot] = DEMUX_UNLINKED;
+}
+/*---------------------------------------------------------------------------*/
+#if UIP_UDP
+void
+uip_udp_bind(struct uip_udp_conn *conn, uint16_t port)
+{
+  uint16_t slot;
+
+  slot = conn - uip_udp_conns;
+  demux_unlink(udp_heads, udp_next, demux_hash(conn->lport, 0, NULL), slot);
+  conn->lport = port;
+  if(port != 0) {
+    demux_link(udp_heads, udp_next, demux_hash(port, 0, NULL), slot);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t
+udp_port_in_use(uint16_t port)
+{
+  uint16_t slot;
+
+  for(slot = udp_heads[demux_hash(port, 0, NULL)];
+      slot != DEMUX_END; slot = udp_next[slot]) {
+    if(uip_udp_conns[slot].lport == port) {
+      return 1;
+    }
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Same match as the scan in uip_process(), over one bucket */
+static struct uip_udp_conn *
+udp_lookup(void)
+{
+  struct uip_udp_conn *conn;
+  uint16_t slot;
+
+  for(slot = udp_heads[demux_hash(UIP_UDP_BUF->destport, 0, NULL)];
+      slot != DEMUX_END; slot = udp_next[slot]) {
+    conn = &uip_udp_conns[slot];
+    if(UIP_UDP_BUF->destport == conn->lport &&
+       (conn->rport == 0 ||
+        UIP_UDP_BUF->srcport == conn->rport) &&
+       (uip_is_addr_unspecified(&conn->ripaddr) ||
+        uip_ipaddr_cmp(&UIP_IP_BUF->srcipaddr, &conn->ripaddr))) {
+      return conn;
+    }
+  }
+  return NULL;
+}
+#endif /* UIP_UDP */
+/*---------------------------------------------------------------------------*/
+#if UIP_TCP
+/* Called before the local and remote ports and address of a
+   connection are reused, and after they are set */
+static void
+tcp_unlink(struct uip_conn *conn)
+{
+  demux_unlink(tcp_heads, tcp_next,
+               demux_hash(conn->lport, conn->rport, &conn->ripaddr),
+               conn - uip_conns);
+}
+/*---------------------------------------------------------------------------*/
+static void
+tcp_link(struct uip_conn *conn)
+{
+  demux_link(tcp_heads, tcp_next,
+             demux_hash(conn->lport, conn->rport, &conn->ripaddr),
+             conn - uip_conns);
+}
+/*---------------------------------------------------------------------------*/
+static struct uip_conn *
+tcp_lookup(void)
+{
+  struct uip_conn *conn;
+  uint16_t slot;
+
+  for(slot = tcp_heads[demux_hash(UIP_TCP_BUF->destport,
+                                  UIP_TCP_BUF->srcport,
+                                  &UIP_IP_BUF->srcipaddr)];
+      slot != DEMUX_END; slot = tcp_next[slot]) {
+    conn = &uip_conns[slot];
+    if(conn->tcpstateflags != UIP_CLOSED &&
+       UIP_TCP_BUF->destport == conn->lport &&
+       UIP_TCP_BUF->srcport == conn->rport &&
+       uip_ipaddr_cmp(&UIP_IP_BUF->srcipaddr, &conn->ripaddr)) {
+      return conn;
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+static uint8_t
+listen_lookup(uint16_t port)
+{
+  uint16_t slot;
+
+  for(slot = listen_heads[demux_hash(port, 0, NULL)];
+      slot != DEMUX_END; slot = listen_next[slot]) {
+    if(uip_listenports[slot] == port) {
+      return 1;
+    }
+  }
+  return 0;
+}
+#endif /* UIP_TCP */
+#endif /* UIP_DEMUX_HASH */
+/*---------------------------------------------------------------------------*/
+#if UIP_TCP
+/* Updates the RTT estimate when outstanding data has been acknowledged
+   without retransmissions. This is taken directly from VJs original
+   code in his paper. */
+static void
+tcp_rtt_estimate(struct uip_conn *conn)
+{
+  signed char m;
+
+  m = conn->rto - conn->timer;
+  m = m - (conn->sa >> 3);
+  conn->sa += m;
+  if(m < 0) {
+    m = -m;
+  }
+  m = m - (conn->sv >> 2);
+  conn->sv += m;
+  conn->rto = (conn->sa >> 3) + conn->sv;
+}
+#endif /* UIP_TCP */
+/*---------------------------------------------------------------------------*/
+#if UIP_TCP && UIP_TCP_WINDOW_SEGMENTS > 1
+/*
+ * Multi-segment send window. In ESTABLISHED, conn->snd_nxt is the
+ * oldest unacknowledged byte and conn->len the number of bytes
+ * buffered from there on, of which the first "sent" bytes have been
+ * sent at least once.
+ */
+#define TCP_WINDOW_SIZE         (UIP_TCP_WINDOW_SEGMENTS * UIP_TCP_MSS)
+#if TCP_WINDOW_SIZE > 0xffff
+#error UIP_CONF_TCP_WINDOW_SEGMENTS * UIP_TCP_MSS must fit in 16 bits
+#endif
+
+/* The last uip_send() has not yet been reported with UIP_ACKDATA */
+#define TCP_WINDOW_APP_PENDING  0x01
+/* The application has closed, the FIN goes out when the buffer drains */
+#define TCP_WINDOW_CLOSE        0x02
+/* The oldest unacknowledged segment must be resent */
+#define TCP_WINDOW_REXMIT       0x04
+/* The peer has closed, our FIN goes out when the buffer drains */
+#define TCP_WINDOW_PEER_FIN     0x08
+
+struct tcp_window {
+  uint8_t buf[TCP_WINDOW_SIZE];
+  uint16_t head;      /* Offset of conn->snd_nxt in buf */
+  uint16_t sent;      /* Bytes of conn->len sent at least once */
+  uint16_t snd_wnd;   /* Window advertised by the peer */
+  uint16_t recover;   /* Bytes to be acknowledged before recovery ends */
+  uint8_t dupacks;
+  uint8_t flags;
+};
+
+static struct tcp_window tcp_windows[UIP_CONNS];
+
+/* Sequence number offset from snd_nxt of the segment being sent */
+static uint16_t tcp_send_offset;
+/*---------------------------------------------------------------------------*/
+static struct tcp_window *
+tcp_window(struct uip_conn *conn)
+{
+  return &tcp_windows[conn - uip_conns];
+}
+/*---------------------------------------------------------------------------*/
+static void
+tcp_window_init(struct uip_conn *conn)
+{
+  struct tcp_window *w;
+
+  w = tcp_window(conn);
+  w->head = 0;
+  w->sent = 0;
+  w->snd_wnd = UIP_TCP_MSS;
+  w->recover = 0;
+  w->dupacks = 0;
+  w->flags = 0;
+}
+/*---------------------------------------------------------------------------*/
+static uint32_t
+seq32(const uint8_t *seq)
+{
+  return ((uint32_t)seq[0] << 24) | ((uint32_t)seq[1] << 16) |
+    ((uint32_t)seq[2] << 8) | seq[3];
+}
+/*---------------------------------------------------------------------------*/
+/* Returns the position in buf of the byte off bytes after snd_nxt */
+static uint16_t
+tcp_window_pos(struct tcp_window *w, uint16_t off)
+{
+  uint32_t pos;
+
+  pos = (uint32_t)w->head + off;
+  if(pos >= TCP_WINDOW_SIZE) {
+    pos -= TCP_WINDOW_SIZE;
+  }
+  return (uint16_t)pos;
+}
+/*---------------------------------------------------------------------------*/
+/* Processes the acknowledgment and window of the incoming segment */
+static void
+tcp_window_ack(struct uip_conn *conn)
+{
+  struct tcp_window *w;
+  uint32_t acked;
+  uint16_t wnd;
+
+  if(!(UIP_TCP_BUF->flags & TCP_ACK)) {
+    return;
+  }
+  w = tcp_window(conn);
+
+  /* A zero window is probed by sending into it, as with one segment. */
+  wnd = ((uint16_t)UIP_TCP_BUF->wnd[0] << 8) + UIP_TCP_BUF->wnd[1];
+  if(wnd == 0) {
+    wnd = conn->initialmss;
+  }
+
+  acked = seq32(UIP_TCP_BUF->ackno) - seq32(conn->snd_nxt);
+  if(acked == 0) {
+    /* A duplicate ACK (RFC 5681) carries no data and does not change
+       the window. The third one triggers a fast retransmit. */
+    if(w->sent > 0 && uip_len == 0 && wnd == w->snd_wnd &&
+       !(UIP_TCP_BUF->flags & (TCP_SYN | TCP_FIN)) &&
+       ++w->dupacks == 3 && w->recover == 0) {
+      w->recover = w->sent;
+      w->flags |= TCP_WINDOW_REXMIT;
+      UIP_STAT(++uip_stat.tcp.rexmit);
+    }
+  } else if(acked <= w->sent) {
+    uip_add32(conn->snd_nxt, (uint16_t)acked);
+    conn->snd_nxt[0] = uip_acc32[0];
+    conn->snd_nxt[1] = uip_acc32[1];
+    conn->snd_nxt[2] = uip_acc32[2];
+    conn->snd_nxt[3] = uip_acc32[3];
+
+    if(conn->nrtx == 0 && w->recover == 0) {
+      tcp_rtt_estimate(conn);
+    }
+    conn->timer = conn->rto;
+    conn->nrtx = 0;
+
+    conn->len -= acked;
+    w->sent -= acked;
+    w->head = tcp_window_pos(w, acked);
+    w->dupacks = 0;
+
+    /* During recovery, an ACK that does not reach the recovery point
+       shows where the next hole is. */
+    if(w->recover > acked) {
+      w->recover -= acked;
+      w->flags |= TCP_WINDOW_REXMIT;
+    } else {
+      w->recover = 0;
+    }
+  }
+  w->snd_wnd = wnd;
+}
+/*---------------------------------------------------------------------------*/
+/* Checks if the application waits for UIP_ACKDATA and there is room
+   for another full segment */
+static uint8_t
+tcp_window_app_room(struct uip_conn *conn)
+{
+  return (tcp_window(conn)->flags &
+          (TCP_WINDOW_APP_PENDING | TCP_WINDOW_CLOSE)) ==
+    TCP_WINDOW_APP_PENDING &&
+    TCP_WINDOW_SIZE - conn->len >= conn->initialmss;
+}
+/*---------------------------------------------------------------------------*/
+/* Reports the buffered uip_send() to the application once there is
+   room for another full segment */
+static uint8_t
+tcp_window_ackdata(struct uip_conn *conn)
+{
+  if(tcp_window_app_room(conn)) {
+    tcp_window(conn)->flags &= ~TCP_WINDOW_APP_PENDING;
+    return UIP_ACKDATA;
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Moves new application data from uip_sappdata into the buffer. Data
+   sent while an earlier uip_send() is still pending is a retransmission
+   and already buffered. */
+static void
+tcp_window_buffer(struct uip_conn *conn)
+{
+  struct tcp_window *w;
+  uint16_t n, pos, first;
+
+  w = tcp_window(conn);
+  n = uip_slen;
+  uip_slen = 0;
+  if(n == 0 || (w->flags & TCP_WINDOW_APP_PENDING)) {
+    return;
+  }
+  if(n > conn->mss) {
+    n = conn->mss;
+  }
+  if(n > TCP_WINDOW_SIZE - conn->len) {
+    n = TCP_WINDOW_SIZE - conn->len;
+  }
+  pos = tcp_window_pos(w, conn->len);
+  first = MIN(n, TCP_WINDOW_SIZE - pos);
+  memcpy(&w->buf[pos], uip_sappdata, first);
+  memcpy(w->buf, (uint8_t *)uip_sappdata + first, n - first);
+  conn->len += n;
+  w->flags |= TCP_WINDOW_APP_PENDING;
+}
+/*---------------------------------------------------------------------------*/
+/* Copies the next segment to send into uip_sappdata and returns its
+   length, or zero if there is nothing to send */
+static uint16_t
+tcp_window_segment(struct uip_conn *conn)
+{
+  struct tcp_window *w;
+  uint16_t off, n, limit, pos, first;
+
+  w = tcp_window(conn);
+  off = 0;
+  n = 0;
+  if(w->flags & TCP_WINDOW_REXMIT) {
+    w->flags &= ~TCP_WINDOW_REXMIT;
+    n = MIN(w->sent, conn->mss);
+  }
+  /* New data waits until recovery is over, since a receiver that
+     drops segments out of order would drop it too. */
+  limit = w->recover > 0 ? w->sent : MIN(conn->len, w->snd_wnd);
+  if(n == 0 && w->sent < limit) {
+    off = w->sent;
+    n = MIN(limit - w->sent, conn->mss);
+    w->sent += n;
+  }
+  if(n == 0) {
+    return 0;
+  }
+
+  pos = tcp_window_pos(w, off);
+  first = MIN(n, TCP_WINDOW_SIZE - pos);
+  memcpy(uip_sappdata, &w->buf[pos], first);
+  memcpy((uint8_t *)uip_sappdata + first, w->buf, n - first);
+  tcp_send_offset = off;
+
+  /* Each poll sends one more segment, until the window is full. */
+  if(w->sent < limit || tcp_window_app_room(conn)) {
+    tcpip_poll_tcp(conn);
+  }
+  return n;
+}
+#endif /* UIP_TCP && UIP_TCP_WINDOW_SEGMENTS > 1 */
+/*---------------------------------------------------------------------------*/
 void
 uip_init(void)
 {
@@ -444,6 +894,10 @@ uip_init(void)
   for(c = 0; c < UIP_CONNS; ++c) {
     uip_conns[c].tcpstateflags = UIP_CLOSED;
   }
+#if UIP_DEMUX_HASH
+  demux_init(tcp_heads, tcp_next, UIP_CONNS);
+  demux_init(listen_heads, listen_next, UIP_LISTENPORTS);
+#endif /* UIP_DEMUX_HASH */
 #endif /* UIP_TCP */
 
 #if UIP_ACTIVE_OPEN || UIP_UDP
@@ -454,6 +908,9 @@ uip_init(void)
   for(c = 0; c < UIP_UDP_CONNS; ++c) {
     uip_udp_conns[c].lport = 0;
   }
+#if UIP_DEMUX_HASH
+  demux_init(udp_heads, udp_next, UIP_UDP_CONNS);
+#endif /* UIP_DEMUX_HASH */
 #endif /* UIP_UDP */
 
 #if UIP_IPV6_MULTICAST
@@ -505,6 +962,9 @@ uip_connect(const uip_ipaddr_t *ripaddr, uint16_t rport)
     return 0;
   }
 
+#if UIP_DEMUX_HASH
+  tcp_unlink(conn);
+#endif /* UIP_DEMUX_HASH */
   conn->tcpstateflags = UIP_SYN_SENT;
 
   conn->snd_nxt[0] = iss[0];
@@ -525,9 +985,15 @@ uip_connect(const uip_ipaddr_t *ripaddr, uint16_t rport)
   conn->rto = UIP_RTO;
   conn->sa = 0;
   conn->sv = 16;   /* Initial value of the RTT variance. */
+#if UIP_TCP_WINDOW_SEGMENTS > 1
+  tcp_window_init(conn);
+#endif /* UIP_TCP_WINDOW_SEGMENTS > 1 */
   conn->lport = uip_htons(lastport);
   conn->rport = rport;
   uip_ipaddr_copy(&conn->ripaddr, ripaddr);
+#if UIP_DEMUX_HASH
+  tcp_link(conn);
+#endif /* UIP_DEMUX_HASH */
 
   return conn;
 }
@@ -572,11 +1038,17 @@ uip_udp_new(const uip_ipaddr_t *ripaddr, uint16_t rport)
     lastport = 4096;
   }
 
+#if UIP_DEMUX_HASH
+  if(udp_port_in_use(uip_htons(lastport))) {
+    goto again;
+  }
+#else /* UIP_DEMUX_HASH */
   for(c = 0; c < UIP_UDP_CONNS; ++c) {
     if(uip_udp_conns[c].lport == uip_htons(lastport)) {
       goto again;
     }
   }
+#endif /* UIP_DEMUX_HASH */
 
   conn = 0;
   for(c = 0; c < UIP_UDP_CONNS; ++c) {
@@ -590,7 +1062,7 @@ uip_udp_new(const uip_ipaddr_t *ripaddr, uint16_t rport)
     return 0;
   }
 
-  conn->lport = UIP_HTONS(lastport);
+  uip_udp_bind(conn, UIP_HTONS(lastport));
   conn->rport = rport;
   if(ripaddr == NULL) {
     memset(&conn->ripaddr, 0, sizeof(uip_ipaddr_t));
@@ -610,6 +1082,9 @@ uip_unlisten(uint16_t port)
   int c;
   for(c = 0; c < UIP_LISTENPORTS; ++c) {
     if(uip_listenports[c] == port) {
+#if UIP_DEMUX_HASH
+      demux_unlink(listen_heads, listen_next, demux_hash(port, 0, NULL), c);
+#endif /* UIP_DEMUX_HASH */
       uip_listenports[c] = 0;
       return;
     }
@@ -623,6 +1098,9 @@ uip_listen(uint16_t port)
   for(c = 0; c < UIP_LISTENPORTS; ++c) {
     if(uip_listenports[c] == 0) {
       uip_listenports[c] = port;
+#if UIP_DEMUX_HASH
+      demux_link(listen_heads, listen_next, demux_hash(port, 0, NULL), c);
+#endif /* UIP_DEMUX_HASH */
       return;
     }
   }
@@ -961,6 +1439,21 @@ uip_process(uint8_t flag)
      particular connection. */
   if(flag == UIP_POLL_REQUEST) {
 #if UIP_TCP
+#if UIP_TCP_WINDOW_SEGMENTS > 1
+    if((uip_connr->tcpstateflags & UIP_TS_MASK) == UIP_ESTABLISHED) {
+      /* The application is polled whenever it may send, and the
+         buffer is sent from whether or not it does. */
+      tcp_window_poll:
+      uip_slen = 0;
+      uip_flags = tcp_window_ackdata(uip_connr);
+      if(!(tcp_window(uip_connr)->flags &
+           (TCP_WINDOW_APP_PENDING | TCP_WINDOW_CLOSE))) {
+        uip_flags |= UIP_POLL;
+        UIP_APPCALL();
+      }
+      goto appsend;
+    } else
+#endif /* UIP_TCP_WINDOW_SEGMENTS > 1 */
     if((uip_connr->tcpstateflags & UIP_TS_MASK) == UIP_ESTABLISHED &&
        !uip_outstanding(uip_connr)) {
       uip_flags = UIP_POLL;
@@ -1058,6 +1551,17 @@ uip_process(uint8_t flag)
 #endif /* UIP_ACTIVE_OPEN */
 
           case UIP_ESTABLISHED:
+#if UIP_TCP_WINDOW_SEGMENTS > 1
+            /*
+             * With a send window, we resend the oldest segment from
+             * the buffer, and the later ones as the ACKs for the
+             * resent ones show where the holes are.
+             */
+            tcp_window(uip_connr)->recover = tcp_window(uip_connr)->sent;
+            tcp_window(uip_connr)->flags |= TCP_WINDOW_REXMIT;
+            uip_flags = 0;
+            goto tcp_window_send;
+#else /* UIP_TCP_WINDOW_SEGMENTS > 1 */
             /*
              * In the ESTABLISHED state, we call upon the application
              * to do the actual retransmit after which we jump into
@@ -1067,6 +1571,7 @@ uip_process(uint8_t flag)
             uip_flags = UIP_REXMIT;
             UIP_APPCALL();
             goto apprexmit;
+#endif /* UIP_TCP_WINDOW_SEGMENTS > 1 */
 
           case UIP_FIN_WAIT_1:
           case UIP_CLOSING:
@@ -1074,12 +1579,20 @@ uip_process(uint8_t flag)
             /* In all these states we should retransmit a FINACK. */
             goto tcp_send_finack;
           }
+#if UIP_TCP_WINDOW_SEGMENTS > 1
+        } else if((uip_connr->tcpstateflags & UIP_TS_MASK) ==
+                  UIP_ESTABLISHED) {
+          goto tcp_window_poll;
+#endif /* UIP_TCP_WINDOW_SEGMENTS > 1 */
         }
       } else if((uip_connr->tcpstateflags & UIP_TS_MASK) == UIP_ESTABLISHED) {
         /*
          * If there was no need for a retransmission, we poll the
          * application for new data.
          */
+#if UIP_TCP_WINDOW_SEGMENTS > 1
+        goto tcp_window_poll;
+#endif /* UIP_TCP_WINDOW_SEGMENTS > 1 */
         uip_flags = UIP_POLL;
         UIP_APPCALL();
         goto appsend;
@@ -1514,6 +2027,12 @@ uip_process(uint8_t flag)
   }
 
   /* Demultiplex this UDP packet between the UDP "connections". */
+#if UIP_DEMUX_HASH
+  uip_udp_conn = udp_lookup();
+  if(uip_udp_conn != NULL) {
+    goto udp_found;
+  }
+#else /* UIP_DEMUX_HASH */
   for(uip_udp_conn = &uip_udp_conns[0];
       uip_udp_conn < &uip_udp_conns[UIP_UDP_CONNS];
       ++uip_udp_conn) {
@@ -1533,6 +2052,7 @@ uip_process(uint8_t flag)
       goto udp_found;
     }
   }
+#endif /* UIP_DEMUX_HASH */
   PRINTF("udp: no matching connection found\n");
   UIP_STAT(++uip_stat.udp.drop);
 
@@ -1618,6 +2138,12 @@ uip_process(uint8_t flag)
 
   /* Demultiplex this segment. */
   /* First check any active connections. */
+#if UIP_DEMUX_HASH
+  uip_connr = tcp_lookup();
+  if(uip_connr != NULL) {
+    goto found;
+  }
+#else /* UIP_DEMUX_HASH */
   for(uip_connr = &uip_conns[0]; uip_connr <= &uip_conns[UIP_CONNS - 1];
       ++uip_connr) {
     if(uip_connr->tcpstateflags != UIP_CLOSED &&
@@ -1627,6 +2153,7 @@ uip_process(uint8_t flag)
       goto found;
     }
   }
+#endif /* UIP_DEMUX_HASH */
 
   /* If we didn't find and active connection that expected the packet,
      either this packet is an old duplicate, or this is a SYN packet
@@ -1638,11 +2165,17 @@ uip_process(uint8_t flag)
 
   tmp16 = UIP_TCP_BUF->destport;
   /* Next, check listening connections. */
+#if UIP_DEMUX_HASH
+  if(listen_lookup(tmp16)) {
+    goto found_listen;
+  }
+#else /* UIP_DEMUX_HASH */
   for(c = 0; c < UIP_LISTENPORTS; ++c) {
     if(tmp16 == uip_listenports[c]) {
       goto found_listen;
     }
   }
+#endif /* UIP_DEMUX_HASH */
 
   /* No matching connection found, so we send a RST packet. */
   UIP_STAT(++uip_stat.tcp.synrst);
@@ -1733,15 +2266,24 @@ uip_process(uint8_t flag)
     goto drop;
   }
   uip_conn = uip_connr;
+#if UIP_DEMUX_HASH
+  tcp_unlink(uip_connr);
+#endif /* UIP_DEMUX_HASH */
 
   /* Fill in the necessary fields for the new connection. */
   uip_connr->rto = uip_connr->timer = UIP_RTO;
   uip_connr->sa = 0;
   uip_connr->sv = 4;
   uip_connr->nrtx = 0;
+#if UIP_TCP_WINDOW_SEGMENTS > 1
+  tcp_window_init(uip_connr);
+#endif /* UIP_TCP_WINDOW_SEGMENTS > 1 */
   uip_connr->lport = UIP_TCP_BUF->destport;
   uip_connr->rport = UIP_TCP_BUF->srcport;
   uip_ipaddr_copy(&uip_connr->ripaddr, &UIP_IP_BUF->srcipaddr);
+#if UIP_DEMUX_HASH
+  tcp_link(uip_connr);
+#endif /* UIP_DEMUX_HASH */
   uip_connr->tcpstateflags = UIP_SYN_RCVD;
 
   uip_connr->snd_nxt[0] = iss[0];
@@ -1868,6 +2410,12 @@ uip_process(uint8_t flag)
      data. If so, we update the sequence number, reset the length of
      the outstanding data, calculate RTT estimations, and reset the
      retransmission timer. */
+#if UIP_TCP_WINDOW_SEGMENTS > 1
+  if((uip_connr->tcpstateflags & UIP_TS_MASK) == UIP_ESTABLISHED) {
+    /* With a send window, any ACK may release part of the buffer. */
+    tcp_window_ack(uip_connr);
+  } else
+#endif /* UIP_TCP_WINDOW_SEGMENTS > 1 */
   if((UIP_TCP_BUF->flags & TCP_ACK) && uip_outstanding(uip_connr)) {
     uip_add32(uip_connr->snd_nxt, uip_connr->len);
 
@@ -1883,18 +2431,7 @@ uip_process(uint8_t flag)
 
       /* Do RTT estimation, unless we have done retransmissions. */
       if(uip_connr->nrtx == 0) {
-        signed char m;
-        m = uip_connr->rto - uip_connr->timer;
-        /* This is taken directly from VJs original code in his paper */
-        m = m - (uip_connr->sa >> 3);
-        uip_connr->sa += m;
-        if(m < 0) {
-          m = -m;
-        }
-        m = m - (uip_connr->sv >> 2);
-        uip_connr->sv += m;
-        uip_connr->rto = (uip_connr->sa >> 3) + uip_connr->sv;
-
+        tcp_rtt_estimate(uip_connr);
       }
       /* Set the acknowledged flag. */
       uip_flags = UIP_ACKDATA;
@@ -2007,18 +2544,31 @@ uip_process(uint8_t flag)
          If the incoming packet is a FIN, we should close the connection on
          this side as well, and we send out a FIN and enter the LAST_ACK
          state. We require that there is no outstanding data; otherwise the
-         sequence numbers will be screwed up. */
+         sequence numbers will be screwed up. With a send window, the data
+         in the buffer has been reported to the application as sent, so
+         it is sent before our FIN instead. */
 
     if(UIP_TCP_BUF->flags & TCP_FIN && !(uip_connr->tcpstateflags & UIP_STOPPED)) {
+#if UIP_TCP_WINDOW_SEGMENTS <= 1
       if(uip_outstanding(uip_connr)) {
         goto drop;
       }
+#endif /* UIP_TCP_WINDOW_SEGMENTS <= 1 */
       uip_add_rcv_nxt(1 + uip_len);
       uip_flags |= UIP_CLOSE;
       if(uip_len > 0) {
         uip_flags |= UIP_NEWDATA;
       }
       UIP_APPCALL();
+#if UIP_TCP_WINDOW_SEGMENTS > 1
+      if(uip_connr->len > 0) {
+        /* The FIN is acknowledged with the next segment, or alone if
+           the window is full */
+        tcp_window(uip_connr)->flags |= TCP_WINDOW_CLOSE | TCP_WINDOW_PEER_FIN;
+        uip_flags = UIP_NEWDATA;
+        goto tcp_window_send;
+      }
+#endif /* UIP_TCP_WINDOW_SEGMENTS > 1 */
       uip_connr->len = 1;
       uip_connr->tcpstateflags = UIP_LAST_ACK;
       uip_connr->nrtx = 0;
@@ -2093,6 +2643,27 @@ uip_process(uint8_t flag)
          put into the uip_appdata and the length of the data should be
          put into uip_len. If the application don't have any data to
          send, uip_len must be set to 0. */
+#if UIP_TCP_WINDOW_SEGMENTS > 1
+    if(tcp_window(uip_connr)->flags & TCP_WINDOW_CLOSE) {
+      /* The application has closed, but still gets the data that
+         arrives before the buffer has drained. It can only abort. */
+      if(uip_flags & UIP_NEWDATA) {
+        uip_slen = 0;
+        UIP_APPCALL();
+        if(uip_flags & UIP_ABORT) {
+          goto appsend;
+        }
+      }
+      uip_slen = 0;
+      goto tcp_window_send;
+    }
+    uip_flags |= tcp_window_ackdata(uip_connr);
+    if(!(uip_flags & (UIP_NEWDATA | UIP_ACKDATA))) {
+      /* The ACK may still have opened the window or called for a
+         retransmission. */
+      goto tcp_window_send;
+    }
+#endif /* UIP_TCP_WINDOW_SEGMENTS > 1 */
     if(uip_flags & (UIP_NEWDATA | UIP_ACKDATA)) {
       uip_slen = 0;
       UIP_APPCALL();
@@ -2108,6 +2679,20 @@ uip_process(uint8_t flag)
 
       if(uip_flags & UIP_CLOSE) {
         uip_slen = 0;
+#if UIP_TCP_WINDOW_SEGMENTS > 1
+        if(uip_connr->len > 0) {
+          tcp_window(uip_connr)->flags |= TCP_WINDOW_CLOSE;
+          goto tcp_window_send;
+        }
+        tcp_window_fin:
+        if(tcp_window(uip_connr)->flags & TCP_WINDOW_PEER_FIN) {
+          /* The peer closed first, and only our FIN is left */
+          uip_connr->len = 1;
+          uip_connr->tcpstateflags = UIP_LAST_ACK;
+          uip_connr->nrtx = 0;
+          goto tcp_send_finack;
+        }
+#endif /* UIP_TCP_WINDOW_SEGMENTS > 1 */
         uip_connr->len = 1;
         uip_connr->tcpstateflags = UIP_FIN_WAIT_1;
         uip_connr->nrtx = 0;
@@ -2115,6 +2700,21 @@ uip_process(uint8_t flag)
         goto tcp_send_nodata;
       }
 
+#if UIP_TCP_WINDOW_SEGMENTS > 1
+      tcp_window_buffer(uip_connr);
+
+      tcp_window_send:
+      uip_slen = tcp_window_segment(uip_connr);
+      if(uip_slen > 0) {
+        uip_len = uip_slen + UIP_TCPIP_HLEN;
+        UIP_TCP_BUF->flags = TCP_ACK | TCP_PSH;
+        goto tcp_send_noopts;
+      }
+      if((tcp_window(uip_connr)->flags & TCP_WINDOW_CLOSE) &&
+         uip_connr->len == 0) {
+        goto tcp_window_fin;
+      }
+#else /* UIP_TCP_WINDOW_SEGMENTS > 1 */
       /* If uip_slen > 0, the application has data to be sent. */
       if(uip_slen > 0) {
 
@@ -2161,6 +2761,7 @@ uip_process(uint8_t flag)
         /* Send the packet. */
         goto tcp_send_noopts;
       }
+#endif /* UIP_TCP_WINDOW_SEGMENTS > 1 */
       /* If there is no data to send, just send out a pure ACK if
            there is newdata. */
       if(uip_flags & UIP_NEWDATA) {
@@ -2260,10 +2861,20 @@ uip_process(uint8_t flag)
   UIP_TCP_BUF->ackno[2] = uip_connr->rcv_nxt[2];
   UIP_TCP_BUF->ackno[3] = uip_connr->rcv_nxt[3];
 
+#if UIP_TCP_WINDOW_SEGMENTS > 1
+  /* Segments further into the send window start after snd_nxt. */
+  uip_add32(uip_connr->snd_nxt, tcp_send_offset);
+  tcp_send_offset = 0;
+  UIP_TCP_BUF->seqno[0] = uip_acc32[0];
+  UIP_TCP_BUF->seqno[1] = uip_acc32[1];
+  UIP_TCP_BUF->seqno[2] = uip_acc32[2];
+  UIP_TCP_BUF->seqno[3] = uip_acc32[3];
+#else /* UIP_TCP_WINDOW_SEGMENTS > 1 */
   UIP_TCP_BUF->seqno[0] = uip_connr->snd_nxt[0];
   UIP_TCP_BUF->seqno[1] = uip_connr->snd_nxt[1];
   UIP_TCP_BUF->seqno[2] = uip_connr->snd_nxt[2];
   UIP_TCP_BUF->seqno[3] = uip_connr->snd_nxt[3];
+#endif /* UIP_TCP_WINDOW_SEGMENTS > 1 */
 
   UIP_TCP_BUF->srcport  = uip_connr->lport;
   UIP_TCP_BUF->destport = uip_connr->rport;
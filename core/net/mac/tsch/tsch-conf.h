@@ -170,6 +170,15 @@
 #define TSCH_WITH_LINK_SELECTOR 0
 #endif /* TSCH_CONF_WITH_LINK_SELECTOR */
 
+/* The number of traffic classes in each neighbor queue. With more than
+ * one, packets are queued by PACKETBUF_ATTR_TSCH_PRIORITY and the highest
+ * class is sent first, so that control traffic does not wait behind data */
+#ifdef TSCH_QUEUE_CONF_NUM_PRIORITIES
+#define TSCH_QUEUE_NUM_PRIORITIES TSCH_QUEUE_CONF_NUM_PRIORITIES
+#else /* TSCH_QUEUE_CONF_NUM_PRIORITIES */
+#define TSCH_QUEUE_NUM_PRIORITIES 1
+#endif /* TSCH_QUEUE_CONF_NUM_PRIORITIES */
+
 /* Estimate the drift of the time-source neighbor and compensate for it? */
 #ifdef TSCH_CONF_ADAPTIVE_TIMESYNC
 #define TSCH_ADAPTIVE_TIMESYNC TSCH_CONF_ADAPTIVE_TIMESYNC
@@ -73,6 +73,24 @@ MEMB(packet_memb, struct tsch_packet, QUEUEBUF_NUM);
 MEMB(neighbor_memb, struct tsch_neighbor, TSCH_QUEUE_MAX_NEIGHBOR_QUEUES);
 LIST(neighbor_list);
 
+/* Unicast neighbors that may have a packet queued, as a bitmap indexed by
+ * position in neighbor_memb. Bits are set from process context after adding
+ * a packet, and cleared from the slot operation only once the queue is found
+ * empty, so a queued packet always has its bit set. Lets shared links serve
+ * the neighbors in turn without walking the neighbor list. */
+static uint8_t pending_nbrs[(TSCH_QUEUE_MAX_NEIGHBOR_QUEUES + 7) / 8];
+/* Where the next search for a unicast packet on a shared link starts */
+static uint16_t pending_next;
+
+#define NBR_INDEX(n) ((n) - (struct tsch_neighbor *)neighbor_memb.mem)
+#define NBR_FROM_INDEX(i) ((struct tsch_neighbor *)neighbor_memb.mem + (i))
+
+#if TSCH_QUEUE_NUM_PRIORITIES > 1
+#define PACKET_PRIORITY(p) ((p)->priority)
+#else
+#define PACKET_PRIORITY(p) 0
+#endif
+
 /* Broadcast and EB virtual neighbors */
 struct tsch_neighbor *n_broadcast;
 struct tsch_neighbor *n_eb;
@@ -83,6 +101,7 @@ struct tsch_neighbor *
 tsch_queue_add_nbr(const linkaddr_t *addr)
 {
   struct tsch_neighbor *n = NULL;
+  int priority;
   /* If we have an entry for this neighbor already, we simply update it */
   n = tsch_queue_get_nbr(addr);
   if(n == NULL) {
@@ -92,7 +111,9 @@ tsch_queue_add_nbr(const linkaddr_t *addr)
       if(n != NULL) {
         /* Initialize neighbor entry */
         memset(n, 0, sizeof(struct tsch_neighbor));
-        ringbufindex_init(&n->tx_ringbuf, TSCH_QUEUE_NUM_PER_NEIGHBOR);
+        for(priority = 0; priority < TSCH_QUEUE_NUM_PRIORITIES; priority++) {
+          ringbufindex_init(&n->tx_ringbuf[priority], TSCH_QUEUE_NUM_PER_NEIGHBOR);
+        }
         linkaddr_copy(&n->addr, addr);
         n->is_broadcast = linkaddr_cmp(addr, &tsch_eb_address)
           || linkaddr_cmp(addr, &tsch_broadcast_address);
@@ -215,6 +236,7 @@ tsch_queue_remove_nbr(struct tsch_neighbor *n)
 
       /* Remove neighbor from list */
       list_remove(neighbor_list, n);
+      pending_nbrs[NBR_INDEX(n) / 8] &= ~(1 << (NBR_INDEX(n) % 8));
 
       tsch_release_lock();
 
@@ -234,10 +256,15 @@ tsch_queue_add_packet(const linkaddr_t *addr, mac_callback_t sent, void *ptr)
   struct tsch_neighbor *n = NULL;
   int16_t put_index = -1;
   struct tsch_packet *p = NULL;
+  int priority = 0;
+#if TSCH_QUEUE_NUM_PRIORITIES > 1
+  priority = MIN(packetbuf_attr(PACKETBUF_ATTR_TSCH_PRIORITY),
+                 TSCH_QUEUE_NUM_PRIORITIES - 1);
+#endif
   if(!tsch_is_locked()) {
     n = tsch_queue_add_nbr(addr);
     if(n != NULL) {
-      put_index = ringbufindex_peek_put(&n->tx_ringbuf);
+      put_index = ringbufindex_peek_put(&n->tx_ringbuf[priority]);
       if(put_index != -1) {
         p = memb_alloc(&packet_memb);
         if(p != NULL) {
@@ -251,11 +278,18 @@ tsch_queue_add_packet(const linkaddr_t *addr, mac_callback_t sent, void *ptr)
             p->ptr = ptr;
             p->ret = MAC_TX_DEFERRED;
             p->transmissions = 0;
+#if TSCH_QUEUE_NUM_PRIORITIES > 1
+            p->priority = priority;
+#endif
             /* Add to ringbuf (actual add committed through atomic operation) */
-            n->tx_array[put_index] = p;
-            ringbufindex_put(&n->tx_ringbuf);
-            PRINTF("TSCH-queue: packet is added put_index=%u, packet=%p\n",
-                   put_index, p);
+            n->tx_array[priority][put_index] = p;
+            ringbufindex_put(&n->tx_ringbuf[priority]);
+            /* Only now announce the packet to shared links */
+            if(!n->is_broadcast) {
+              pending_nbrs[NBR_INDEX(n) / 8] |= 1 << (NBR_INDEX(n) % 8);
+            }
+            PRINTF("TSCH-queue: packet is added put_index=%u, priority=%u, packet=%p\n",
+                   put_index, priority, p);
             return p;
           } else {
             memb_free(&packet_memb, p);
@@ -273,34 +307,66 @@ int
 tsch_queue_packet_count(const linkaddr_t *addr)
 {
   struct tsch_neighbor *n = NULL;
+  int priority;
+  int count = 0;
   if(!tsch_is_locked()) {
     n = tsch_queue_add_nbr(addr);
     if(n != NULL) {
-      return ringbufindex_elements(&n->tx_ringbuf);
+      for(priority = 0; priority < TSCH_QUEUE_NUM_PRIORITIES; priority++) {
+        count += ringbufindex_elements(&n->tx_ringbuf[priority]);
+      }
+      return count;
     }
   }
   return -1;
 }
 /*---------------------------------------------------------------------------*/
+/* Remove first packet from one traffic class of a neighbor queue */
+static struct tsch_packet *
+remove_packet_from_class(struct tsch_neighbor *n, int priority)
+{
+  /* Get and remove packet from ringbuf (remove committed through an atomic operation */
+  int16_t get_index = ringbufindex_get(&n->tx_ringbuf[priority]);
+  if(get_index != -1) {
+    PRINTF("TSCH-queue: packet is removed, get_index=%u, priority=%u\n",
+           get_index, priority);
+    return n->tx_array[priority][get_index];
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
 /* Remove first packet from a neighbor queue */
 struct tsch_packet *
 tsch_queue_remove_packet_from_queue(struct tsch_neighbor *n)
 {
   if(!tsch_is_locked()) {
     if(n != NULL) {
-      /* Get and remove packet from ringbuf (remove committed through an atomic operation */
-      int16_t get_index = ringbufindex_get(&n->tx_ringbuf);
-      if(get_index != -1) {
-        PRINTF("TSCH-queue: packet is removed, get_index=%u\n", get_index);
-        return n->tx_array[get_index];
-      } else {
-        return NULL;
+      int priority;
+      for(priority = TSCH_QUEUE_NUM_PRIORITIES - 1; priority >= 0; priority--) {
+        struct tsch_packet *p = remove_packet_from_class(n, priority);
+        if(p != NULL) {
+          return p;
+        }
       }
     }
   }
   return NULL;
 }
 /*---------------------------------------------------------------------------*/
+/* Remove a packet returned by tsch_queue_get_packet_for_nbr from its
+ * neighbor queue. The packet is at the head of its traffic class, but a
+ * packet of a higher class may have been queued since. */
+struct tsch_packet *
+tsch_queue_remove_packet(struct tsch_neighbor *n, struct tsch_packet *p)
+{
+  if(!tsch_is_locked()) {
+    if(n != NULL && p != NULL) {
+      return remove_packet_from_class(n, PACKET_PRIORITY(p));
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
 /* Free a packet */
 void
 tsch_queue_free_packet(struct tsch_packet *p)
@@ -353,7 +419,16 @@ tsch_queue_free_unused_neighbors(void)
 int
 tsch_queue_is_empty(const struct tsch_neighbor *n)
 {
-  return !tsch_is_locked() && n != NULL && ringbufindex_empty(&n->tx_ringbuf);
+  int priority;
+  if(tsch_is_locked() || n == NULL) {
+    return 0;
+  }
+  for(priority = 0; priority < TSCH_QUEUE_NUM_PRIORITIES; priority++) {
+    if(!ringbufindex_empty(&n->tx_ringbuf[priority])) {
+      return 0;
+    }
+  }
+  return 1;
 }
 /*---------------------------------------------------------------------------*/
 /* Returns the first packet from a neighbor queue */
@@ -362,22 +437,26 @@ tsch_queue_get_packet_for_nbr(const struct tsch_neighbor *n, struct tsch_link *l
 {
   if(!tsch_is_locked()) {
     int is_shared_link = link != NULL && link->link_options & LINK_OPTION_SHARED;
-    if(n != NULL) {
-      int16_t get_index = ringbufindex_peek_get(&n->tx_ringbuf);
-      if(get_index != -1 &&
-          !(is_shared_link && !tsch_queue_backoff_expired(n))) {    /* If this is a shared link,
-                                                                    make sure the backoff has expired */
+    if(n != NULL && !(is_shared_link && !tsch_queue_backoff_expired(n))) {    /* If this is a shared link,
+                                                                                make sure the backoff has expired */
+      int priority;
+      /* Highest class first. A head packet waiting for another link
+       * does not hold back the classes below it. */
+      for(priority = TSCH_QUEUE_NUM_PRIORITIES - 1; priority >= 0; priority--) {
+        int16_t get_index = ringbufindex_peek_get(&n->tx_ringbuf[priority]);
+        if(get_index != -1) {
 #if TSCH_WITH_LINK_SELECTOR
-        int packet_attr_slotframe = queuebuf_attr(n->tx_array[get_index]->qb, PACKETBUF_ATTR_TSCH_SLOTFRAME);
-        int packet_attr_timeslot = queuebuf_attr(n->tx_array[get_index]->qb, PACKETBUF_ATTR_TSCH_TIMESLOT);
-        if(packet_attr_slotframe != 0xffff && packet_attr_slotframe != link->slotframe_handle) {
-          return NULL;
-        }
-        if(packet_attr_timeslot != 0xffff && packet_attr_timeslot != link->timeslot) {
-          return NULL;
-        }
+          int packet_attr_slotframe = queuebuf_attr(n->tx_array[priority][get_index]->qb, PACKETBUF_ATTR_TSCH_SLOTFRAME);
+          int packet_attr_timeslot = queuebuf_attr(n->tx_array[priority][get_index]->qb, PACKETBUF_ATTR_TSCH_TIMESLOT);
+          if(packet_attr_slotframe != 0xffff && packet_attr_slotframe != link->slotframe_handle) {
+            continue;
+          }
+          if(packet_attr_timeslot != 0xffff && packet_attr_timeslot != link->timeslot) {
+            continue;
+          }
 #endif
-        return n->tx_array[get_index];
+          return n->tx_array[priority][get_index];
+        }
       }
     }
   }
@@ -400,20 +479,38 @@ struct tsch_packet *
 tsch_queue_get_unicast_packet_for_any(struct tsch_neighbor **n, struct tsch_link *link)
 {
   if(!tsch_is_locked()) {
-    struct tsch_neighbor *curr_nbr = list_head(neighbor_list);
-    struct tsch_packet *p = NULL;
-    while(curr_nbr != NULL) {
-      if(!curr_nbr->is_broadcast && curr_nbr->tx_links_count == 0) {
-        /* Only look up for non-broadcast neighbors we do not have a tx link to */
-        p = tsch_queue_get_packet_for_nbr(curr_nbr, link);
-        if(p != NULL) {
-          if(n != NULL) {
-            *n = curr_nbr;
+    /* Walk the pending bitmap round-robin, from after the neighbor served last */
+    uint16_t i = pending_next;
+    uint16_t visited = 0;
+    while(visited < TSCH_QUEUE_MAX_NEIGHBOR_QUEUES) {
+      if(i >= TSCH_QUEUE_MAX_NEIGHBOR_QUEUES) {
+        i = 0;
+      }
+      if((pending_nbrs[i / 8] >> (i % 8)) == 0) {
+        /* No pending neighbor in the rest of this byte, skip to the next one */
+        uint16_t skip = MIN(8 - i % 8, TSCH_QUEUE_MAX_NEIGHBOR_QUEUES - i);
+        i += skip;
+        visited += skip;
+        continue;
+      }
+      if(pending_nbrs[i / 8] & (1 << (i % 8))) {
+        struct tsch_neighbor *curr_nbr = NBR_FROM_INDEX(i);
+        if(tsch_queue_is_empty(curr_nbr)) {
+          pending_nbrs[i / 8] &= ~(1 << (i % 8));
+        } else if(curr_nbr->tx_links_count == 0) {
+          /* Only look up for neighbors we do not have a tx link to */
+          struct tsch_packet *p = tsch_queue_get_packet_for_nbr(curr_nbr, link);
+          if(p != NULL) {
+            pending_next = i + 1;
+            if(n != NULL) {
+              *n = curr_nbr;
+            }
+            return p;
           }
-          return p;
         }
       }
-      curr_nbr = list_item_next(curr_nbr);
+      i++;
+      visited++;
     }
   }
   return NULL;
@@ -474,6 +571,8 @@ tsch_queue_init(void)
   list_init(neighbor_list);
   memb_init(&neighbor_memb);
   memb_init(&packet_memb);
+  memset(pending_nbrs, 0, sizeof(pending_nbrs));
+  pending_next = 0;
   /* Add virtual EB and the broadcast neighbors */
   n_eb = tsch_queue_add_nbr(&tsch_eb_address);
   n_broadcast = tsch_queue_add_nbr(&tsch_broadcast_address);
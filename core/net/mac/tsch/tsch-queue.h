@@ -77,6 +77,13 @@
 #define TSCH_QUEUE_MAX_NEIGHBOR_QUEUES ((NBR_TABLE_CONF_MAX_NEIGHBORS) + 2)
 #endif
 
+/* Traffic classes, set in PACKETBUF_ATTR_TSCH_PRIORITY when
+ * TSCH_QUEUE_NUM_PRIORITIES > 1. Higher classes are sent first, classes
+ * above TSCH_QUEUE_NUM_PRIORITIES - 1 are queued as the highest one.
+ * Data is the default, as attributes are cleared with the packetbuf. */
+#define TSCH_QUEUE_PRIORITY_DATA    0
+#define TSCH_QUEUE_PRIORITY_CONTROL 1
+
 /* TSCH CSMA-CA parameters, see IEEE 802.15.4e-2012 */
 /* Min backoff exponent */
 #ifdef TSCH_CONF_MAC_MIN_BE
@@ -121,6 +128,9 @@ struct tsch_packet {
   uint8_t ret; /* status -- MAC return code */
   uint8_t header_len; /* length of header and header IEs (needed for link-layer security) */
   uint8_t tsch_sync_ie_offset; /* Offset within the frame used for quick update of EB ASN and join priority */
+#if TSCH_QUEUE_NUM_PRIORITIES > 1
+  uint8_t priority; /* traffic class, i.e. which of the neighbor's rings holds the packet */
+#endif
 };
 
 /* TSCH neighbor information */
@@ -135,11 +145,11 @@ struct tsch_neighbor {
   uint8_t last_backoff_window; /* Last CSMA backoff window */
   uint8_t tx_links_count; /* How many links do we have to this neighbor? */
   uint8_t dedicated_tx_links_count; /* How many dedicated links do we have to this neighbor? */
-  /* Array for the ringbuf. Contains pointers to packets.
-   * Its size must be a power of two to allow for atomic put */
-  struct tsch_packet *tx_array[TSCH_QUEUE_NUM_PER_NEIGHBOR];
-  /* Circular buffer of pointers to packet. */
-  struct ringbufindex tx_ringbuf;
+  /* Arrays for the ringbufs, one per traffic class. Contain pointers to
+   * packets. Their size must be a power of two to allow for atomic put */
+  struct tsch_packet *tx_array[TSCH_QUEUE_NUM_PRIORITIES][TSCH_QUEUE_NUM_PER_NEIGHBOR];
+  /* Circular buffers of pointers to packet, one per traffic class. */
+  struct ringbufindex tx_ringbuf[TSCH_QUEUE_NUM_PRIORITIES];
 };
 
 /***** External Variables *****/
@@ -165,6 +175,9 @@ int tsch_queue_packet_count(const linkaddr_t *addr);
 /* Remove first packet from a neighbor queue. The packet is stored in a separate
  * dequeued packet list, for later processing. Return the packet. */
 struct tsch_packet *tsch_queue_remove_packet_from_queue(struct tsch_neighbor *n);
+/* Remove a packet returned by tsch_queue_get_packet_for_nbr from its neighbor
+ * queue, even if a packet of a higher class was queued in the meantime */
+struct tsch_packet *tsch_queue_remove_packet(struct tsch_neighbor *n, struct tsch_packet *p);
 /* Free a packet */
 void tsch_queue_free_packet(struct tsch_packet *p);
 /* Reset neighbor queues */
@@ -178,7 +191,7 @@ struct tsch_packet *tsch_queue_get_packet_for_nbr(const struct tsch_neighbor *n,
 /* Returns the head packet from a neighbor queue (from neighbor address) */
 struct tsch_packet *tsch_queue_get_packet_for_dest_addr(const linkaddr_t *addr, struct tsch_link *link);
 /* Returns the head packet of any neighbor queue with zero backoff counter.
- * Writes pointer to the neighbor in *n */
+ * Neighbors with a packet are served in turn. Writes pointer to the neighbor in *n */
 struct tsch_packet *tsch_queue_get_unicast_packet_for_any(struct tsch_neighbor **n, struct tsch_link *link);
 /* May the neighbor transmit over a share link? */
 int tsch_queue_backoff_expired(const struct tsch_neighbor *n);
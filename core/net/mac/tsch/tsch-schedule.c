@@ -69,6 +69,76 @@ MEMB(slotframe_memb, struct tsch_slotframe, TSCH_SCHEDULE_MAX_SLOTFRAMES);
 /* List of slotframes (each slotframe holds its own list of links) */
 LIST(slotframe_list);
 
+#if TSCH_SCHEDULE_WITH_LINK_INDEX
+/* The links of all slotframes, sorted by timeslot within each slotframe.
+ * Slotframes own consecutive ranges of the index, in the order of
+ * slotframe_list. Links with the same timeslot are kept in the order they
+ * were added, the order in which the links list has them. */
+static struct tsch_link *link_index[TSCH_SCHEDULE_MAX_LINKS];
+static uint16_t link_index_count;
+
+/*---------------------------------------------------------------------------*/
+/* Returns the position, within the slotframe's range of the index, of the
+ * first link with a timeslot larger than the given one */
+static uint16_t
+link_index_search(const struct tsch_slotframe *sf, uint16_t timeslot)
+{
+  struct tsch_link **links = &link_index[sf->index_first];
+  uint16_t low = 0;
+  uint16_t high = sf->index_count;
+
+  while(low < high) {
+    uint16_t mid = (low + high) / 2;
+    if(links[mid]->timeslot <= timeslot) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+/*---------------------------------------------------------------------------*/
+/* Inserts a link in the index. Called with the lock held. */
+static void
+link_index_add(struct tsch_slotframe *sf, struct tsch_link *l)
+{
+  uint16_t pos = sf->index_first + link_index_search(sf, l->timeslot);
+
+  memmove(&link_index[pos + 1], &link_index[pos],
+          (link_index_count - pos) * sizeof(link_index[0]));
+  link_index[pos] = l;
+  link_index_count++;
+  sf->index_count++;
+  /* The ranges of the following slotframes move up by one */
+  for(sf = list_item_next(sf); sf != NULL; sf = list_item_next(sf)) {
+    sf->index_first++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Removes a link from the index. Called with the lock held. */
+static void
+link_index_rm(struct tsch_slotframe *sf, struct tsch_link *l)
+{
+  uint16_t pos = sf->index_first + link_index_search(sf, l->timeslot);
+
+  do {
+    if(pos == sf->index_first || link_index[pos - 1]->timeslot != l->timeslot) {
+      /* Not in the index */
+      return;
+    }
+    pos--;
+  } while(link_index[pos] != l);
+
+  link_index_count--;
+  memmove(&link_index[pos], &link_index[pos + 1],
+          (link_index_count - pos) * sizeof(link_index[0]));
+  sf->index_count--;
+  for(sf = list_item_next(sf); sf != NULL; sf = list_item_next(sf)) {
+    sf->index_first--;
+  }
+}
+#endif /* TSCH_SCHEDULE_WITH_LINK_INDEX */
+
 /* Adds and returns a slotframe (NULL if failure) */
 struct tsch_slotframe *
 tsch_schedule_add_slotframe(uint16_t handle, uint16_t size)
@@ -89,6 +159,12 @@ tsch_schedule_add_slotframe(uint16_t handle, uint16_t size)
       sf->handle = handle;
       TSCH_ASN_DIVISOR_INIT(sf->size, size);
       LIST_STRUCT_INIT(sf, links_list);
+#if TSCH_SCHEDULE_WITH_LINK_INDEX
+      /* The new slotframe goes last in slotframe_list, so its range
+       * starts at the end of the index */
+      sf->index_first = link_index_count;
+      sf->index_count = 0;
+#endif /* TSCH_SCHEDULE_WITH_LINK_INDEX */
       /* Add the slotframe to the global list */
       list_add(slotframe_list, sf);
     }
@@ -209,6 +285,9 @@ tsch_schedule_add_link(struct tsch_slotframe *slotframe,
           address = &linkaddr_null;
         }
         linkaddr_copy(&l->addr, address);
+#if TSCH_SCHEDULE_WITH_LINK_INDEX
+        link_index_add(slotframe, l);
+#endif /* TSCH_SCHEDULE_WITH_LINK_INDEX */
 
         PRINTF("TSCH-schedule: add_link %u %u %u %u %u %u\n",
                slotframe->handle, link_options, link_type, timeslot, channel_offset, TSCH_LOG_ID_FROM_LINKADDR(address));
@@ -256,6 +335,9 @@ tsch_schedule_remove_link(struct tsch_slotframe *slotframe, struct tsch_link *l)
              TSCH_LOG_ID_FROM_LINKADDR(&l->addr));
 
       list_remove(slotframe->links_list, l);
+#if TSCH_SCHEDULE_WITH_LINK_INDEX
+      link_index_rm(slotframe, l);
+#endif /* TSCH_SCHEDULE_WITH_LINK_INDEX */
       memb_free(&link_memb, l);
 
       /* Release the lock before we update the neighbor (will take the lock) */
@@ -294,6 +376,19 @@ tsch_schedule_get_link_by_timeslot(struct tsch_slotframe *slotframe, uint16_t ti
 {
   if(!tsch_is_locked()) {
     if(slotframe != NULL) {
+#if TSCH_SCHEDULE_WITH_LINK_INDEX
+      struct tsch_link **links = &link_index[slotframe->index_first];
+      uint16_t i = link_index_search(slotframe, timeslot);
+      /* Assume there is max one link per timeslot, but return the first
+       * one added if not */
+      if(i == 0 || links[i - 1]->timeslot != timeslot) {
+        return NULL;
+      }
+      while(i > 1 && links[i - 2]->timeslot == timeslot) {
+        i--;
+      }
+      return links[i - 1];
+#else /* TSCH_SCHEDULE_WITH_LINK_INDEX */
       struct tsch_link *l = list_head(slotframe->links_list);
       /* Loop over all items. Assume there is max one link per timeslot */
       while(l != NULL) {
@@ -303,11 +398,58 @@ tsch_schedule_get_link_by_timeslot(struct tsch_slotframe *slotframe, uint16_t ti
         l = list_item_next(l);
       }
       return l;
+#endif /* TSCH_SCHEDULE_WITH_LINK_INDEX */
     }
   }
   return NULL;
 }
 /*---------------------------------------------------------------------------*/
+/* Considers link l, which occurs in time_to_timeslot slots, as the next
+ * active link, and maintains the backup link */
+static void
+select_link(struct tsch_link *l, uint16_t time_to_timeslot,
+            struct tsch_link **curr_best, uint16_t *time_to_curr_best,
+            struct tsch_link **curr_backup)
+{
+  if(*curr_best == NULL || time_to_timeslot < *time_to_curr_best) {
+    *time_to_curr_best = time_to_timeslot;
+    *curr_best = l;
+    *curr_backup = NULL;
+  } else if(time_to_timeslot == *time_to_curr_best) {
+    struct tsch_link *new_best = NULL;
+    /* Two links are overlapping, we need to select one of them.
+     * By standard: prioritize Tx links first, second by lowest handle */
+    if(((*curr_best)->link_options & LINK_OPTION_TX) == (l->link_options & LINK_OPTION_TX)) {
+      /* Both or neither links have Tx, select the one with lowest handle */
+      if(l->slotframe_handle < (*curr_best)->slotframe_handle) {
+        new_best = l;
+      }
+    } else {
+      /* Select the link that has the Tx option */
+      if(l->link_options & LINK_OPTION_TX) {
+        new_best = l;
+      }
+    }
+
+    /* Maintain backup_link */
+    if(*curr_backup == NULL) {
+      /* Check if 'l' best can be used as backup */
+      if(new_best != l && (l->link_options & LINK_OPTION_RX)) { /* Does 'l' have Rx flag? */
+        *curr_backup = l;
+      }
+      /* Check if curr_best can be used as backup */
+      if(new_best != *curr_best && ((*curr_best)->link_options & LINK_OPTION_RX)) { /* Does curr_best have Rx flag? */
+        *curr_backup = *curr_best;
+      }
+    }
+
+    /* Maintain curr_best */
+    if(new_best != NULL) {
+      *curr_best = new_best;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
 /* Returns the next active link after a given ASN, and a backup link (for the same ASN, with Rx flag) */
 struct tsch_link *
 tsch_schedule_get_next_active_link(struct tsch_asn_t *asn, uint16_t *time_offset,
@@ -325,52 +467,39 @@ tsch_schedule_get_next_active_link(struct tsch_asn_t *asn, uint16_t *time_offset
     while(sf != NULL) {
       /* Get timeslot from ASN, given the slotframe length */
       uint16_t timeslot = TSCH_ASN_MOD(*asn, sf->size);
+#if TSCH_SCHEDULE_WITH_LINK_INDEX
+      if(sf->index_count > 0) {
+        struct tsch_link **links = &link_index[sf->index_first];
+        uint16_t i = link_index_search(sf, timeslot);
+        uint16_t next_timeslot;
+        if(i == sf->index_count) {
+          /* No link later in this slotframe, wrap around */
+          i = 0;
+        }
+        /* Only the links at the earliest timeslot of this slotframe can
+         * be selected */
+        next_timeslot = links[i]->timeslot;
+        do {
+          select_link(links[i],
+                      next_timeslot > timeslot ?
+                      next_timeslot - timeslot :
+                      sf->size.val + next_timeslot - timeslot,
+                      &curr_best, &time_to_curr_best, &curr_backup);
+          i++;
+        } while(i < sf->index_count && links[i]->timeslot == next_timeslot);
+      }
+#else /* TSCH_SCHEDULE_WITH_LINK_INDEX */
       struct tsch_link *l = list_head(sf->links_list);
       while(l != NULL) {
         uint16_t time_to_timeslot =
           l->timeslot > timeslot ?
           l->timeslot - timeslot :
           sf->size.val + l->timeslot - timeslot;
-        if(curr_best == NULL || time_to_timeslot < time_to_curr_best) {
-          time_to_curr_best = time_to_timeslot;
-          curr_best = l;
-          curr_backup = NULL;
-        } else if(time_to_timeslot == time_to_curr_best) {
-          struct tsch_link *new_best = NULL;
-          /* Two links are overlapping, we need to select one of them.
-           * By standard: prioritize Tx links first, second by lowest handle */
-          if((curr_best->link_options & LINK_OPTION_TX) == (l->link_options & LINK_OPTION_TX)) {
-            /* Both or neither links have Tx, select the one with lowest handle */
-            if(l->slotframe_handle < curr_best->slotframe_handle) {
-              new_best = l;
-            }
-          } else {
-            /* Select the link that has the Tx option */
-            if(l->link_options & LINK_OPTION_TX) {
-              new_best = l;
-            }
-          }
-
-          /* Maintain backup_link */
-          if(curr_backup == NULL) {
-            /* Check if 'l' best can be used as backup */
-            if(new_best != l && (l->link_options & LINK_OPTION_RX)) { /* Does 'l' have Rx flag? */
-              curr_backup = l;
-            }
-            /* Check if curr_best can be used as backup */
-            if(new_best != curr_best && (curr_best->link_options & LINK_OPTION_RX)) { /* Does curr_best have Rx flag? */
-              curr_backup = curr_best;
-            }
-          }
-
-          /* Maintain curr_best */
-          if(new_best != NULL) {
-            curr_best = new_best;
-          }
-        }
-
+        select_link(l, time_to_timeslot,
+                    &curr_best, &time_to_curr_best, &curr_backup);
         l = list_item_next(l);
       }
+#endif /* TSCH_SCHEDULE_WITH_LINK_INDEX */
       sf = list_item_next(sf);
     }
     if(time_offset != NULL) {
@@ -391,6 +520,9 @@ tsch_schedule_init(void)
     memb_init(&link_memb);
     memb_init(&slotframe_memb);
     list_init(slotframe_list);
+#if TSCH_SCHEDULE_WITH_LINK_INDEX
+    link_index_count = 0;
+#endif /* TSCH_SCHEDULE_WITH_LINK_INDEX */
     tsch_release_lock();
     return 1;
   } else {
@@ -72,6 +72,16 @@
 #define TSCH_SCHEDULE_MAX_LINKS 32
 #endif
 
+/* Keep the links of each slotframe in an array sorted by timeslot, so
+ * that the next active link is found with a binary search per slotframe
+ * instead of a walk over all links. Costs one pointer per link. Off by
+ * default. */
+#ifdef TSCH_SCHEDULE_CONF_WITH_LINK_INDEX
+#define TSCH_SCHEDULE_WITH_LINK_INDEX TSCH_SCHEDULE_CONF_WITH_LINK_INDEX
+#else
+#define TSCH_SCHEDULE_WITH_LINK_INDEX 0
+#endif
+
 /********** Constants *********/
 
 /* Link options */
@@ -122,6 +132,11 @@ struct tsch_slotframe {
   struct tsch_asn_divisor_t size;
   /* List of links belonging to this slotframe */
   LIST_STRUCT(links_list);
+#if TSCH_SCHEDULE_WITH_LINK_INDEX
+  /* Position and number of the links of this slotframe in the link index */
+  uint16_t index_first;
+  uint16_t index_count;
+#endif /* TSCH_SCHEDULE_WITH_LINK_INDEX */
 };
 
 /********** Functions *********/
@@ -51,6 +51,7 @@
 #include "net/mac/tsch/tsch-queue.h"
 #include "net/mac/tsch/tsch-private.h"
 #include "net/mac/tsch/tsch-log.h"
+#include "net/mac/tsch/tsch-slot-trace.h"
 #include "net/mac/tsch/tsch-packet.h"
 #include "net/mac/tsch/tsch-security.h"
 #include "net/mac/tsch/tsch-adaptive-timesync.h"
@@ -117,6 +118,13 @@
 #define RTIMER_GUARD 2u
 #endif
 
+/* The slot operation phase that runs until it is time to transmit */
+#if CCA_ENABLED
+#define PHASE_BEFORE_TX TSCH_SLOT_PHASE_CCA
+#else
+#define PHASE_BEFORE_TX TSCH_SLOT_PHASE_PREPARE
+#endif
+
 enum tsch_radio_state_on_cmd {
   TSCH_RADIO_CMD_ON_START_OF_TIMESLOT,
   TSCH_RADIO_CMD_ON_WITHIN_TIMESLOT,
@@ -281,9 +289,11 @@ check_timer_miss(rtimer_clock_t ref_time, rtimer_clock_t offset, rtimer_clock_t
 /*---------------------------------------------------------------------------*/
 /* Schedule a wakeup at a specified offset from a reference time.
  * Provides basic protection against missed deadlines and timer overflows
- * A return value of zero signals a missed deadline: no rtimer was scheduled. */
+ * A return value of zero signals a missed deadline: no rtimer was scheduled.
+ * The miss is traced against the slot operation phase that ran over. */
 static uint8_t
-tsch_schedule_slot_operation(struct rtimer *tm, rtimer_clock_t ref_time, rtimer_clock_t offset, const char *str)
+tsch_schedule_slot_operation(struct rtimer *tm, rtimer_clock_t ref_time, rtimer_clock_t offset,
+                             enum tsch_slot_phase phase, const char *str)
 {
   rtimer_clock_t now = RTIMER_NOW();
   int r;
@@ -292,6 +302,7 @@ tsch_schedule_slot_operation(struct rtimer *tm, rtimer_clock_t ref_time, rtimer_
   int missed = check_timer_miss(ref_time, offset - RTIMER_GUARD, now);
 
   if(missed) {
+    TSCH_SLOT_TRACE_MISS(phase);
     TSCH_LOG_ADD(tsch_log_message,
                 snprintf(log->message, sizeof(log->message),
                     "!dl-miss %s %d %d",
@@ -311,9 +322,9 @@ tsch_schedule_slot_operation(struct rtimer *tm, rtimer_clock_t ref_time, rtimer_
 /* Schedule slot operation conditionally, and YIELD if success only.
  * Always attempt to schedule RTIMER_GUARD before the target to make sure to wake up
  * ahead of time and then busy wait to exactly hit the target. */
-#define TSCH_SCHEDULE_AND_YIELD(pt, tm, ref_time, offset, str) \
+#define TSCH_SCHEDULE_AND_YIELD(pt, tm, ref_time, offset, phase, str) \
   do { \
-    if(tsch_schedule_slot_operation(tm, ref_time, offset - RTIMER_GUARD, str)) { \
+    if(tsch_schedule_slot_operation(tm, ref_time, offset - RTIMER_GUARD, phase, str)) { \
       PT_YIELD(pt); \
     } \
     BUSYWAIT_UNTIL_ABS(0, ref_time, offset); \
@@ -366,7 +377,7 @@ update_neighbor_state(struct tsch_neighbor *n, struct tsch_packet *p,
 
   if(mac_tx_status == MAC_TX_OK) {
     /* Successful transmission */
-    tsch_queue_remove_packet_from_queue(n);
+    tsch_queue_remove_packet(n, p);
     in_queue = 0;
 
     /* Update CSMA state in the unicast case */
@@ -381,7 +392,7 @@ update_neighbor_state(struct tsch_neighbor *n, struct tsch_packet *p,
     /* Failed transmission */
     if(p->transmissions >= TSCH_MAC_MAX_FRAME_RETRIES + 1) {
       /* Drop packet */
-      tsch_queue_remove_packet_from_queue(n);
+      tsch_queue_remove_packet(n, p);
       in_queue = 0;
     }
     /* Update CSMA state in the unicast case */
@@ -541,16 +552,19 @@ PT_THREAD(tsch_tx_slot(struct pt *pt, struct rtimer *t))
       if(packet_ready && NETSTACK_RADIO.prepare(packet, packet_len) == 0) { /* 0 means success */
         static rtimer_clock_t tx_duration;
 
+        TSCH_SLOT_TRACE_PHASE(TSCH_SLOT_PHASE_PREPARE);
+
 #if CCA_ENABLED
         cca_status = 1;
         /* delay before CCA */
-        TSCH_SCHEDULE_AND_YIELD(pt, t, current_slot_start, TS_CCA_OFFSET, "cca");
+        TSCH_SCHEDULE_AND_YIELD(pt, t, current_slot_start, TS_CCA_OFFSET, TSCH_SLOT_PHASE_PREPARE, "cca");
         TSCH_DEBUG_TX_EVENT();
         tsch_radio_on(TSCH_RADIO_CMD_ON_WITHIN_TIMESLOT);
         /* CCA */
         BUSYWAIT_UNTIL_ABS(!(cca_status |= NETSTACK_RADIO.channel_clear()),
                            current_slot_start, TS_CCA_OFFSET + TS_CCA);
         TSCH_DEBUG_TX_EVENT();
+        TSCH_SLOT_TRACE_PHASE(TSCH_SLOT_PHASE_CCA);
         /* there is not enough time to turn radio off */
         /*  NETSTACK_RADIO.off(); */
         if(cca_status == 0) {
@@ -559,10 +573,12 @@ PT_THREAD(tsch_tx_slot(struct pt *pt, struct rtimer *t))
 #endif /* CCA_ENABLED */
         {
           /* delay before TX */
-          TSCH_SCHEDULE_AND_YIELD(pt, t, current_slot_start, tsch_timing[tsch_ts_tx_offset] - RADIO_DELAY_BEFORE_TX, "TxBeforeTx");
+          TSCH_SCHEDULE_AND_YIELD(pt, t, current_slot_start, tsch_timing[tsch_ts_tx_offset] - RADIO_DELAY_BEFORE_TX,
+                                  PHASE_BEFORE_TX, "TxBeforeTx");
           TSCH_DEBUG_TX_EVENT();
           /* send packet already in radio tx buffer */
           mac_tx_status = NETSTACK_RADIO.transmit(packet_len);
+          TSCH_SLOT_TRACE_PHASE(TSCH_SLOT_PHASE_TX);
           /* Save tx timestamp */
           tx_start_time = current_slot_start + tsch_timing[tsch_ts_tx_offset];
           /* calculate TX duration based on sent packet len */
@@ -590,7 +606,8 @@ PT_THREAD(tsch_tx_slot(struct pt *pt, struct rtimer *t))
 #endif /* TSCH_HW_FRAME_FILTERING */
               /* Unicast: wait for ack after tx: sleep until ack time */
               TSCH_SCHEDULE_AND_YIELD(pt, t, current_slot_start,
-                  tsch_timing[tsch_ts_tx_offset] + tx_duration + tsch_timing[tsch_ts_rx_ack_delay] - RADIO_DELAY_BEFORE_RX, "TxBeforeAck");
+                  tsch_timing[tsch_ts_tx_offset] + tx_duration + tsch_timing[tsch_ts_rx_ack_delay] - RADIO_DELAY_BEFORE_RX,
+                  TSCH_SLOT_PHASE_TX, "TxBeforeAck");
               TSCH_DEBUG_TX_EVENT();
               tsch_radio_on(TSCH_RADIO_CMD_ON_WITHIN_TIMESLOT);
               /* Wait for ACK to come */
@@ -640,6 +657,7 @@ PT_THREAD(tsch_tx_slot(struct pt *pt, struct rtimer *t))
                 }
 #endif /* LLSEC802154_ENABLED */
               }
+              TSCH_SLOT_TRACE_PHASE(TSCH_SLOT_PHASE_ACK);
 
               if(ack_len != 0) {
                 if(is_time_source) {
@@ -682,6 +700,7 @@ PT_THREAD(tsch_tx_slot(struct pt *pt, struct rtimer *t))
 
     current_packet->transmissions++;
     current_packet->ret = mac_tx_status;
+    TSCH_SLOT_TRACE_SET(status, mac_tx_status);
 
     /* Post TX: Update neighbor state */
     in_queue = update_neighbor_state(current_neighbor, current_packet, current_link, mac_tx_status);
@@ -759,7 +778,8 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
     current_input = &input_array[input_index];
 
     /* Wait before starting to listen */
-    TSCH_SCHEDULE_AND_YIELD(pt, t, current_slot_start, tsch_timing[tsch_ts_rx_offset] - RADIO_DELAY_BEFORE_RX, "RxBeforeListen");
+    TSCH_SCHEDULE_AND_YIELD(pt, t, current_slot_start, tsch_timing[tsch_ts_rx_offset] - RADIO_DELAY_BEFORE_RX,
+                            TSCH_SLOT_PHASE_START, "RxBeforeListen");
     TSCH_DEBUG_RX_EVENT();
 
     /* Start radio for at least guard time */
@@ -773,6 +793,7 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
     if(!packet_seen) {
       /* no packets on air */
       tsch_radio_off(TSCH_RADIO_CMD_OFF_FORCE);
+      TSCH_SLOT_TRACE_PHASE(TSCH_SLOT_PHASE_RX);
     } else {
       TSCH_DEBUG_RX_EVENT();
       /* Save packet timestamp */
@@ -828,6 +849,7 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
           frame_valid = 0;
         }
 #endif /* LLSEC802154_ENABLED */
+        TSCH_SLOT_TRACE_PHASE(TSCH_SLOT_PHASE_RX);
 
         if(frame_valid) {
           if(linkaddr_cmp(&destination_address, &linkaddr_node_addr)
@@ -874,9 +896,11 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
 
                 /* Wait for time to ACK and transmit ACK */
                 TSCH_SCHEDULE_AND_YIELD(pt, t, rx_start_time,
-                                        packet_duration + tsch_timing[tsch_ts_tx_ack_delay] - RADIO_DELAY_BEFORE_TX, "RxBeforeAck");
+                                        packet_duration + tsch_timing[tsch_ts_tx_ack_delay] - RADIO_DELAY_BEFORE_TX,
+                                        TSCH_SLOT_PHASE_RX, "RxBeforeAck");
                 TSCH_DEBUG_RX_EVENT();
                 NETSTACK_RADIO.transmit(ack_len);
+                TSCH_SLOT_TRACE_PHASE(TSCH_SLOT_PHASE_RX_ACK);
                 tsch_radio_off(TSCH_RADIO_CMD_OFF_WITHIN_TIMESLOT);
               }
             }
@@ -896,6 +920,7 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
 
             /* Add current input to ringbuf */
             ringbufindex_put(&input_ringbuf);
+            TSCH_SLOT_TRACE_SET(status, 1);
 
             /* Log every reception */
             TSCH_LOG_ADD(tsch_log_rx,
@@ -957,6 +982,7 @@ PT_THREAD(tsch_slot_operation(struct rtimer *t, void *ptr))
     } else {
       int is_active_slot;
       TSCH_DEBUG_SLOT_START();
+      TSCH_SLOT_TRACE_START(&tsch_current_asn, current_slot_start);
       tsch_in_slot_operation = 1;
       /* Reset drift correction */
       drift_correction = 0;
@@ -985,13 +1011,16 @@ PT_THREAD(tsch_slot_operation(struct rtimer *t, void *ptr))
            * 3. post tx callback
            **/
           static struct pt slot_tx_pt;
+          TSCH_SLOT_TRACE_SET(type, TSCH_SLOT_TRACE_TX);
           PT_SPAWN(&slot_operation_pt, &slot_tx_pt, tsch_tx_slot(&slot_tx_pt, t));
         } else {
           /* Listen */
           static struct pt slot_rx_pt;
+          TSCH_SLOT_TRACE_SET(type, TSCH_SLOT_TRACE_RX);
           PT_SPAWN(&slot_operation_pt, &slot_rx_pt, tsch_rx_slot(&slot_rx_pt, t));
         }
       }
+      TSCH_SLOT_TRACE_PHASE(TSCH_SLOT_PHASE_END);
       TSCH_DEBUG_SLOT_END();
     }
 
@@ -1041,9 +1070,11 @@ PT_THREAD(tsch_slot_operation(struct rtimer *t, void *ptr))
         prev_slot_start = current_slot_start;
         current_slot_start += time_to_next_active_slot;
         current_slot_start += tsch_timesync_adaptive_compensate(time_to_next_active_slot);
-      } while(!tsch_schedule_slot_operation(t, prev_slot_start, time_to_next_active_slot, "main"));
+      } while(!tsch_schedule_slot_operation(t, prev_slot_start, time_to_next_active_slot,
+                                            TSCH_SLOT_PHASE_END, "main"));
     }
 
+    TSCH_SLOT_TRACE_END();
     tsch_in_slot_operation = 0;
     PT_YIELD(&slot_operation_pt);
   }
@@ -1060,6 +1091,8 @@ tsch_slot_operation_start(void)
   rtimer_clock_t time_to_next_active_slot;
   rtimer_clock_t prev_slot_start;
   TSCH_DEBUG_INIT();
+  /* Slots go before other real-time tasks due at the same time */
+  RTIMER_SET_PRIORITY(&slot_operation_timer, RTIMER_PRIORITY_HIGH);
   do {
     uint16_t timeslot_diff;
     /* Get next active link */
@@ -1076,7 +1109,8 @@ tsch_slot_operation_start(void)
     /* Update current slot start */
     prev_slot_start = current_slot_start;
     current_slot_start += time_to_next_active_slot;
-  } while(!tsch_schedule_slot_operation(&slot_operation_timer, prev_slot_start, time_to_next_active_slot, "association"));
+  } while(!tsch_schedule_slot_operation(&slot_operation_timer, prev_slot_start, time_to_next_active_slot,
+                                        TSCH_SLOT_PHASE_END, "association"));
 }
 /*---------------------------------------------------------------------------*/
 /* Start actual slot operation */
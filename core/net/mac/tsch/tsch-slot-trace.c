@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         TSCH slot timing trace. Slot operation fills in a trace per slot
+ *         from interrupt context; traces are printed out later from
+ *         tsch_pending_events_process, one line per slot:
+ *           TSCH-trace: r <hex>
+ *         with the ASN (5 bytes), type, status and missed bitmap (1 byte
+ *         each) and the end of each phase (2 bytes each), all big endian.
+ *         Deadline miss counters are printed when they change:
+ *           TSCH-trace: m <count per phase>
+ *         preceded once by the rtimer rate and the number of phases:
+ *           TSCH-trace: h <RTIMER_SECOND> <phases>
+ *         and by the number of slots dropped with the ring full:
+ *           TSCH-trace: d <count>
+ */
+
+#include "contiki.h"
+#include <stdio.h>
+#include "net/mac/tsch/tsch-slot-trace.h"
+#include "lib/ringbufindex.h"
+
+#if TSCH_SLOT_TRACE_LEN
+
+PROCESS_NAME(tsch_pending_events_process);
+
+/* Check if TSCH_SLOT_TRACE_LEN is a power of two */
+#if (TSCH_SLOT_TRACE_LEN & (TSCH_SLOT_TRACE_LEN - 1)) != 0
+#error TSCH_SLOT_TRACE_LEN must be power of two
+#endif
+static struct ringbufindex trace_ringbuf;
+static struct tsch_slot_trace trace_array[TSCH_SLOT_TRACE_LEN];
+static uint16_t trace_dropped;
+#if TSCH_SLOT_TRACE_SAMPLE > 1
+static uint16_t trace_sample;
+#endif /* TSCH_SLOT_TRACE_SAMPLE > 1 */
+/* Deadline misses per phase since startup */
+static uint16_t misses[TSCH_SLOT_PHASE_COUNT];
+static uint8_t misses_changed;
+
+struct tsch_slot_trace *tsch_slot_trace_current;
+rtimer_clock_t tsch_slot_trace_slot_start;
+
+/*---------------------------------------------------------------------------*/
+void
+tsch_slot_trace_start(const struct tsch_asn_t *asn, rtimer_clock_t slot_start)
+{
+  int index = ringbufindex_peek_put(&trace_ringbuf);
+  struct tsch_slot_trace *trace;
+  int i;
+
+  if(index == -1) {
+    trace_dropped++;
+    tsch_slot_trace_current = NULL;
+    return;
+  }
+  trace = &trace_array[index];
+  trace->asn = *asn;
+  trace->type = 0;
+  trace->status = 0;
+  trace->missed = 0;
+  for(i = 0; i < TSCH_SLOT_PHASE_COUNT; i++) {
+    trace->time[i] = TSCH_SLOT_TRACE_NONE;
+  }
+  tsch_slot_trace_slot_start = slot_start;
+  tsch_slot_trace_current = trace;
+  TSCH_SLOT_TRACE_PHASE(TSCH_SLOT_PHASE_START);
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_slot_trace_miss(enum tsch_slot_phase phase)
+{
+  misses[phase]++;
+  misses_changed = 1;
+  if(tsch_slot_trace_current != NULL) {
+    tsch_slot_trace_current->missed |= 1 << phase;
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_slot_trace_end(void)
+{
+  struct tsch_slot_trace *trace = tsch_slot_trace_current;
+
+  if(trace != NULL) {
+    tsch_slot_trace_current = NULL;
+    if(trace->missed == 0) {
+      if(trace->type == 0) {
+        /* Idle slot: leave the entry free for the next slot */
+        return;
+      }
+#if TSCH_SLOT_TRACE_SAMPLE > 1
+      if(++trace_sample < TSCH_SLOT_TRACE_SAMPLE) {
+        /* Not sampled */
+        return;
+      }
+      trace_sample = 0;
+#endif /* TSCH_SLOT_TRACE_SAMPLE > 1 */
+    }
+    ringbufindex_put(&trace_ringbuf);
+    process_poll(&tsch_pending_events_process);
+  } else if(misses_changed) {
+    process_poll(&tsch_pending_events_process);
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_slot_trace_process_pending(void)
+{
+  static uint16_t last_trace_dropped;
+  static uint8_t header_printed;
+  int16_t index;
+  int i;
+
+  if(!header_printed) {
+    printf("TSCH-trace: h %lu %u\n",
+           (unsigned long)RTIMER_SECOND, TSCH_SLOT_PHASE_COUNT);
+    header_printed = 1;
+  }
+  if(trace_dropped != last_trace_dropped) {
+    printf("TSCH-trace: d %u\n", trace_dropped);
+    last_trace_dropped = trace_dropped;
+  }
+  while((index = ringbufindex_peek_get(&trace_ringbuf)) != -1) {
+    struct tsch_slot_trace *trace = &trace_array[index];
+    printf("TSCH-trace: r %02x%08lx%02x%02x%02x",
+           trace->asn.ms1b, (unsigned long)trace->asn.ls4b,
+           trace->type, trace->status, trace->missed);
+    for(i = 0; i < TSCH_SLOT_PHASE_COUNT; i++) {
+      printf("%04x", trace->time[i]);
+    }
+    printf("\n");
+    ringbufindex_get(&trace_ringbuf);
+  }
+  if(misses_changed) {
+    misses_changed = 0;
+    printf("TSCH-trace: m");
+    for(i = 0; i < TSCH_SLOT_PHASE_COUNT; i++) {
+      printf(" %u", misses[i]);
+    }
+    printf("\n");
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_slot_trace_init(void)
+{
+  ringbufindex_init(&trace_ringbuf, TSCH_SLOT_TRACE_LEN);
+}
+
+#endif /* TSCH_SLOT_TRACE_LEN */
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         TSCH slot timing trace. Records, for each slot, the time at
+ *         which each phase of the slot operation completed, in rtimer
+ *         ticks since the start of the slot, in a ring that is printed
+ *         out in hex after leaving interrupt context, and counts deadline
+ *         misses per phase. tools/tsch/tsch-slot-trace.py decodes the
+ *         output into per-phase latency histograms.
+ */
+
+#ifndef __TSCH_SLOT_TRACE_H__
+#define __TSCH_SLOT_TRACE_H__
+
+/********** Includes **********/
+
+#include "contiki.h"
+#include "sys/rtimer.h"
+#include "net/mac/tsch/tsch-asn.h"
+
+/******** Configuration *******/
+
+/* The length of the trace ring. Must be a power of two, at most 128;
+ * the ring holds one slot less. 0 disables tracing. */
+#ifdef TSCH_SLOT_TRACE_CONF_LEN
+#define TSCH_SLOT_TRACE_LEN TSCH_SLOT_TRACE_CONF_LEN
+#else /* TSCH_SLOT_TRACE_CONF_LEN */
+#define TSCH_SLOT_TRACE_LEN 0
+#endif /* TSCH_SLOT_TRACE_CONF_LEN */
+
+/* Keep one slot in TSCH_SLOT_TRACE_SAMPLE in the ring, plus every slot
+ * that missed a deadline. Deadline misses are counted for all slots. */
+#ifdef TSCH_SLOT_TRACE_CONF_SAMPLE
+#define TSCH_SLOT_TRACE_SAMPLE TSCH_SLOT_TRACE_CONF_SAMPLE
+#else /* TSCH_SLOT_TRACE_CONF_SAMPLE */
+#define TSCH_SLOT_TRACE_SAMPLE 1
+#endif /* TSCH_SLOT_TRACE_CONF_SAMPLE */
+
+/********** Constants *********/
+
+/* Slot operation phases. A phase ends with the event in its comment;
+ * a deadline miss is counted against the phase that was running. */
+enum tsch_slot_phase {
+  TSCH_SLOT_PHASE_START,    /* Slot operation running (wake-up latency) */
+  TSCH_SLOT_PHASE_PREPARE,  /* Tx: frame secured and copied to the radio */
+  TSCH_SLOT_PHASE_CCA,      /* Tx: CCA done */
+  TSCH_SLOT_PHASE_TX,       /* Tx: frame transmitted */
+  TSCH_SLOT_PHASE_ACK,      /* Tx: ACK received and checked, or none */
+  TSCH_SLOT_PHASE_RX,       /* Rx: frame received and checked, or none */
+  TSCH_SLOT_PHASE_RX_ACK,   /* Rx: ACK transmitted */
+  TSCH_SLOT_PHASE_END,      /* Slot done, next slot to be scheduled */
+  TSCH_SLOT_PHASE_COUNT
+};
+
+/* Slot types */
+#define TSCH_SLOT_TRACE_TX 1
+#define TSCH_SLOT_TRACE_RX 2
+
+/* Time of a phase that was not reached */
+#define TSCH_SLOT_TRACE_NONE 0xffff
+
+#if TSCH_SLOT_TRACE_LEN
+
+/************ Types ***********/
+
+/* Trace of a slot */
+struct tsch_slot_trace {
+  struct tsch_asn_t asn;
+  /* TSCH_SLOT_TRACE_TX or TSCH_SLOT_TRACE_RX, 0 for an idle slot */
+  uint8_t type;
+  /* Tx: MAC_TX_ status. Rx: 1 if a frame was received */
+  uint8_t status;
+  /* One bit per phase that missed its deadline */
+  uint8_t missed;
+  /* End of each phase, in rtimer ticks since the start of the slot */
+  uint16_t time[TSCH_SLOT_PHASE_COUNT];
+};
+
+/* The trace of the current slot, NULL if not traced */
+extern struct tsch_slot_trace *tsch_slot_trace_current;
+/* The start of the current slot */
+extern rtimer_clock_t tsch_slot_trace_slot_start;
+
+/********** Functions *********/
+
+/* Start tracing a slot */
+void tsch_slot_trace_start(const struct tsch_asn_t *asn, rtimer_clock_t slot_start);
+/* Count a deadline miss against a phase */
+void tsch_slot_trace_miss(enum tsch_slot_phase phase);
+/* Finish tracing the current slot */
+void tsch_slot_trace_end(void);
+/* Initialize the trace module */
+void tsch_slot_trace_init(void);
+/* Print out pending traces */
+void tsch_slot_trace_process_pending(void);
+
+/************ Macros **********/
+
+/* Use these macros in slot operation: they cost a few instructions
+ * when the slot is not traced, and nothing when tracing is disabled */
+#define TSCH_SLOT_TRACE_START(asn, slot_start) \
+  tsch_slot_trace_start((asn), (slot_start))
+#define TSCH_SLOT_TRACE_PHASE(phase) do { \
+    if(tsch_slot_trace_current != NULL) { \
+      tsch_slot_trace_current->time[(phase)] = \
+        (uint16_t)(RTIMER_NOW() - tsch_slot_trace_slot_start); \
+    } \
+} while(0)
+#define TSCH_SLOT_TRACE_SET(field, value) do { \
+    if(tsch_slot_trace_current != NULL) { \
+      tsch_slot_trace_current->field = (value); \
+    } \
+} while(0)
+#define TSCH_SLOT_TRACE_MISS(phase) tsch_slot_trace_miss(phase)
+#define TSCH_SLOT_TRACE_END() tsch_slot_trace_end()
+
+#else /* TSCH_SLOT_TRACE_LEN */
+
+#define tsch_slot_trace_init()
+#define tsch_slot_trace_process_pending()
+#define TSCH_SLOT_TRACE_START(asn, slot_start)
+#define TSCH_SLOT_TRACE_PHASE(phase)
+#define TSCH_SLOT_TRACE_SET(field, value)
+#define TSCH_SLOT_TRACE_MISS(phase)
+#define TSCH_SLOT_TRACE_END()
+
+#endif /* TSCH_SLOT_TRACE_LEN */
+
+#endif /* __TSCH_SLOT_TRACE_H__ */
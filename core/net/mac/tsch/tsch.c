@@ -52,10 +52,15 @@
 #include "net/mac/tsch/tsch-queue.h"
 #include "net/mac/tsch/tsch-private.h"
 #include "net/mac/tsch/tsch-log.h"
+#include "net/mac/tsch/tsch-slot-trace.h"
 #include "net/mac/tsch/tsch-packet.h"
 #include "net/mac/tsch/tsch-security.h"
 #include "net/mac/mac-sequence.h"
 #include "lib/random.h"
+#if NETSTACK_CONF_WITH_IPV6 && TSCH_QUEUE_NUM_PRIORITIES > 1
+#include "net/ip/uip.h"
+#include "net/ipv6/uip-icmp6.h"
+#endif
 
 #if FRAME802154_VERSION < FRAME802154_IEEE802154E_2012
 #error TSCH: FRAME802154_VERSION must be at least FRAME802154_IEEE802154E_2012
@@ -242,6 +247,10 @@ keepalive_send()
     /* Simply send an empty packet */
     packetbuf_clear();
     packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, &n->addr);
+#if TSCH_QUEUE_NUM_PRIORITIES > 1
+    /* Keepalives keep us synchronized, do not queue them behind data */
+    packetbuf_set_attr(PACKETBUF_ATTR_TSCH_PRIORITY, TSCH_QUEUE_PRIORITY_CONTROL);
+#endif
     NETSTACK_LLSEC.send(keepalive_packet_sent, NULL);
     PRINTF("TSCH: sending KA to %u\n",
            TSCH_LOG_ID_FROM_LINKADDR(&n->addr));
@@ -788,6 +797,7 @@ PROCESS_THREAD(tsch_pending_events_process, ev, data)
     tsch_rx_process_pending();
     tsch_tx_process_pending();
     tsch_log_process_pending();
+    tsch_slot_trace_process_pending();
   }
   PROCESS_END();
 }
@@ -849,6 +859,7 @@ tsch_init(void)
   tsch_queue_init();
   tsch_schedule_init();
   tsch_log_init();
+  tsch_slot_trace_init();
   ringbufindex_init(&input_ringbuf, TSCH_MAX_INCOMING_PACKETS);
   ringbufindex_init(&dequeued_ringbuf, TSCH_DEQUEUED_ARRAY_SIZE);
 
@@ -861,6 +872,25 @@ tsch_init(void)
 #endif /* TSCH_AUTOSTART */
 }
 /*---------------------------------------------------------------------------*/
+#if TSCH_QUEUE_NUM_PRIORITIES > 1
+/* Pick the traffic class of an outgoing packet the upper layers left as
+ * data: RPL and IPv6 neighbor discovery messages are control traffic */
+static void
+set_packet_priority(void)
+{
+#if NETSTACK_CONF_WITH_IPV6
+  if(packetbuf_attr(PACKETBUF_ATTR_TSCH_PRIORITY) == TSCH_QUEUE_PRIORITY_DATA
+     && packetbuf_attr(PACKETBUF_ATTR_NETWORK_ID) == UIP_PROTO_ICMP6) {
+    /* sicslowpan sets the ICMPv6 type and code in PACKETBUF_ATTR_CHANNEL */
+    int type = packetbuf_attr(PACKETBUF_ATTR_CHANNEL) >> 8;
+    if(type == ICMP6_RPL || (type >= ICMP6_RS && type <= ICMP6_REDIRECT)) {
+      packetbuf_set_attr(PACKETBUF_ATTR_TSCH_PRIORITY, TSCH_QUEUE_PRIORITY_CONTROL);
+    }
+  }
+#endif /* NETSTACK_CONF_WITH_IPV6 */
+}
+#endif /* TSCH_QUEUE_NUM_PRIORITIES > 1 */
+/*---------------------------------------------------------------------------*/
 /* Function send for TSCH-MAC, puts the packet in packetbuf in the MAC queue */
 static void
 send_packet(mac_callback_t sent, void *ptr)
@@ -899,6 +929,10 @@ send_packet(mac_callback_t sent, void *ptr)
 
   packetbuf_set_attr(PACKETBUF_ATTR_FRAME_TYPE, FRAME802154_DATAFRAME);
 
+#if TSCH_QUEUE_NUM_PRIORITIES > 1
+  set_packet_priority();
+#endif
+
 #if LLSEC802154_ENABLED
   if(tsch_is_pan_secured) {
     /* Set security level, key id and index */
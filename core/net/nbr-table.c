@@ -83,6 +83,23 @@ static unsigned num_tables;
 MEMB(neighbor_addr_mem, nbr_table_key_t, NBR_TABLE_MAX_NEIGHBORS);
 LIST(nbr_table_keys);
 
+#if NBR_TABLE_HASH_SIZE
+#if NBR_TABLE_HASH_SIZE <= NBR_TABLE_MAX_NEIGHBORS || \
+  (NBR_TABLE_HASH_SIZE & (NBR_TABLE_HASH_SIZE - 1)) != 0
+#error NBR_TABLE_CONF_HASH_SIZE must be a power of two larger than NBR_TABLE_CONF_MAX_NEIGHBORS
+#endif
+/* Open-addressing index from link-layer address to neighbor. Each slot
+ * holds the neighbor index plus one, 0 marks an empty slot. Collisions
+ * are resolved with linear probing, and removals shift the following
+ * entries back so that no tombstones are needed. */
+#if NBR_TABLE_MAX_NEIGHBORS < 255
+typedef uint8_t nbr_table_slot_t;
+#else
+typedef uint16_t nbr_table_slot_t;
+#endif
+static nbr_table_slot_t lladdr_index[NBR_TABLE_HASH_SIZE];
+#endif /* NBR_TABLE_HASH_SIZE */
+
 /*---------------------------------------------------------------------------*/
 /* Get a key from a neighbor index */
 static nbr_table_key_t *
@@ -125,17 +142,91 @@ key_from_item(nbr_table_t *table, const nbr_table_item_t *item)
 {
   return key_from_index(index_from_item(table, item));
 }
+#if NBR_TABLE_HASH_SIZE
+/*---------------------------------------------------------------------------*/
+/* Get the first index slot to probe for a link-layer address */
+static unsigned
+slot_from_lladdr(const linkaddr_t *lladdr)
+{
+  uint32_t hash = 2166136261UL;
+  int i;
+
+  /* FNV-1a, as neighbors often differ in the last bytes only */
+  for(i = 0; i < LINKADDR_SIZE; i++) {
+    hash = (hash ^ lladdr->u8[i]) * 16777619UL;
+  }
+  return (hash ^ (hash >> 16)) & (NBR_TABLE_HASH_SIZE - 1);
+}
+/*---------------------------------------------------------------------------*/
+/* Add a key to the link-layer address index */
+static void
+index_add(nbr_table_key_t *key)
+{
+  unsigned slot = slot_from_lladdr(&key->lladdr);
+
+  while(lladdr_index[slot] != 0) {
+    slot = (slot + 1) & (NBR_TABLE_HASH_SIZE - 1);
+  }
+  lladdr_index[slot] = index_from_key(key) + 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Remove a key from the link-layer address index */
+static void
+index_rm(nbr_table_key_t *key)
+{
+  unsigned slot, next, home;
+  nbr_table_slot_t entry = index_from_key(key) + 1;
+
+  slot = slot_from_lladdr(&key->lladdr);
+  while(lladdr_index[slot] != entry) {
+    if(lladdr_index[slot] == 0) {
+      return;
+    }
+    slot = (slot + 1) & (NBR_TABLE_HASH_SIZE - 1);
+  }
+
+  /* Move back entries whose probe sequence passes the freed slot */
+  next = slot;
+  for(;;) {
+    next = (next + 1) & (NBR_TABLE_HASH_SIZE - 1);
+    if(lladdr_index[next] == 0) {
+      break;
+    }
+    home = slot_from_lladdr(&key_from_index(lladdr_index[next] - 1)->lladdr);
+    if(((next - home) & (NBR_TABLE_HASH_SIZE - 1)) >=
+       ((next - slot) & (NBR_TABLE_HASH_SIZE - 1))) {
+      lladdr_index[slot] = lladdr_index[next];
+      slot = next;
+    }
+  }
+  lladdr_index[slot] = 0;
+}
+#endif /* NBR_TABLE_HASH_SIZE */
 /*---------------------------------------------------------------------------*/
 /* Get the index of a neighbor from its link-layer address */
 static int
 index_from_lladdr(const linkaddr_t *lladdr)
 {
+#if NBR_TABLE_HASH_SIZE
+  unsigned slot;
+#else /* NBR_TABLE_HASH_SIZE */
   nbr_table_key_t *key;
+#endif /* NBR_TABLE_HASH_SIZE */
   /* Allow lladdr-free insertion, useful e.g. for IPv6 ND.
    * Only one such entry is possible at a time, indexed by linkaddr_null. */
   if(lladdr == NULL) {
     lladdr = &linkaddr_null;
   }
+#if NBR_TABLE_HASH_SIZE
+  slot = slot_from_lladdr(lladdr);
+  while(lladdr_index[slot] != 0) {
+    if(linkaddr_cmp(lladdr, &key_from_index(lladdr_index[slot] - 1)->lladdr)) {
+      return lladdr_index[slot] - 1;
+    }
+    slot = (slot + 1) & (NBR_TABLE_HASH_SIZE - 1);
+  }
+  return -1;
+#else /* NBR_TABLE_HASH_SIZE */
   key = list_head(nbr_table_keys);
   while(key != NULL) {
     if(lladdr && linkaddr_cmp(lladdr, &key->lladdr)) {
@@ -144,6 +235,7 @@ index_from_lladdr(const linkaddr_t *lladdr)
     key = list_item_next(key);
   }
   return -1;
+#endif /* NBR_TABLE_HASH_SIZE */
 }
 /*---------------------------------------------------------------------------*/
 /* Get bit from "used" or "locked" bitmap */
@@ -195,6 +287,9 @@ remove_key(nbr_table_key_t *least_used_key)
   used_map[index_from_key(least_used_key)] = 0;
   /* Remove neighbor from list */
   list_remove(nbr_table_keys, least_used_key);
+#if NBR_TABLE_HASH_SIZE
+  index_rm(least_used_key);
+#endif /* NBR_TABLE_HASH_SIZE */
 }
 /*---------------------------------------------------------------------------*/
 static nbr_table_key_t *
@@ -359,6 +454,9 @@ nbr_table_add_lladdr(nbr_table_t *table, const linkaddr_t *lladdr, nbr_table_rea
 
     /* Set link-layer address */
     linkaddr_copy(&key->lladdr, lladdr);
+#if NBR_TABLE_HASH_SIZE
+    index_add(key);
+#endif /* NBR_TABLE_HASH_SIZE */
   }
 
   /* Get item in the current table */
@@ -450,7 +548,13 @@ nbr_table_update_lladdr(const linkaddr_t *old_addr, const linkaddr_t *new_addr,
    * Copy the new lladdr into the key - since we know that there is no
    * conflicting entry.
    */
+#if NBR_TABLE_HASH_SIZE
+  index_rm(key);
+#endif /* NBR_TABLE_HASH_SIZE */
   memcpy(&key->lladdr, new_addr, sizeof(linkaddr_t));
+#if NBR_TABLE_HASH_SIZE
+  index_add(key);
+#endif /* NBR_TABLE_HASH_SIZE */
   return 1;
 }
 /*---------------------------------------------------------------------------*/
@@ -56,11 +56,16 @@ struct packetbuf_addr packetbuf_addrs[PACKETBUF_NUM_ADDRS];
 static uint16_t buflen, bufptr;
 static uint8_t hdrlen;
 
+/* Offset of the header in packetbuf. Headers are allocated downwards
+   from PACKETBUF_HDR_SIZE, so that they are prepended without moving
+   the data. */
+static uint16_t hdroff = PACKETBUF_HDR_SIZE;
+
 /* The declarations below ensure that the packet buffer is aligned on
    an even 32-bit boundary. On some platforms (most notably the
    msp430 or OpenRISC), having a potentially misaligned packet buffer may lead to
    problems when accessing words. */
-static uint32_t packetbuf_aligned[(PACKETBUF_SIZE + 3) / 4];
+static uint32_t packetbuf_aligned[(PACKETBUF_HDR_SIZE + PACKETBUF_SIZE + 3) / 4];
 static uint8_t *packetbuf = (uint8_t *)packetbuf_aligned;
 
 #define DEBUG 0
@@ -77,6 +82,7 @@ packetbuf_clear(void)
 {
   buflen = bufptr = 0;
   hdrlen = 0;
+  hdroff = PACKETBUF_HDR_SIZE;
 
   packetbuf_attr_clear();
 }
@@ -88,7 +94,7 @@ packetbuf_copyfrom(const void *from, uint16_t len)
 
   packetbuf_clear();
   l = MIN(PACKETBUF_SIZE, len);
-  memcpy(packetbuf, from, l);
+  memcpy(packetbuf + hdroff, from, l);
   buflen = l;
   return l;
 }
@@ -96,13 +102,11 @@ packetbuf_copyfrom(const void *from, uint16_t len)
 void
 packetbuf_compact(void)
 {
-  int16_t i;
-
   if(bufptr) {
-    /* shift data to the left */
-    for(i = 0; i < buflen; i++) {
-      packetbuf[hdrlen + i] = packetbuf[packetbuf_hdrlen() + i];
-    }
+    /* Close the gap by moving the header, which is the shorter part,
+       towards the data. */
+    memmove(packetbuf + hdroff + bufptr, packetbuf + hdroff, hdrlen);
+    hdroff += bufptr;
     bufptr = 0;
   }
 }
@@ -121,16 +125,17 @@ packetbuf_copyto(void *to)
 int
 packetbuf_hdralloc(int size)
 {
-  int16_t i;
-
   if(size + packetbuf_totlen() > PACKETBUF_SIZE) {
     return 0;
   }
 
-  /* shift data to the right */
-  for(i = packetbuf_totlen() - 1; i >= 0; i--) {
-    packetbuf[i + size] = packetbuf[i];
+  if(size > hdroff) {
+    /* Out of headroom: shift the packet to the right, leaving the
+       header at the start of the buffer. */
+    memmove(packetbuf + size, packetbuf + hdroff, packetbuf_totlen());
+    hdroff = size;
   }
+  hdroff -= size;
   hdrlen += size;
   return 1;
 }
@@ -157,13 +162,13 @@ packetbuf_set_datalen(uint16_t len)
 void *
 packetbuf_dataptr(void)
 {
-  return packetbuf + packetbuf_hdrlen();
+  return packetbuf + hdroff + packetbuf_hdrlen();
 }
 /*---------------------------------------------------------------------------*/
 void *
 packetbuf_hdrptr(void)
 {
-  return packetbuf;
+  return packetbuf + hdroff;
 }
 /*---------------------------------------------------------------------------*/
 uint16_t
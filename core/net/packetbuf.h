@@ -66,6 +66,21 @@
 #define PACKETBUF_SIZE 128
 #endif
 
+/**
+ * \brief      The headroom in front of the packetbuf, in bytes
+ *
+ *             packetbuf_hdralloc() prepends headers into this space
+ *             without moving the packet, and packetbuf_compact() moves
+ *             the header instead of the data. The buffer takes this
+ *             much more RAM. With no headroom left, packetbuf_hdralloc()
+ *             moves the packet as before.
+ */
+#ifdef PACKETBUF_CONF_HDR_SIZE
+#define PACKETBUF_HDR_SIZE PACKETBUF_CONF_HDR_SIZE
+#else
+#define PACKETBUF_HDR_SIZE 0
+#endif
+
 #ifdef PACKETBUF_CONF_WITH_PACKET_TYPE
 #define PACKETBUF_WITH_PACKET_TYPE PACKETBUF_CONF_WITH_PACKET_TYPE
 #else
@@ -248,6 +263,9 @@ enum {
   PACKETBUF_ATTR_TSCH_SLOTFRAME,
   PACKETBUF_ATTR_TSCH_TIMESLOT,
 #endif /* TSCH_WITH_LINK_SELECTOR */
+#if TSCH_QUEUE_NUM_PRIORITIES > 1
+  PACKETBUF_ATTR_TSCH_PRIORITY,
+#endif /* TSCH_QUEUE_NUM_PRIORITIES > 1 */
 
   /* Scope 1 attributes: used between two neighbors only. */
 #if PACKETBUF_WITH_PACKET_TYPE
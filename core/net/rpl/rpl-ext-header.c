@@ -321,6 +321,62 @@ count_matching_bytes(const void *p1, const void *p2, size_t n)
   }
   return n;
 }
+#if RPL_NS_SRH_CACHE_SIZE
+/*---------------------------------------------------------------------------*/
+/* A source route computed for a destination, valid as long as the
+ * topology version of the non-storing node table is unchanged */
+struct srh_cache_entry {
+  const rpl_ns_node_t *dest;
+  uint16_t version;
+  uint8_t path_len;
+  uint8_t cmpr;
+  uip_ipaddr_t next_hop;
+  uint8_t addresses[RPL_NS_SRH_CACHE_MAX_LEN];
+};
+static struct srh_cache_entry srh_cache[RPL_NS_SRH_CACHE_SIZE];
+/*---------------------------------------------------------------------------*/
+static struct srh_cache_entry *
+srh_cache_entry(const rpl_ns_node_t *dest)
+{
+  uint32_t hash = 2166136261UL;
+  int i;
+
+  for(i = 0; i < 8; i++) {
+    hash = (hash ^ dest->link_identifier[i]) * 16777619UL;
+  }
+  return &srh_cache[hash % RPL_NS_SRH_CACHE_SIZE];
+}
+/*---------------------------------------------------------------------------*/
+static struct srh_cache_entry *
+srh_cache_lookup(const rpl_ns_node_t *dest)
+{
+  struct srh_cache_entry *e = srh_cache_entry(dest);
+  if(e->dest == dest && e->version == rpl_ns_topology_version()) {
+    return e;
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+static void
+srh_cache_store(const rpl_ns_node_t *dest, uint8_t path_len, uint8_t cmpr,
+                const uip_ipaddr_t *next_hop, const uint8_t *addresses)
+{
+  struct srh_cache_entry *e = srh_cache_entry(dest);
+  int len = path_len * (16 - cmpr);
+
+  if(len > RPL_NS_SRH_CACHE_MAX_LEN) {
+    return;
+  }
+  e->dest = dest;
+  e->version = rpl_ns_topology_version();
+  e->path_len = path_len;
+  e->cmpr = cmpr;
+  if(next_hop != NULL) {
+    uip_ipaddr_copy(&e->next_hop, next_hop);
+  }
+  memcpy(e->addresses, addresses, len);
+}
+#endif /* RPL_NS_SRH_CACHE_SIZE */
 /*---------------------------------------------------------------------------*/
 static int
 insert_srh_header(void)
@@ -337,6 +393,9 @@ insert_srh_header(void)
   rpl_ns_node_t *node;
   rpl_dag_t *dag;
   uip_ipaddr_t node_addr;
+#if RPL_NS_SRH_CACHE_SIZE
+  struct srh_cache_entry *cached;
+#endif /* RPL_NS_SRH_CACHE_SIZE */
 
   PRINTF("RPL: SRH creating source routing header with destination ");
   PRINT6ADDR(&UIP_IP_BUF->destipaddr);
@@ -364,36 +423,54 @@ insert_srh_header(void)
     return 0;
   }
 
-  if(!rpl_ns_is_node_reachable(dag, &UIP_IP_BUF->destipaddr)) {
-    PRINTF("RPL: SRH no path found to destination\n");
-    return 0;
-  }
-
-  /* Compute path length and compression factors (we use cmpri == cmpre) */
-  path_len = 0;
-  node = dest_node->parent;
-  /* For simplicity, we use cmpri = cmpre */
-  cmpri = 15;
-  cmpre = 15;
+#if RPL_NS_SRH_CACHE_SIZE
+  /* A cached route is known to be loop-free and to reach the root */
+  cached = srh_cache_lookup(dest_node);
+  if(cached != NULL) {
+    path_len = cached->path_len;
+    cmpri = cached->cmpr;
+    cmpre = cmpri;
+    if(path_len == 0) {
+      PRINTF("RPL: SRH no need to insert SRH\n");
+      return 1;
+    }
+  } else
+#endif /* RPL_NS_SRH_CACHE_SIZE */
+  {
+    if(!rpl_ns_is_node_reachable(dag, &UIP_IP_BUF->destipaddr)) {
+      PRINTF("RPL: SRH no path found to destination\n");
+      return 0;
+    }
 
-  if(node == root_node) {
-    PRINTF("RPL: SRH no need to insert SRH\n");
-    return 1;
-  }
+    /* Compute path length and compression factors (we use cmpri == cmpre) */
+    path_len = 0;
+    node = dest_node->parent;
+    /* For simplicity, we use cmpri = cmpre */
+    cmpri = 15;
+    cmpre = 15;
+
+    if(node == root_node) {
+      PRINTF("RPL: SRH no need to insert SRH\n");
+#if RPL_NS_SRH_CACHE_SIZE
+      srh_cache_store(dest_node, 0, cmpri, NULL, NULL);
+#endif /* RPL_NS_SRH_CACHE_SIZE */
+      return 1;
+    }
 
-  while(node != NULL && node != root_node) {
+    while(node != NULL && node != root_node) {
 
-    rpl_ns_get_node_global_addr(&node_addr, node);
+      rpl_ns_get_node_global_addr(&node_addr, node);
 
-    /* How many bytes in common between all nodes in the path? */
-    cmpri = MIN(cmpri, count_matching_bytes(&node_addr, &UIP_IP_BUF->destipaddr, 16));
-    cmpre = cmpri;
+      /* How many bytes in common between all nodes in the path? */
+      cmpri = MIN(cmpri, count_matching_bytes(&node_addr, &UIP_IP_BUF->destipaddr, 16));
+      cmpre = cmpri;
 
-    PRINTF("RPL: SRH Hop ");
-    PRINT6ADDR(&node_addr);
-    PRINTF("\n");
-    node = node->parent;
-    path_len++;
+      PRINTF("RPL: SRH Hop ");
+      PRINT6ADDR(&node_addr);
+      PRINTF("\n");
+      node = node->parent;
+      path_len++;
+    }
   }
 
   /* Extension header length: fixed headers + (n-1) * (16-ComprI) + (16-ComprE)*/
@@ -433,22 +510,35 @@ insert_srh_header(void)
 
   /* Initialize addresses field (the actual source route).
    * From last to first. */
-  node = dest_node;
   hop_ptr = ((uint8_t *)UIP_RH_BUF) + ext_len - padding; /* Pointer where to write the next hop compressed address */
 
-  while(node != NULL && node->parent != root_node) {
-    rpl_ns_get_node_global_addr(&node_addr, node);
+#if RPL_NS_SRH_CACHE_SIZE
+  if(cached != NULL) {
+    hop_ptr -= path_len * (16 - cmpri);
+    memcpy(hop_ptr, cached->addresses, path_len * (16 - cmpri));
+    uip_ipaddr_copy(&UIP_IP_BUF->destipaddr, &cached->next_hop);
+  } else
+#endif /* RPL_NS_SRH_CACHE_SIZE */
+  {
+    node = dest_node;
+    while(node != NULL && node->parent != root_node) {
+      rpl_ns_get_node_global_addr(&node_addr, node);
+
+      hop_ptr -= (16 - cmpri);
+      memcpy(hop_ptr, ((uint8_t*)&node_addr) + cmpri, 16 - cmpri);
+
+      node = node->parent;
+    }
 
-    hop_ptr -= (16 - cmpri);
-    memcpy(hop_ptr, ((uint8_t*)&node_addr) + cmpri, 16 - cmpri);
+    /* The next hop (i.e. node whose parent is the root) is placed as the current IPv6 destination */
+    rpl_ns_get_node_global_addr(&node_addr, node);
+    uip_ipaddr_copy(&UIP_IP_BUF->destipaddr, &node_addr);
 
-    node = node->parent;
+#if RPL_NS_SRH_CACHE_SIZE
+    srh_cache_store(dest_node, path_len, cmpri, &node_addr, hop_ptr);
+#endif /* RPL_NS_SRH_CACHE_SIZE */
   }
 
-  /* The next hop (i.e. node whose parent is the root) is placed as the current IPv6 destination */
-  rpl_ns_get_node_global_addr(&node_addr, node);
-  uip_ipaddr_copy(&UIP_IP_BUF->destipaddr, &node_addr);
-
   /* In-place update of IPv6 length field */
   temp_len = UIP_IP_BUF->len[1];
   UIP_IP_BUF->len[1] += ext_len;
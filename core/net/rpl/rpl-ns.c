@@ -63,6 +63,49 @@ static int num_nodes;
 LIST(nodelist);
 MEMB(nodememb, rpl_ns_node_t, RPL_NS_LINK_NUM);
 
+/* Incremented whenever the path to a node may have changed */
+static uint16_t topology_version;
+
+#if RPL_NS_HASH_SIZE
+/* Nodes hashed by link identifier */
+static rpl_ns_node_t *node_hash[RPL_NS_HASH_SIZE];
+
+/*---------------------------------------------------------------------------*/
+static rpl_ns_node_t **
+hash_bucket(const unsigned char *link_identifier)
+{
+  uint32_t hash = 2166136261UL;
+  int i;
+
+  for(i = 0; i < 8; i++) {
+    hash = (hash ^ link_identifier[i]) * 16777619UL;
+  }
+  return &node_hash[hash % RPL_NS_HASH_SIZE];
+}
+/*---------------------------------------------------------------------------*/
+static void
+hash_add(rpl_ns_node_t *node)
+{
+  rpl_ns_node_t **bucket = hash_bucket(node->link_identifier);
+
+  node->hash_next = *bucket;
+  *bucket = node;
+}
+/*---------------------------------------------------------------------------*/
+static void
+hash_rm(rpl_ns_node_t *node)
+{
+  rpl_ns_node_t **l;
+
+  for(l = hash_bucket(node->link_identifier); *l != NULL; l = &(*l)->hash_next) {
+    if(*l == node) {
+      *l = node->hash_next;
+      return;
+    }
+  }
+}
+#endif /* RPL_NS_HASH_SIZE */
+
 /*---------------------------------------------------------------------------*/
 int
 rpl_ns_num_nodes(void)
@@ -85,7 +128,14 @@ rpl_ns_node_t *
 rpl_ns_get_node(const rpl_dag_t *dag, const uip_ipaddr_t *addr)
 {
   rpl_ns_node_t *l;
+#if RPL_NS_HASH_SIZE
+  if(addr == NULL) {
+    return NULL;
+  }
+  for(l = *hash_bucket(((const unsigned char *)addr) + 8); l != NULL; l = l->hash_next) {
+#else /* RPL_NS_HASH_SIZE */
   for(l = list_head(nodelist); l != NULL; l = list_item_next(l)) {
+#endif /* RPL_NS_HASH_SIZE */
     /* Compare prefix and node identifier */
     if(node_matches_address(dag, l, addr)) {
       return l;
@@ -123,6 +173,7 @@ rpl_ns_update_node(rpl_dag_t *dag, const uip_ipaddr_t *child, const uip_ipaddr_t
   rpl_ns_node_t *child_node = rpl_ns_get_node(dag, child);
   rpl_ns_node_t *parent_node = rpl_ns_get_node(dag, parent);
   rpl_ns_node_t *old_parent_node;
+  rpl_dag_t *old_dag;
 
   if(parent != NULL) {
     /* No node for the parent, add one with infinite lifetime */
@@ -142,18 +193,24 @@ rpl_ns_update_node(rpl_dag_t *dag, const uip_ipaddr_t *child, const uip_ipaddr_t
       return NULL;
     }
     child_node->parent = NULL;
+    child_node->dag = NULL;
+    memcpy(child_node->link_identifier, ((const unsigned char *)child) + 8, 8);
     list_add(nodelist, child_node);
+#if RPL_NS_HASH_SIZE
+    hash_add(child_node);
+#endif /* RPL_NS_HASH_SIZE */
     num_nodes++;
   }
 
+  old_parent_node = child_node->parent;
+  old_dag = child_node->dag;
+
   /* Initialize node */
   child_node->dag = dag;
   child_node->lifetime = lifetime;
-  memcpy(child_node->link_identifier, ((const unsigned char *)child) + 8, 8);
 
   /* Is the node reachable before the update? */
   if(rpl_ns_is_node_reachable(dag, child)) {
-    old_parent_node = child_node->parent;
     /* Update node */
     child_node->parent = parent_node;
     /* Has the node become unreachable? May happen if we create a loop. */
@@ -167,6 +224,10 @@ rpl_ns_update_node(rpl_dag_t *dag, const uip_ipaddr_t *child, const uip_ipaddr_t
     child_node->parent = parent_node;
   }
 
+  if(child_node->parent != old_parent_node || child_node->dag != old_dag) {
+    topology_version++;
+  }
+
   return child_node;
 }
 /*---------------------------------------------------------------------------*/
@@ -176,6 +237,10 @@ rpl_ns_init(void)
   num_nodes = 0;
   memb_init(&nodememb);
   list_init(nodelist);
+#if RPL_NS_HASH_SIZE
+  memset(node_hash, 0, sizeof(node_hash));
+#endif /* RPL_NS_HASH_SIZE */
+  topology_version++;
 }
 /*---------------------------------------------------------------------------*/
 rpl_ns_node_t *
@@ -221,10 +286,20 @@ rpl_ns_periodic(void)
       }
       /* No child found, deallocate node */
       list_remove(nodelist, l);
+#if RPL_NS_HASH_SIZE
+      hash_rm(l);
+#endif /* RPL_NS_HASH_SIZE */
       memb_free(&nodememb, l);
       num_nodes--;
+      topology_version++;
     }
   }
 }
+/*---------------------------------------------------------------------------*/
+uint16_t
+rpl_ns_topology_version(void)
+{
+  return topology_version;
+}
 
 #endif /* RPL_WITH_NON_STORING */
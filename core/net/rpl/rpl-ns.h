@@ -49,8 +49,35 @@
 #define RPL_NS_LINK_NUM 32
 #endif /* RPL_NS_CONF_LINK_NUM */
 
+/* Number of buckets of the hash table used to look nodes up by address.
+ * 0 disables the table and nodes are looked up with a linear search. */
+#ifdef RPL_NS_CONF_HASH_SIZE
+#define RPL_NS_HASH_SIZE RPL_NS_CONF_HASH_SIZE
+#else /* RPL_NS_CONF_HASH_SIZE */
+#define RPL_NS_HASH_SIZE 0
+#endif /* RPL_NS_CONF_HASH_SIZE */
+
+/* Number of source routing headers cached by the root, indexed by
+ * destination. 0 disables the cache. */
+#ifdef RPL_NS_CONF_SRH_CACHE_SIZE
+#define RPL_NS_SRH_CACHE_SIZE RPL_NS_CONF_SRH_CACHE_SIZE
+#else /* RPL_NS_CONF_SRH_CACHE_SIZE */
+#define RPL_NS_SRH_CACHE_SIZE 0
+#endif /* RPL_NS_CONF_SRH_CACHE_SIZE */
+
+/* Maximum size of the compressed addresses of a cached source route.
+ * Longer routes are built for every packet. */
+#ifdef RPL_NS_CONF_SRH_CACHE_MAX_LEN
+#define RPL_NS_SRH_CACHE_MAX_LEN RPL_NS_CONF_SRH_CACHE_MAX_LEN
+#else /* RPL_NS_CONF_SRH_CACHE_MAX_LEN */
+#define RPL_NS_SRH_CACHE_MAX_LEN 64
+#endif /* RPL_NS_CONF_SRH_CACHE_MAX_LEN */
+
 typedef struct rpl_ns_node {
   struct rpl_ns_node *next;
+#if RPL_NS_HASH_SIZE
+  struct rpl_ns_node *hash_next;
+#endif /* RPL_NS_HASH_SIZE */
   uint32_t lifetime;
   rpl_dag_t *dag;
   /* Store only IPv6 link identifiers as all nodes in the DAG share the same prefix */
@@ -68,5 +95,6 @@ rpl_ns_node_t *rpl_ns_get_node(const rpl_dag_t *dag, const uip_ipaddr_t *addr);
 int rpl_ns_is_node_reachable(const rpl_dag_t *dag, const uip_ipaddr_t *addr);
 void rpl_ns_get_node_global_addr(uip_ipaddr_t *addr, rpl_ns_node_t *node);
 void rpl_ns_periodic(void);
+uint16_t rpl_ns_topology_version(void);
 
 #endif /* RPL_NS_H */
@@ -82,6 +82,16 @@
 #define CLOCK_SECOND (clock_time_t)32
 #endif
 
+/**
+ * Wraparound-safe check if clock time \a a is before clock time \a b.
+ * The two times must be less than half the range of clock_time_t
+ * apart.
+ *
+ * \hideinitializer
+ */
+#define CLOCK_TIME_BEFORE(a, b) \
+  ((clock_time_t)((a) - (b)) > ((clock_time_t)~(clock_time_t)0 >> 1))
+
 /**
  * Initialize the clock library.
  *
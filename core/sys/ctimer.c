@@ -46,7 +46,9 @@
 #include "contiki.h"
 #include "lib/list.h"
 
+#if !CTIMER_HEAP
 LIST(ctimer_list);
+#endif /* !CTIMER_HEAP */
 
 static char initialized;
 
@@ -60,6 +62,168 @@ static char initialized;
 
 /*---------------------------------------------------------------------------*/
 PROCESS(ctimer_process, "Ctimer process");
+#if CTIMER_HEAP
+/*---------------------------------------------------------------------------*/
+/*
+ * Pending callback timers are kept in a heap ordered by expiration
+ * time. Their embedded event timers are not registered with the
+ * etimer library: only the timer is used, and the process pointer is
+ * set to the ctimer process while the callback timer is pending. The
+ * ctimer process sets its own event timer to the first expiration.
+ */
+static struct etimer wakeup;
+
+#define heap_ctimer(n) pairing_heap_entry(n, struct ctimer, node)
+/*---------------------------------------------------------------------------*/
+static int
+expires_before(const struct pairing_heap_node *a,
+               const struct pairing_heap_node *b)
+{
+  return CLOCK_TIME_BEFORE(etimer_expiration_time(&heap_ctimer(a)->etimer),
+                           etimer_expiration_time(&heap_ctimer(b)->etimer));
+}
+
+static struct pairing_heap heap = { NULL, expires_before };
+/*---------------------------------------------------------------------------*/
+static void
+update_wakeup(void)
+{
+  struct pairing_heap_node *head;
+  struct timer *t;
+
+  head = pairing_heap_head(&heap);
+  if(!initialized || head == NULL) {
+    return;
+  }
+  t = &heap_ctimer(head)->etimer.timer;
+
+  /* Waking up too early is harmless, so the event timer only needs to
+     be set when the first callback timer expires before it. */
+  if(etimer_expired(&wakeup) ||
+     CLOCK_TIME_BEFORE(t->start + t->interval,
+                       etimer_expiration_time(&wakeup))) {
+    PROCESS_CONTEXT_BEGIN(&ctimer_process);
+    etimer_set(&wakeup, timer_expired(t) ? 0 : timer_remaining(t));
+    PROCESS_CONTEXT_END(&ctimer_process);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+schedule(struct ctimer *c)
+{
+  if(pairing_heap_contains(&heap, &c->node)) {
+    pairing_heap_remove(&heap, &c->node);
+  }
+  c->etimer.p = &ctimer_process;
+  pairing_heap_insert(&heap, &c->node);
+  update_wakeup();
+}
+/*---------------------------------------------------------------------------*/
+static void
+dispatch_expired(void)
+{
+  struct pairing_heap_node *head;
+  struct ctimer *c, *next, *due, **tail;
+
+  /* Take all expired timers off the heap before calling any callback,
+     so that timers set by the callbacks are left for the next pass. */
+  due = NULL;
+  tail = &due;
+  while((head = pairing_heap_head(&heap)) != NULL &&
+        timer_expired(&heap_ctimer(head)->etimer.timer)) {
+    c = heap_ctimer(head);
+    pairing_heap_remove(&heap, head);
+    c->next = NULL;
+    *tail = c;
+    tail = &c->next;
+  }
+
+  for(c = due; c != NULL; c = next) {
+    next = c->next;
+    /* Skip timers that an earlier callback stopped or set again. */
+    if(c->etimer.p == PROCESS_NONE ||
+       pairing_heap_contains(&heap, &c->node)) {
+      continue;
+    }
+    c->etimer.p = PROCESS_NONE;
+    PROCESS_CONTEXT_BEGIN(c->p);
+    if(c->f != NULL) {
+      c->f(c->ptr);
+    }
+    PROCESS_CONTEXT_END(c->p);
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(ctimer_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  initialized = 1;
+  update_wakeup();
+
+  while(1) {
+    PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_TIMER);
+    dispatch_expired();
+    update_wakeup();
+  }
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+void
+ctimer_init(void)
+{
+  initialized = 0;
+  pairing_heap_init(&heap, expires_before);
+  process_start(&ctimer_process, NULL);
+}
+/*---------------------------------------------------------------------------*/
+void
+ctimer_set_with_process(struct ctimer *c, clock_time_t t,
+	   void (*f)(void *), void *ptr, struct process *p)
+{
+  PRINTF("ctimer_set %p %u\n", c, (unsigned)t);
+  c->p = p;
+  c->f = f;
+  c->ptr = ptr;
+  timer_set(&c->etimer.timer, t);
+  schedule(c);
+}
+/*---------------------------------------------------------------------------*/
+void
+ctimer_reset(struct ctimer *c)
+{
+  if(initialized) {
+    timer_reset(&c->etimer.timer);
+  }
+  schedule(c);
+}
+/*---------------------------------------------------------------------------*/
+void
+ctimer_restart(struct ctimer *c)
+{
+  if(initialized) {
+    timer_restart(&c->etimer.timer);
+  }
+  schedule(c);
+}
+/*---------------------------------------------------------------------------*/
+void
+ctimer_stop(struct ctimer *c)
+{
+  if(pairing_heap_contains(&heap, &c->node)) {
+    pairing_heap_remove(&heap, &c->node);
+  }
+  c->etimer.next = NULL;
+  c->etimer.p = PROCESS_NONE;
+}
+/*---------------------------------------------------------------------------*/
+int
+ctimer_expired(struct ctimer *c)
+{
+  return c->etimer.p == PROCESS_NONE;
+}
+#else /* CTIMER_HEAP */
+/*---------------------------------------------------------------------------*/
 PROCESS_THREAD(ctimer_process, ev, data)
 {
   struct ctimer *c;
@@ -96,13 +260,6 @@ ctimer_init(void)
 }
 /*---------------------------------------------------------------------------*/
 void
-ctimer_set(struct ctimer *c, clock_time_t t,
-	   void (*f)(void *), void *ptr)
-{
-  ctimer_set_with_process(c, t, f, ptr, PROCESS_CURRENT());
-}
-/*---------------------------------------------------------------------------*/
-void
 ctimer_set_with_process(struct ctimer *c, clock_time_t t,
 	   void (*f)(void *), void *ptr, struct process *p)
 {
@@ -171,5 +328,13 @@ ctimer_expired(struct ctimer *c)
   }
   return 1;
 }
+#endif /* CTIMER_HEAP */
+/*---------------------------------------------------------------------------*/
+void
+ctimer_set(struct ctimer *c, clock_time_t t,
+	   void (*f)(void *), void *ptr)
+{
+  ctimer_set_with_process(c, t, f, ptr, PROCESS_CURRENT());
+}
 /*---------------------------------------------------------------------------*/
 /** @} */
@@ -56,12 +56,35 @@
 
 #include "sys/etimer.h"
 
+/**
+ * \brief Keep pending callback timers in a heap
+ *
+ * By default, every callback timer is backed by its own event timer
+ * and the ctimer process looks up the expired callback timer on a
+ * list. Setting CTIMER_CONF_HEAP to 1 keeps pending callback timers
+ * in a heap ordered by expiration time instead. The ctimer process
+ * then uses a single event timer set to the first expiration, and
+ * calls all expired callbacks in one pass when it fires.
+ */
+#ifdef CTIMER_CONF_HEAP
+#define CTIMER_HEAP CTIMER_CONF_HEAP
+#else
+#define CTIMER_HEAP 0
+#endif
+
+#if CTIMER_HEAP
+#include "lib/pairing-heap.h"
+#endif /* CTIMER_HEAP */
+
 struct ctimer {
   struct ctimer *next;
   struct etimer etimer;
   struct process *p;
   void (*f)(void *);
   void *ptr;
+#if CTIMER_HEAP
+  struct pairing_heap_node node;
+#endif /* CTIMER_HEAP */
 };
 
 /**
@@ -53,6 +53,104 @@ static struct etimer *timerlist;
 static clock_time_t next_expiration;
 
 PROCESS(etimer_process, "Event timer");
+#if ETIMER_HEAP
+/*---------------------------------------------------------------------------*/
+/*
+ * Pending timers are kept in a heap ordered by expiration time, and
+ * timerlist always points to the first timer to expire.
+ */
+#define heap_timer(n) pairing_heap_entry(n, struct etimer, node)
+/*---------------------------------------------------------------------------*/
+static int
+expires_before(const struct pairing_heap_node *a,
+               const struct pairing_heap_node *b)
+{
+  return CLOCK_TIME_BEFORE(etimer_expiration_time(heap_timer(a)),
+                           etimer_expiration_time(heap_timer(b)));
+}
+
+static struct pairing_heap heap = { NULL, expires_before };
+/*---------------------------------------------------------------------------*/
+static int
+is_pending(struct etimer *et)
+{
+  return pairing_heap_contains(&heap, &et->node);
+}
+/*---------------------------------------------------------------------------*/
+static void
+update_time(void)
+{
+  struct pairing_heap_node *head;
+
+  head = pairing_heap_head(&heap);
+  if(head == NULL) {
+    timerlist = NULL;
+    next_expiration = 0;
+  } else {
+    timerlist = heap_timer(head);
+    next_expiration = etimer_expiration_time(timerlist);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+belongs_to(struct pairing_heap_node *n, void *p)
+{
+  return heap_timer(n)->p == p;
+}
+/*---------------------------------------------------------------------------*/
+static void
+remove_process_timers(struct process *p)
+{
+  pairing_heap_remove_if(&heap, belongs_to, p);
+  update_time();
+}
+/*---------------------------------------------------------------------------*/
+static void
+dispatch_expired(void)
+{
+  struct etimer *t;
+
+  while(timerlist != NULL && timer_expired(&timerlist->timer)) {
+    t = timerlist;
+    if(process_post(t->p, PROCESS_EVENT_TIMER, t) != PROCESS_ERR_OK) {
+      etimer_request_poll();
+      break;
+    }
+    /* Reset the process ID of the event timer, to signal that the
+       etimer has expired. This is later checked in the
+       etimer_expired() function. */
+    t->p = PROCESS_NONE;
+    pairing_heap_remove(&heap, &t->node);
+    update_time();
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+add_timer(struct etimer *timer)
+{
+  etimer_request_poll();
+
+  /* The expiration time may have changed, so a timer that is already
+     pending is reinserted at its new position. */
+  if(is_pending(timer)) {
+    pairing_heap_remove(&heap, &timer->node);
+  }
+
+  timer->p = PROCESS_CURRENT();
+  pairing_heap_insert(&heap, &timer->node);
+
+  update_time();
+}
+/*---------------------------------------------------------------------------*/
+static void
+stop_timer(struct etimer *et)
+{
+  if(is_pending(et)) {
+    pairing_heap_remove(&heap, &et->node);
+    update_time();
+  }
+}
+#else /* ETIMER_HEAP */
 /*---------------------------------------------------------------------------*/
 static void
 update_time(void)
@@ -77,74 +175,57 @@ update_time(void)
   }
 }
 /*---------------------------------------------------------------------------*/
-PROCESS_THREAD(etimer_process, ev, data)
+static void
+remove_process_timers(struct process *p)
 {
-  struct etimer *t, *u;
-	
-  PROCESS_BEGIN();
+  struct etimer *t;
 
-  timerlist = NULL;
-  
-  while(1) {
-    PROCESS_YIELD();
+  while(timerlist != NULL && timerlist->p == p) {
+    timerlist = timerlist->next;
+  }
 
-    if(ev == PROCESS_EVENT_EXITED) {
-      struct process *p = data;
+  if(timerlist != NULL) {
+    t = timerlist;
+    while(t->next != NULL) {
+      if(t->next->p == p) {
+	t->next = t->next->next;
+      } else
+	t = t->next;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+dispatch_expired(void)
+{
+  struct etimer *t, *u;
 
-      while(timerlist != NULL && timerlist->p == p) {
-	timerlist = timerlist->next;
-      }
+ again:
 
-      if(timerlist != NULL) {
-	t = timerlist;
-	while(t->next != NULL) {
-	  if(t->next->p == p) {
-	    t->next = t->next->next;
-	  } else
-	    t = t->next;
-	}
-      }
-      continue;
-    } else if(ev != PROCESS_EVENT_POLL) {
-      continue;
-    }
+  u = NULL;
 
-  again:
-    
-    u = NULL;
-    
-    for(t = timerlist; t != NULL; t = t->next) {
-      if(timer_expired(&t->timer)) {
-	if(process_post(t->p, PROCESS_EVENT_TIMER, t) == PROCESS_ERR_OK) {
-	  
-	  /* Reset the process ID of the event timer, to signal that the
-	     etimer has expired. This is later checked in the
-	     etimer_expired() function. */
-	  t->p = PROCESS_NONE;
-	  if(u != NULL) {
-	    u->next = t->next;
-	  } else {
-	    timerlist = t->next;
-	  }
-	  t->next = NULL;
-	  update_time();
-	  goto again;
+  for(t = timerlist; t != NULL; t = t->next) {
+    if(timer_expired(&t->timer)) {
+      if(process_post(t->p, PROCESS_EVENT_TIMER, t) == PROCESS_ERR_OK) {
+
+	/* Reset the process ID of the event timer, to signal that the
+	   etimer has expired. This is later checked in the
+	   etimer_expired() function. */
+	t->p = PROCESS_NONE;
+	if(u != NULL) {
+	  u->next = t->next;
 	} else {
-	  etimer_request_poll();
+	  timerlist = t->next;
 	}
+	t->next = NULL;
+	update_time();
+	goto again;
+      } else {
+	etimer_request_poll();
       }
-      u = t;
     }
-    
+    u = t;
   }
-  
-  PROCESS_END();
-}
-/*---------------------------------------------------------------------------*/
-void
-etimer_request_poll(void)
-{
-  process_poll(&etimer_process);
 }
 /*---------------------------------------------------------------------------*/
 static void
@@ -173,6 +254,60 @@ add_timer(struct etimer *timer)
   update_time();
 }
 /*---------------------------------------------------------------------------*/
+static void
+stop_timer(struct etimer *et)
+{
+  struct etimer *t;
+
+  /* First check if et is the first event timer on the list. */
+  if(et == timerlist) {
+    timerlist = timerlist->next;
+    update_time();
+  } else {
+    /* Else walk through the list and try to find the item before the
+       et timer. */
+    for(t = timerlist; t != NULL && t->next != et; t = t->next);
+
+    if(t != NULL) {
+      /* We've found the item before the event timer that we are about
+	 to remove. We point the items next pointer to the event after
+	 the removed item. */
+      t->next = et->next;
+
+      update_time();
+    }
+  }
+}
+#endif /* ETIMER_HEAP */
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(etimer_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  timerlist = NULL;
+#if ETIMER_HEAP
+  pairing_heap_init(&heap, expires_before);
+#endif /* ETIMER_HEAP */
+  
+  while(1) {
+    PROCESS_YIELD();
+
+    if(ev == PROCESS_EVENT_EXITED) {
+      remove_process_timers(data);
+    } else if(ev == PROCESS_EVENT_POLL) {
+      dispatch_expired();
+    }
+  }
+  
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+void
+etimer_request_poll(void)
+{
+  process_poll(&etimer_process);
+}
+/*---------------------------------------------------------------------------*/
 void
 etimer_set(struct etimer *et, clock_time_t interval)
 {
@@ -205,7 +340,17 @@ etimer_restart(struct etimer *et)
 void
 etimer_adjust(struct etimer *et, int timediff)
 {
+#if ETIMER_HEAP
+  if(is_pending(et)) {
+    pairing_heap_remove(&heap, &et->node);
+    et->timer.start += timediff;
+    pairing_heap_insert(&heap, &et->node);
+  } else {
+    et->timer.start += timediff;
+  }
+#else /* ETIMER_HEAP */
   et->timer.start += timediff;
+#endif /* ETIMER_HEAP */
   update_time();
 }
 /*---------------------------------------------------------------------------*/
@@ -242,26 +387,7 @@ etimer_next_expiration_time(void)
 void
 etimer_stop(struct etimer *et)
 {
-  struct etimer *t;
-
-  /* First check if et is the first event timer on the list. */
-  if(et == timerlist) {
-    timerlist = timerlist->next;
-    update_time();
-  } else {
-    /* Else walk through the list and try to find the item before the
-       et timer. */
-    for(t = timerlist; t != NULL && t->next != et; t = t->next);
-
-    if(t != NULL) {
-      /* We've found the item before the event timer that we are about
-	 to remove. We point the items next pointer to the event after
-	 the removed item. */
-      t->next = et->next;
-
-      update_time();
-    }
-  }
+  stop_timer(et);
 
   /* Remove the next pointer from the item to be removed. */
   et->next = NULL;
@@ -65,6 +65,28 @@
 #include "sys/timer.h"
 #include "sys/process.h"
 
+/**
+ * \brief Keep pending event timers in a pairing heap
+ *
+ * By default, pending event timers are kept on an unsorted list that
+ * is walked every time the timer process is polled. With a large
+ * number of timers, setting ETIMER_CONF_HEAP to 1 keeps them in a
+ * pairing heap ordered by expiration time instead, giving O(1)
+ * insertion, O(1) lookup of the next expiration and O(log n)
+ * (amortized) removal. The heap uses wraparound-safe comparisons and
+ * therefore requires that no pending timer has an interval longer
+ * than half the range of clock_time_t.
+ */
+#ifdef ETIMER_CONF_HEAP
+#define ETIMER_HEAP ETIMER_CONF_HEAP
+#else
+#define ETIMER_HEAP 0
+#endif
+
+#if ETIMER_HEAP
+#include "lib/pairing-heap.h"
+#endif /* ETIMER_HEAP */
+
 /**
  * A timer.
  *
@@ -77,6 +99,9 @@ struct etimer {
   struct timer timer;
   struct etimer *next;
   struct process *p;
+#if ETIMER_HEAP
+  struct pairing_heap_node node;
+#endif /* ETIMER_HEAP */
 };
 
 /**
@@ -65,15 +65,44 @@ struct event_data {
   struct process *p;
 };
 
-static process_num_events_t nevents, fevent;
-static struct event_data events[PROCESS_CONF_NUMEVENTS];
+/*
+ * Each priority level has its own queue of events.
+ */
+struct event_queue {
+  process_num_events_t nevents, fevent;
+  struct event_data events[PROCESS_CONF_NUMEVENTS];
+};
+
+static struct event_queue queues[PROCESS_PRIORITY_LEVELS];
+static process_num_events_t nevents;
 
 #if PROCESS_CONF_STATS
 process_num_events_t process_maxevents;
+unsigned short process_overflows[PROCESS_PRIORITY_LEVELS];
 #endif
 
 static volatile unsigned char poll_requested;
 
+/*
+ * One flag per priority level, set when a process of that level has
+ * been polled. The flags are only ever written as a whole, so that
+ * process_poll() may be called from interrupts.
+ */
+static volatile unsigned char poll_levels[PROCESS_PRIORITY_LEVELS];
+
+#if PROCESS_PRIORITY_LEVELS > 1
+/*
+ * The process list is kept sorted by decreasing priority, and
+ * level_head points to the first process of each level.
+ */
+static struct process *level_head[PROCESS_PRIORITY_LEVELS];
+#define PRIORITY(p) ((p)->priority)
+#define LEVEL_HEAD(l) level_head[l]
+#else /* PROCESS_PRIORITY_LEVELS > 1 */
+#define PRIORITY(p) PROCESS_PRIORITY_NORMAL
+#define LEVEL_HEAD(l) process_list
+#endif /* PROCESS_PRIORITY_LEVELS > 1 */
+
 #define PROCESS_STATE_NONE        0
 #define PROCESS_STATE_RUNNING     1
 #define PROCESS_STATE_CALLED      2
@@ -95,6 +124,46 @@ process_alloc_event(void)
   return lastevent++;
 }
 /*---------------------------------------------------------------------------*/
+static void
+link_process(struct process *p)
+{
+  struct process **pp;
+
+  /* Put the process first among the processes of its priority. */
+  for(pp = &process_list; *pp != NULL && PRIORITY(*pp) > PRIORITY(p);
+      pp = &(*pp)->next);
+  p->next = *pp;
+  *pp = p;
+#if PROCESS_PRIORITY_LEVELS > 1
+  level_head[PRIORITY(p)] = p;
+#endif /* PROCESS_PRIORITY_LEVELS > 1 */
+}
+/*---------------------------------------------------------------------------*/
+static void
+unlink_process(struct process *p)
+{
+  struct process *q;
+
+  /* The next pointer of p is left intact, so that a loop over the
+     process list that is currently at p can continue. */
+  if(p == process_list) {
+    process_list = process_list->next;
+  } else {
+    for(q = process_list; q != NULL; q = q->next) {
+      if(q->next == p) {
+	q->next = p->next;
+	break;
+      }
+    }
+  }
+#if PROCESS_PRIORITY_LEVELS > 1
+  if(level_head[PRIORITY(p)] == p) {
+    level_head[PRIORITY(p)] =
+      p->next != NULL && PRIORITY(p->next) == PRIORITY(p) ? p->next : NULL;
+  }
+#endif /* PROCESS_PRIORITY_LEVELS > 1 */
+}
+/*---------------------------------------------------------------------------*/
 void
 process_start(struct process *p, process_data_t data)
 {
@@ -109,8 +178,7 @@ process_start(struct process *p, process_data_t data)
     return;
   }
   /* Put on the procs list.*/
-  p->next = process_list;
-  process_list = p;
+  link_process(p);
   p->state = PROCESS_STATE_RUNNING;
   PT_INIT(&p->pt);
 
@@ -157,16 +225,7 @@ exit_process(struct process *p, struct process *fromprocess)
     }
   }
 
-  if(p == process_list) {
-    process_list = process_list->next;
-  } else {
-    for(q = process_list; q != NULL; q = q->next) {
-      if(q->next == p) {
-	q->next = p->next;
-	break;
-      }
-    }
-  }
+  unlink_process(p);
 
   process_current = old_current;
 }
@@ -205,11 +264,48 @@ process_exit(struct process *p)
 }
 /*---------------------------------------------------------------------------*/
 void
+process_set_priority(struct process *p, unsigned char priority)
+{
+#if PROCESS_PRIORITY_LEVELS > 1
+  struct process *q;
+
+  if(priority > PROCESS_PRIORITY_HIGH) {
+    priority = PROCESS_PRIORITY_HIGH;
+  }
+
+  for(q = process_list; q != p && q != NULL; q = q->next);
+  if(q == p) {
+    /* Move the process to its new place in the process list. */
+    unlink_process(p);
+    p->priority = priority;
+    link_process(p);
+    if(p->needspoll) {
+      poll_levels[priority] = 1;
+      poll_requested = 1;
+    }
+  } else {
+    p->priority = priority;
+  }
+#endif /* PROCESS_PRIORITY_LEVELS > 1 */
+}
+/*---------------------------------------------------------------------------*/
+void
 process_init(void)
 {
+  int i;
+
   lastevent = PROCESS_EVENT_MAX;
 
-  nevents = fevent = 0;
+  nevents = 0;
+  for(i = 0; i < PROCESS_PRIORITY_LEVELS; i++) {
+    queues[i].nevents = queues[i].fevent = 0;
+#if PROCESS_PRIORITY_LEVELS > 1
+    level_head[i] = NULL;
+#endif /* PROCESS_PRIORITY_LEVELS > 1 */
+#if PROCESS_CONF_STATS
+    process_overflows[i] = 0;
+#endif /* PROCESS_CONF_STATS */
+  }
 #if PROCESS_CONF_STATS
   process_maxevents = 0;
 #endif /* PROCESS_CONF_STATS */
@@ -225,14 +321,22 @@ static void
 do_poll(void)
 {
   struct process *p;
+  int level;
 
   poll_requested = 0;
-  /* Call the processes that needs to be polled. */
-  for(p = process_list; p != NULL; p = p->next) {
-    if(p->needspoll) {
-      p->state = PROCESS_STATE_RUNNING;
-      p->needspoll = 0;
-      call_process(p, PROCESS_EVENT_POLL, NULL);
+  /* Call the processes that needs to be polled, visiting only the
+     priority levels that have a pending poll. */
+  for(level = PROCESS_PRIORITY_LEVELS - 1; level >= 0; level--) {
+    if(poll_levels[level]) {
+      poll_levels[level] = 0;
+      for(p = LEVEL_HEAD(level); p != NULL && PRIORITY(p) == level;
+	  p = p->next) {
+	if(p->needspoll) {
+	  p->state = PROCESS_STATE_RUNNING;
+	  p->needspoll = 0;
+	  call_process(p, PROCESS_EVENT_POLL, NULL);
+	}
+      }
     }
   }
 }
@@ -249,26 +353,34 @@ do_event(void)
   process_data_t data;
   struct process *receiver;
   struct process *p;
+  struct event_queue *q;
+  int level;
   
   /*
    * If there are any events in the queue, take the first one and walk
    * through the list of processes to see if the event should be
    * delivered to any of them. If so, we call the event handler
    * function for the process. We only process one event at a time and
-   * call the poll handlers inbetween.
+   * call the poll handlers inbetween. Events are taken from the
+   * queue of the highest priority level that has any.
    */
 
   if(nevents > 0) {
+
+    for(level = PROCESS_PRIORITY_LEVELS - 1;
+	level > 0 && queues[level].nevents == 0; level--);
+    q = &queues[level];
     
     /* There are events that we should deliver. */
-    ev = events[fevent].ev;
+    ev = q->events[q->fevent].ev;
     
-    data = events[fevent].data;
-    receiver = events[fevent].p;
+    data = q->events[q->fevent].data;
+    receiver = q->events[q->fevent].p;
 
     /* Since we have seen the new event, we move pointer upwards
        and decrease the number of events. */
-    fevent = (fevent + 1) % PROCESS_CONF_NUMEVENTS;
+    q->fevent = (q->fevent + 1) % PROCESS_CONF_NUMEVENTS;
+    --q->nevents;
     --nevents;
 
     /* If this is a broadcast event, we deliver it to all events, in
@@ -322,6 +434,8 @@ int
 process_post(struct process *p, process_event_t ev, process_data_t data)
 {
   process_num_events_t snum;
+  struct event_queue *q;
+  int level;
 
   if(PROCESS_CURRENT() == NULL) {
     PRINTF("process_post: NULL process posts event %d to process '%s', nevents %d\n",
@@ -332,7 +446,13 @@ process_post(struct process *p, process_event_t ev, process_data_t data)
 	   p == PROCESS_BROADCAST? "<broadcast>": PROCESS_NAME_STRING(p), nevents);
   }
   
-  if(nevents == PROCESS_CONF_NUMEVENTS) {
+  level = p == PROCESS_BROADCAST ? PROCESS_PRIORITY_NORMAL : PRIORITY(p);
+  q = &queues[level];
+
+  if(q->nevents == PROCESS_CONF_NUMEVENTS) {
+#if PROCESS_CONF_STATS
+    process_overflows[level]++;
+#endif /* PROCESS_CONF_STATS */
 #if DEBUG
     if(p == PROCESS_BROADCAST) {
       printf("soft panic: event queue is full when broadcast event %d was posted from %s\n", ev, PROCESS_NAME_STRING(process_current));
@@ -343,10 +463,11 @@ process_post(struct process *p, process_event_t ev, process_data_t data)
     return PROCESS_ERR_FULL;
   }
   
-  snum = (process_num_events_t)(fevent + nevents) % PROCESS_CONF_NUMEVENTS;
-  events[snum].ev = ev;
-  events[snum].data = data;
-  events[snum].p = p;
+  snum = (process_num_events_t)(q->fevent + q->nevents) % PROCESS_CONF_NUMEVENTS;
+  q->events[snum].ev = ev;
+  q->events[snum].data = data;
+  q->events[snum].p = p;
+  ++q->nevents;
   ++nevents;
 
 #if PROCESS_CONF_STATS
@@ -374,6 +495,7 @@ process_poll(struct process *p)
     if(p->state == PROCESS_STATE_RUNNING ||
        p->state == PROCESS_STATE_CALLED) {
       p->needspoll = 1;
+      poll_levels[PRIORITY(p)] = 1;
       poll_requested = 1;
     }
   }
@@ -88,6 +88,27 @@ typedef unsigned char process_num_events_t;
 #define PROCESS_CONF_NUMEVENTS 32
 #endif /* PROCESS_CONF_NUMEVENTS */
 
+/**
+ * \brief Number of process priority levels
+ *
+ * With more than one level, events and polls for processes with a
+ * higher priority are handled before those for processes with a lower
+ * priority. Each level has its own event queue of
+ * PROCESS_CONF_NUMEVENTS entries, and polls are tracked per level so
+ * that only the processes of a level with a pending poll are
+ * visited. Processes run at PROCESS_PRIORITY_NORMAL unless raised
+ * with process_set_priority(). Broadcast events are queued at
+ * PROCESS_PRIORITY_NORMAL.
+ */
+#ifdef PROCESS_CONF_PRIORITY_LEVELS
+#define PROCESS_PRIORITY_LEVELS PROCESS_CONF_PRIORITY_LEVELS
+#else
+#define PROCESS_PRIORITY_LEVELS 1
+#endif /* PROCESS_CONF_PRIORITY_LEVELS */
+
+#define PROCESS_PRIORITY_NORMAL 0
+#define PROCESS_PRIORITY_HIGH   (PROCESS_PRIORITY_LEVELS - 1)
+
 #define PROCESS_EVENT_NONE            0x80
 #define PROCESS_EVENT_INIT            0x81
 #define PROCESS_EVENT_POLL            0x82
@@ -323,6 +344,9 @@ struct process {
   PT_THREAD((* thread)(struct pt *, process_event_t, process_data_t));
   struct pt pt;
   unsigned char state, needspoll;
+#if PROCESS_PRIORITY_LEVELS > 1
+  unsigned char priority;
+#endif /* PROCESS_PRIORITY_LEVELS > 1 */
 };
 
 /**
@@ -389,6 +413,20 @@ CCIF void process_post_synch(struct process *p,
  */
 CCIF void process_exit(struct process *p);
 
+/**
+ * \brief      Set the priority of a process
+ * \param p    The process
+ * \param priority The priority, from PROCESS_PRIORITY_NORMAL up to
+ *             PROCESS_PRIORITY_HIGH
+ *
+ *             This function sets the priority with which events and
+ *             polls for the process are handled. Events that are
+ *             already queued for the process keep their priority. The
+ *             function has no effect unless PROCESS_CONF_PRIORITY_LEVELS
+ *             is larger than one.
+ */
+void process_set_priority(struct process *p, unsigned char priority);
+
 
 /**
  * Get a pointer to the currently running process.
@@ -519,6 +557,20 @@ CCIF int process_is_running(struct process *p);
  */
 int process_nevents(void);
 
+#if PROCESS_CONF_STATS
+/**
+ * The largest number of events that have been waiting in the event
+ * queues at the same time.
+ */
+extern process_num_events_t process_maxevents;
+
+/**
+ * The number of events per priority level that could not be posted
+ * because the event queue of the level was full.
+ */
+extern unsigned short process_overflows[PROCESS_PRIORITY_LEVELS];
+#endif /* PROCESS_CONF_STATS */
+
 /** @} */
 
 CCIF extern struct process *process_list;
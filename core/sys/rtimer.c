@@ -54,6 +54,108 @@
 #define PRINTF(...)
 #endif
 
+#if RTIMER_MULTIPLE_TASKS
+/* Mask the rtimer interrupt, so that the queue is not changed under
+   the feet of rtimer_run_next(). */
+#define RTIMER_LOCK() RTIMER_CONF_LOCK()
+#define RTIMER_UNLOCK() RTIMER_CONF_UNLOCK()
+
+/* Pending tasks, sorted by deadline and, for equal deadlines, by
+   decreasing priority. The ordering uses RTIMER_CLOCK_LT() and is
+   therefore correct across clock wraparound as long as all pending
+   deadlines lie within half the clock range of each other. */
+static struct rtimer *rtimer_queue;
+/* Set while rtimer_run_next() executes tasks: the hardware timer is
+   programmed once all due tasks have run. */
+static uint8_t running;
+
+/*---------------------------------------------------------------------------*/
+static void
+queue_remove(struct rtimer *rtimer)
+{
+  struct rtimer **tp;
+
+  for(tp = &rtimer_queue; *tp != NULL; tp = &(*tp)->next) {
+    if(*tp == rtimer) {
+      *tp = rtimer->next;
+      return;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+queue_insert(struct rtimer *rtimer)
+{
+  struct rtimer **tp;
+
+  for(tp = &rtimer_queue; *tp != NULL; tp = &(*tp)->next) {
+    if(RTIMER_CLOCK_LT(rtimer->time, (*tp)->time) ||
+       ((*tp)->time == rtimer->time && rtimer->priority > (*tp)->priority)) {
+      break;
+    }
+  }
+  rtimer->next = *tp;
+  *tp = rtimer;
+}
+/*---------------------------------------------------------------------------*/
+void
+rtimer_init(void)
+{
+  rtimer_queue = NULL;
+  running = 0;
+  rtimer_arch_init();
+}
+/*---------------------------------------------------------------------------*/
+int
+rtimer_set(struct rtimer *rtimer, rtimer_clock_t time,
+	   rtimer_clock_t duration,
+	   rtimer_callback_t func, void *ptr)
+{
+  PRINTF("rtimer_set time %d\n", time);
+
+  if(!running) {
+    RTIMER_LOCK();
+  }
+
+  /* Setting a task that is already pending moves it to its new time. */
+  queue_remove(rtimer);
+
+  rtimer->func = func;
+  rtimer->ptr = ptr;
+  rtimer->time = time;
+  queue_insert(rtimer);
+
+  if(!running) {
+    if(rtimer_queue == rtimer) {
+      rtimer_arch_schedule(time);
+    }
+    RTIMER_UNLOCK();
+  }
+  return RTIMER_OK;
+}
+/*---------------------------------------------------------------------------*/
+void
+rtimer_run_next(void)
+{
+  struct rtimer *t;
+
+  running = 1;
+  while((t = rtimer_queue) != NULL) {
+    if(RTIMER_CLOCK_LT(RTIMER_NOW() + RTIMER_GUARD_TIME, t->time)) {
+      /* Far enough in the future for the hardware timer. */
+      rtimer_arch_schedule(t->time);
+      break;
+    }
+    /* Due, or too close to program the hardware timer for it: run it
+       now rather than risk missing the compare match. */
+    rtimer_queue = t->next;
+    t->func(t, t->ptr);
+  }
+  running = 0;
+}
+/*---------------------------------------------------------------------------*/
+#else /* RTIMER_MULTIPLE_TASKS */
+
 static struct rtimer *next_rtimer;
 
 /*---------------------------------------------------------------------------*/
@@ -104,5 +206,6 @@ rtimer_run_next(void)
   return;
 }
 /*---------------------------------------------------------------------------*/
+#endif /* RTIMER_MULTIPLE_TASKS */
 
 /** @}*/
@@ -64,6 +64,23 @@ typedef unsigned short rtimer_clock_t;
 
 #include "rtimer-arch.h"
 
+/* Keep any number of tasks pending instead of only the last one set.
+   The queue is changed both by rtimer_set() and by rtimer_run_next()
+   in the rtimer interrupt, so it needs RTIMER_CONF_LOCK() and
+   RTIMER_CONF_UNLOCK() to mask that interrupt; it is on by default
+   only on platforms whose rtimer-arch.h provides them. */
+#ifdef RTIMER_CONF_MULTIPLE_TASKS
+#define RTIMER_MULTIPLE_TASKS RTIMER_CONF_MULTIPLE_TASKS
+#elif defined(RTIMER_CONF_LOCK)
+#define RTIMER_MULTIPLE_TASKS 1
+#else
+#define RTIMER_MULTIPLE_TASKS 0
+#endif
+
+#if RTIMER_MULTIPLE_TASKS && !defined(RTIMER_CONF_LOCK)
+#error "RTIMER_CONF_MULTIPLE_TASKS needs RTIMER_CONF_LOCK() and RTIMER_CONF_UNLOCK()"
+#endif
+
 /**
  * \brief      Initialize the real-time scheduler.
  *
@@ -82,13 +99,26 @@ typedef void (* rtimer_callback_t)(struct rtimer *t, void *ptr);
  *             This structure represents a real-time task and is used
  *             by the real-time module and the architecture specific
  *             support module for the real-time module.
+ *
+ *             With RTIMER_MULTIPLE_TASKS, any number of tasks can be
+ *             pending at the same time, and tasks due at the same
+ *             time run in order of decreasing priority, then in the
+ *             order they were set. Otherwise only the task set last
+ *             is pending.
  */
 struct rtimer {
+  struct rtimer *next;
   rtimer_clock_t time;
   rtimer_callback_t func;
   void *ptr;
+  unsigned char priority;
 };
 
+/** Priority of tasks that do not set one */
+#define RTIMER_PRIORITY_DEFAULT 0
+/** Priority for tasks with hard timing constraints, such as MAC slots */
+#define RTIMER_PRIORITY_HIGH    1
+
 enum {
   RTIMER_OK,
   RTIMER_ERR_FULL,
@@ -103,11 +133,13 @@ enum {
  * \param duration Unused argument.
  * \param func A function to be called when the task is executed.
  * \param ptr An opaque pointer that will be supplied as an argument to the callback function.
- * \return     Non-zero (true) if the task could be scheduled, zero
- *             (false) if the task could not be scheduled.
+ * \return     RTIMER_OK if the task was scheduled.
  *
  *             This function schedules a real-time task at a specified
- *             time in the future.
+ *             time in the future. With RTIMER_MULTIPLE_TASKS, other
+ *             pending tasks are not affected and setting a task that
+ *             is already pending moves it to the new time; otherwise
+ *             the task replaces the one pending.
  *
  */
 int rtimer_set(struct rtimer *task, rtimer_clock_t time,
@@ -147,6 +179,19 @@ void rtimer_run_next(void);
  */
 #define RTIMER_TIME(task) ((task)->time)
 
+/**
+ * \brief      Set the priority of a task
+ * \param task The task
+ * \param prio The priority, e.g. RTIMER_PRIORITY_HIGH
+ *
+ *             The priority only decides the order of tasks that are
+ *             due at the same time; it must be set before the task
+ *             is posted with rtimer_set().
+ *
+ * \hideinitializer
+ */
+#define RTIMER_SET_PRIORITY(task, prio) ((task)->priority = (prio))
+
 void rtimer_arch_init(void);
 void rtimer_arch_schedule(rtimer_clock_t t);
 /*rtimer_clock_t rtimer_arch_now(void);*/
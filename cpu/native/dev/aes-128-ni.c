@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         AES-128 driver using the x86 AES-NI instructions.
+ *
+ *         The CPU is checked for AES-NI when the key is set. Without
+ *         it, or when not built for x86 with GCC or Clang, the driver
+ *         falls back to aes_128_ttable_driver.
+ */
+
+#include "dev/aes-128-ni.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+#include <wmmintrin.h>
+
+#define AES_NI __attribute__((target("aes,sse2")))
+
+static __m128i round_keys[11];
+static uint8_t have_aes_ni;
+
+/*---------------------------------------------------------------------------*/
+AES_NI static __m128i
+expand(__m128i key, __m128i assist)
+{
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  return _mm_xor_si128(key, _mm_shuffle_epi32(assist, 0xff));
+}
+/*---------------------------------------------------------------------------*/
+/* The round constant of aeskeygenassist must be an immediate */
+#define EXPAND(i, rcon) \
+  round_keys[i] = expand(round_keys[i - 1], \
+                         _mm_aeskeygenassist_si128(round_keys[i - 1], rcon))
+
+AES_NI static void
+set_key_ni(const uint8_t *key)
+{
+  round_keys[0] = _mm_loadu_si128((const __m128i *)key);
+  EXPAND(1, 0x01);
+  EXPAND(2, 0x02);
+  EXPAND(3, 0x04);
+  EXPAND(4, 0x08);
+  EXPAND(5, 0x10);
+  EXPAND(6, 0x20);
+  EXPAND(7, 0x40);
+  EXPAND(8, 0x80);
+  EXPAND(9, 0x1b);
+  EXPAND(10, 0x36);
+}
+/*---------------------------------------------------------------------------*/
+AES_NI static void
+encrypt_ni(uint8_t *state)
+{
+  __m128i s;
+  int round;
+
+  s = _mm_xor_si128(_mm_loadu_si128((__m128i *)state), round_keys[0]);
+  for(round = 1; round < 10; round++) {
+    s = _mm_aesenc_si128(s, round_keys[round]);
+  }
+  s = _mm_aesenclast_si128(s, round_keys[10]);
+  _mm_storeu_si128((__m128i *)state, s);
+}
+/*---------------------------------------------------------------------------*/
+/* Interleaving two blocks hides the latency of aesenc */
+AES_NI static void
+encrypt_pair_ni(uint8_t *a, uint8_t *b)
+{
+  __m128i sa, sb;
+  int round;
+
+  sa = _mm_xor_si128(_mm_loadu_si128((__m128i *)a), round_keys[0]);
+  sb = _mm_xor_si128(_mm_loadu_si128((__m128i *)b), round_keys[0]);
+  for(round = 1; round < 10; round++) {
+    sa = _mm_aesenc_si128(sa, round_keys[round]);
+    sb = _mm_aesenc_si128(sb, round_keys[round]);
+  }
+  sa = _mm_aesenclast_si128(sa, round_keys[10]);
+  sb = _mm_aesenclast_si128(sb, round_keys[10]);
+  _mm_storeu_si128((__m128i *)a, sa);
+  _mm_storeu_si128((__m128i *)b, sb);
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_key(const uint8_t *key)
+{
+  have_aes_ni = __builtin_cpu_supports("aes") != 0;
+  if(have_aes_ni) {
+    set_key_ni(key);
+  } else {
+    aes_128_ttable_driver.set_key(key);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+encrypt(uint8_t *plaintext_and_result)
+{
+  if(have_aes_ni) {
+    encrypt_ni(plaintext_and_result);
+  } else {
+    aes_128_ttable_driver.encrypt(plaintext_and_result);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+encrypt_pair(uint8_t *a_and_result, uint8_t *b_and_result)
+{
+  if(have_aes_ni) {
+    encrypt_pair_ni(a_and_result, b_and_result);
+  } else {
+    aes_128_ttable_driver.encrypt(a_and_result);
+    aes_128_ttable_driver.encrypt(b_and_result);
+  }
+}
+/*---------------------------------------------------------------------------*/
+const struct aes_128_driver aes_128_ni_driver = {
+  set_key,
+  encrypt,
+  encrypt_pair
+};
+/*---------------------------------------------------------------------------*/
+
+#else /* __GNUC__ && x86 */
+
+/*---------------------------------------------------------------------------*/
+static void
+set_key(const uint8_t *key)
+{
+  aes_128_ttable_driver.set_key(key);
+}
+/*---------------------------------------------------------------------------*/
+static void
+encrypt(uint8_t *plaintext_and_result)
+{
+  aes_128_ttable_driver.encrypt(plaintext_and_result);
+}
+/*---------------------------------------------------------------------------*/
+const struct aes_128_driver aes_128_ni_driver = {
+  set_key,
+  encrypt,
+  NULL
+};
+/*---------------------------------------------------------------------------*/
+
+#endif /* __GNUC__ && x86 */
@@ -90,3 +90,27 @@ rtimer_arch_schedule(rtimer_clock_t t)
 #endif /* !_WIN32 */
 }
 /*---------------------------------------------------------------------------*/
+void
+rtimer_arch_lock(void)
+{
+#ifndef _WIN32
+  sigset_t set;
+
+  sigemptyset(&set);
+  sigaddset(&set, SIGALRM);
+  sigprocmask(SIG_BLOCK, &set, NULL);
+#endif /* !_WIN32 */
+}
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_unlock(void)
+{
+#ifndef _WIN32
+  sigset_t set;
+
+  sigemptyset(&set);
+  sigaddset(&set, SIGALRM);
+  sigprocmask(SIG_UNBLOCK, &set, NULL);
+#endif /* !_WIN32 */
+}
+/*---------------------------------------------------------------------------*/
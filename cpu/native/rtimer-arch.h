@@ -46,4 +46,13 @@
 
 #define rtimer_arch_now() clock_time()
 
+/* The rtimer runs from SIGALRM; keep it out while the queue changes. */
+#ifndef RTIMER_CONF_LOCK
+#define RTIMER_CONF_LOCK() rtimer_arch_lock()
+#define RTIMER_CONF_UNLOCK() rtimer_arch_unlock()
+#endif /* RTIMER_CONF_LOCK */
+
+void rtimer_arch_lock(void);
+void rtimer_arch_unlock(void);
+
 #endif /* RTIMER_ARCH_H_ */
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of Antelope joins: time to join a relation of sensor
+ *         samples with a relation of nodes, first with an index on the
+ *         node attribute of the nodes only and then with inline indexes
+ *         on both relations, with a check of every joined tuple.
+ */
+
+#include "contiki.h"
+#include "antelope.h"
+#include "cfs/cfs-coffee.h"
+#include "lib/random.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NODES           200
+#define SAMPLES         2000
+#define ROOMS           10
+
+PROCESS(join_bench_process, "Antelope join benchmark");
+AUTOSTART_PROCESSES(&join_bench_process);
+/*---------------------------------------------------------------------------*/
+/* Node of a sample. The samples are in ascending order of node, so that
+   the relation can have an inline index on it. */
+static int
+sample_node(int sample)
+{
+  return (long)sample * NODES / SAMPLES;
+}
+/*---------------------------------------------------------------------------*/
+/* Generate the relations nodes(node, room) and samples(node, value),
+   with an index of each given type on their node attribute. */
+static int
+generate_relations(const char *nodes_index, const char *samples_index)
+{
+  int i, errors;
+
+  db_query(NULL, "REMOVE RELATION nodes;");
+  db_query(NULL, "REMOVE RELATION samples;");
+
+  errors = 0;
+  errors += DB_ERROR(db_query(NULL, "CREATE RELATION nodes;"));
+  errors += DB_ERROR(db_query(NULL, "CREATE ATTRIBUTE node DOMAIN INT IN nodes;"));
+  errors += DB_ERROR(db_query(NULL, "CREATE ATTRIBUTE room DOMAIN INT IN nodes;"));
+  if(nodes_index != NULL) {
+    errors += DB_ERROR(db_query(NULL, "CREATE INDEX nodes.node TYPE %s;",
+                                nodes_index));
+  }
+  errors += DB_ERROR(db_query(NULL, "CREATE RELATION samples;"));
+  errors += DB_ERROR(db_query(NULL, "CREATE ATTRIBUTE node DOMAIN INT IN samples;"));
+  errors += DB_ERROR(db_query(NULL, "CREATE ATTRIBUTE value DOMAIN INT IN samples;"));
+  if(samples_index != NULL) {
+    errors += DB_ERROR(db_query(NULL, "CREATE INDEX samples.node TYPE %s;",
+                                samples_index));
+  }
+
+  for(i = 0; i < NODES; i++) {
+    errors += DB_ERROR(db_query(NULL, "INSERT (%d, %d) INTO nodes;",
+                                i, i % ROOMS));
+  }
+  for(i = 0; i < SAMPLES; i++) {
+    errors += DB_ERROR(db_query(NULL, "INSERT (%d, %d) INTO samples;",
+                                sample_node(i), i));
+  }
+
+  if(errors > 0) {
+    printf("failed to generate the relations\n");
+  }
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+/* Join the samples with their nodes, and check the room of each sample. */
+static int
+join(const char *name)
+{
+  static const char *strategies[] = { "auto", "index", "hash", "merge" };
+  db_handle_t handle;
+  attribute_value_t value, room;
+  db_result_t result;
+  unsigned long t0;
+  int rows, errors;
+
+  errors = 0;
+  rows = 0;
+  t0 = usec_now();
+  result = db_query(&handle, "JOIN samples, nodes ON node PROJECT value, room;");
+  if(DB_ERROR(result)) {
+    printf("join failed: %s\n", db_get_result_message(result));
+    db_free(&handle);
+    return 1;
+  }
+
+  while(db_processing(&handle)) {
+    result = db_process(&handle);
+    if(result == DB_GOT_ROW) {
+      rows++;
+      if(DB_ERROR(db_get_value(&value, &handle, 0)) ||
+         DB_ERROR(db_get_value(&room, &handle, 1)) ||
+         db_value_to_long(&room) !=
+         sample_node(db_value_to_long(&value)) % ROOMS) {
+        errors++;
+      }
+    } else if(result == DB_FINISHED) {
+      break;
+    } else if(DB_ERROR(result)) {
+      printf("join processing failed: %s\n", db_get_result_message(result));
+      errors++;
+      break;
+    }
+  }
+
+  printf("%s join: %s strategy, ", name, strategies[handle.join_strategy]);
+  print_result("tuple", SAMPLES, usec_now() - t0, SAMPLES);
+  db_free(&handle);
+
+  if(rows != SAMPLES) {
+    printf("joined %d of %d tuples\n", rows, SAMPLES);
+    errors++;
+  }
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(join_bench_process, ev, data)
+{
+  static int errors;
+
+  PROCESS_BEGIN();
+
+  printf("Antelope join benchmark\n");
+
+  cfs_coffee_format();
+  db_init();
+
+  errors += generate_relations("MAXHEAP", NULL);
+  errors += join("maxheap");
+
+  errors += generate_relations("INLINE", "INLINE");
+  errors += join("inline");
+
+  printf("Antelope join benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
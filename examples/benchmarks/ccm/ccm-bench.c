@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of AES-128 and CCM*: time per block of each software
+ *         AES driver and frames per second of CCM* at every MIC length,
+ *         with checks against the FIPS-197 and RFC 3610 test vectors and
+ *         against a block-by-block CCM* reference.
+ */
+
+#include "contiki.h"
+#include "lib/aes-128.h"
+#include "lib/ccm-star.h"
+#include "lib/random.h"
+#include "dev/aes-128-ni.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCKS          100000
+#define FRAMES          20000
+#define FUZZ_ROUNDS     2000
+/* A data frame with a 23-byte header and auxiliary security header */
+#define FRAME_A_LEN     23
+#define FRAME_M_LEN     80
+
+PROCESS(ccm_bench_process, "CCM* benchmark");
+AUTOSTART_PROCESSES(&ccm_bench_process);
+
+extern const struct aes_128_driver aes_128_driver;
+
+static const struct aes_128_driver *drivers[] = {
+  &aes_128_driver, &aes_128_ttable_driver, &aes_128_ni_driver
+};
+static const char *driver_names[] = { "ref", "ttable", "ni" };
+#define NUM_DRIVERS (sizeof(drivers) / sizeof(drivers[0]))
+
+static const uint8_t mic_lens[] = { 0, 4, 8, 16 };
+/*---------------------------------------------------------------------------*/
+static void
+fill(uint8_t *data, int len)
+{
+  int i;
+
+  for(i = 0; i < len; i++) {
+    data[i] = (uint8_t)random_rand();
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* CCM* as in RFC 3610, one block at a time with the reference driver */
+static void
+ref_ccm(const uint8_t *nonce, uint8_t *m, uint8_t m_len,
+        const uint8_t *a, uint8_t a_len, uint8_t *mic, uint8_t mic_len)
+{
+  uint8_t x[AES_128_BLOCK_SIZE];
+  uint8_t s[AES_128_BLOCK_SIZE];
+  uint8_t b[2 + 255 + AES_128_BLOCK_SIZE];
+  int i, j, len;
+
+  /* B_0 */
+  x[0] = (a_len ? 0x40 : 0) | (((mic_len - 2u) >> 1) << 3) | 1;
+  memcpy(x + 1, nonce, CCM_STAR_NONCE_LENGTH);
+  x[14] = 0;
+  x[15] = m_len;
+  aes_128_driver.encrypt(x);
+
+  /* l(a) || a, padded */
+  len = 0;
+  if(a_len) {
+    memset(b, 0, sizeof(b));
+    b[1] = a_len;
+    memcpy(b + 2, a, a_len);
+    len = 2 + a_len;
+  }
+  for(i = 0; i < len; i += AES_128_BLOCK_SIZE) {
+    for(j = 0; j < AES_128_BLOCK_SIZE; j++) {
+      x[j] ^= b[i + j];
+    }
+    aes_128_driver.encrypt(x);
+  }
+
+  /* m, padded */
+  memset(b, 0, sizeof(b));
+  memcpy(b, m, m_len);
+  for(i = 0; i < m_len; i += AES_128_BLOCK_SIZE) {
+    for(j = 0; j < AES_128_BLOCK_SIZE; j++) {
+      x[j] ^= b[i + j];
+    }
+    aes_128_driver.encrypt(x);
+  }
+
+  for(i = 0; i <= (m_len + AES_128_BLOCK_SIZE - 1) / AES_128_BLOCK_SIZE; i++) {
+    s[0] = 1;
+    memcpy(s + 1, nonce, CCM_STAR_NONCE_LENGTH);
+    s[14] = 0;
+    s[15] = i;
+    aes_128_driver.encrypt(s);
+    for(j = 0; j < AES_128_BLOCK_SIZE; j++) {
+      if(i == 0) {
+        if(j < mic_len) {
+          mic[j] = x[j] ^ s[j];
+        }
+      } else if((i - 1) * AES_128_BLOCK_SIZE + j < m_len) {
+        m[(i - 1) * AES_128_BLOCK_SIZE + j] ^= s[j];
+      }
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+check_vectors(void)
+{
+  /* FIPS-197, appendix C.1 */
+  static const uint8_t key[16] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+  };
+  static const uint8_t plaintext[16] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+  };
+  static const uint8_t ciphertext[16] = {
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+    0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+  };
+  /* RFC 3610, packet vector #1 */
+  static const uint8_t ccm_key[16] = {
+    0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+    0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf
+  };
+  static const uint8_t ccm_nonce[13] = {
+    0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00,
+    0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5
+  };
+  static const uint8_t ccm_packet[39] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x58, 0x8c, 0x97, 0x9a, 0x61, 0xc6, 0x63, 0xd2,
+    0xf0, 0x66, 0xd0, 0xc2, 0xc0, 0xf9, 0x89, 0x80,
+    0x6d, 0x5f, 0x6b, 0x61, 0xda, 0xc3, 0x84, 0x17,
+    0xe8, 0xd1, 0x2c, 0xfd, 0xf9, 0x26, 0xe0
+  };
+  uint8_t a[16], b[16];
+  uint8_t m[23], mic[8];
+  int d, i, errors;
+
+  errors = 0;
+  for(d = 0; d < NUM_DRIVERS; d++) {
+    drivers[d]->set_key(key);
+    memcpy(a, plaintext, sizeof(a));
+    drivers[d]->encrypt(a);
+    if(memcmp(a, ciphertext, sizeof(a)) != 0) {
+      printf("%s: wrong FIPS-197 ciphertext\n", driver_names[d]);
+      errors++;
+    }
+    if(drivers[d]->encrypt_pair) {
+      memcpy(a, plaintext, sizeof(a));
+      memcpy(b, plaintext, sizeof(b));
+      drivers[d]->encrypt_pair(a, b);
+      if(memcmp(a, ciphertext, sizeof(a)) != 0 ||
+         memcmp(b, ciphertext, sizeof(b)) != 0) {
+        printf("%s: wrong FIPS-197 ciphertext from encrypt_pair\n",
+               driver_names[d]);
+        errors++;
+      }
+    }
+  }
+
+  CCM_STAR.set_key(ccm_key);
+  for(i = 0; i < sizeof(m); i++) {
+    m[i] = 8 + i;
+  }
+  CCM_STAR.aead(ccm_nonce, m, sizeof(m), ccm_packet, 8, mic, sizeof(mic), 1);
+  if(memcmp(m, ccm_packet + 8, sizeof(m)) != 0 ||
+     memcmp(mic, ccm_packet + 8 + sizeof(m), sizeof(mic)) != 0) {
+    printf("wrong RFC 3610 packet\n");
+    errors++;
+  }
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+/* Compare the drivers on random keys and blocks, and CCM* with the
+   reference for random lengths in both directions */
+static int
+fuzz(void)
+{
+  uint8_t key[16], nonce[CCM_STAR_NONCE_LENGTH];
+  uint8_t a[64], m[128], expected[128], plain[128];
+  uint8_t mic[16], expected_mic[16];
+  uint8_t block[16], ref_block[16];
+  int i, d, errors;
+  uint8_t a_len, m_len, mic_len;
+
+  errors = 0;
+  for(i = 0; i < FUZZ_ROUNDS; i++) {
+    fill(key, sizeof(key));
+    fill(plain, sizeof(block));
+    memcpy(ref_block, plain, sizeof(ref_block));
+    aes_128_driver.set_key(key);
+    aes_128_driver.encrypt(ref_block);
+    for(d = 1; d < NUM_DRIVERS; d++) {
+      drivers[d]->set_key(key);
+      memcpy(block, plain, sizeof(block));
+      drivers[d]->encrypt(block);
+      if(memcmp(block, ref_block, sizeof(block)) != 0) {
+        printf("%s: differs from the reference\n", driver_names[d]);
+        errors++;
+      }
+    }
+
+    fill(nonce, sizeof(nonce));
+    a_len = random_rand() % (sizeof(a) + 1);
+    m_len = random_rand() % (sizeof(m) + 1);
+    mic_len = mic_lens[random_rand() % sizeof(mic_lens)];
+    fill(a, a_len);
+    fill(plain, m_len);
+    memcpy(m, plain, m_len);
+    memcpy(expected, plain, m_len);
+
+    CCM_STAR.set_key(key);
+    aes_128_driver.set_key(key);
+    ref_ccm(nonce, expected, m_len, a, a_len, expected_mic, mic_len);
+    CCM_STAR.aead(nonce, m, m_len, a, a_len, mic, mic_len, 1);
+    if(memcmp(m, expected, m_len) != 0 ||
+       memcmp(mic, expected_mic, mic_len) != 0) {
+      printf("ccm: a_len %u m_len %u mic_len %u: wrong output\n",
+             a_len, m_len, mic_len);
+      errors++;
+    }
+    CCM_STAR.aead(nonce, m, m_len, a, a_len, mic, mic_len, 0);
+    if(memcmp(m, plain, m_len) != 0 ||
+       memcmp(mic, expected_mic, mic_len) != 0) {
+      printf("ccm: a_len %u m_len %u mic_len %u: wrong decryption\n",
+             a_len, m_len, mic_len);
+      errors++;
+    }
+  }
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+static void
+bench(void)
+{
+  uint8_t key[16], nonce[CCM_STAR_NONCE_LENGTH];
+  uint8_t a[FRAME_A_LEN], m[FRAME_M_LEN], mic[16], block[16];
+  unsigned long t0, usec;
+  char name[16];
+  int d, i, l;
+
+  fill(key, sizeof(key));
+  fill(nonce, sizeof(nonce));
+  fill(a, sizeof(a));
+  fill(m, sizeof(m));
+  fill(block, sizeof(block));
+
+  for(d = 0; d < NUM_DRIVERS; d++) {
+    drivers[d]->set_key(key);
+    t0 = usec_now();
+    for(i = 0; i < BLOCKS; i++) {
+      drivers[d]->encrypt(block);
+    }
+    print_result(driver_names[d], AES_128_BLOCK_SIZE, usec_now() - t0, BLOCKS);
+  }
+
+  /* CCM* with AES_128, i.e. AES_128_CONF */
+  CCM_STAR.set_key(key);
+  for(l = 0; l < sizeof(mic_lens); l++) {
+    t0 = usec_now();
+    for(i = 0; i < FRAMES; i++) {
+      CCM_STAR.aead(nonce, m, sizeof(m), a, sizeof(a), mic, mic_lens[l], 1);
+    }
+    usec = usec_now() - t0;
+    sprintf(name, "mic-%u", mic_lens[l]);
+    printf("%-8s n=%-5d %8lu ns/op %8lu frames/s\n", name, FRAME_M_LEN,
+           usec * 1000UL / FRAMES, FRAMES * 1000000UL / (usec ? usec : 1));
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(ccm_bench_process, ev, data)
+{
+  int errors;
+
+  PROCESS_BEGIN();
+
+  errors = check_vectors();
+  errors += fuzz();
+  bench();
+
+  printf("CCM* benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the Internet checksum: throughput over a 1280-byte
+ *         packet, and a fuzzer that checks the checksum engine and its
+ *         incremental update against a byte-at-a-time reference for
+ *         random lengths, alignments and initial sums.
+ */
+
+#include "contiki.h"
+#include "net/ip/uip.h"
+#include "net/ip/uip-chksum.h"
+#include "lib/random.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PACKET_LEN      1280
+#define ITERATIONS      20000
+#define FUZZ_ROUNDS     20000
+#define MAX_LEN         1500
+
+PROCESS(chksum_bench_process, "Checksum benchmark");
+AUTOSTART_PROCESSES(&chksum_bench_process);
+
+/* Room for any length at any of the eight alignments */
+static uint16_t buf_words[(MAX_LEN + 8) / 2 + 1];
+static uint8_t *buf = (uint8_t *)buf_words;
+static uint8_t old_data[MAX_LEN];
+/*---------------------------------------------------------------------------*/
+/* The generic uIP checksum loop, one byte pair at a time */
+static uint16_t
+ref_chksum(uint16_t sum, const uint8_t *data, uint16_t len)
+{
+  uint32_t acc;
+  uint16_t i;
+
+  acc = sum;
+  for(i = 0; i + 1 < len; i += 2) {
+    acc += (data[i] << 8) | data[i + 1];
+  }
+  if(len & 1) {
+    acc += data[len - 1] << 8;
+  }
+  while(acc > 0xffff) {
+    acc = (acc & 0xffff) + (acc >> 16);
+  }
+  return (uint16_t)acc;
+}
+/*---------------------------------------------------------------------------*/
+static void
+fill(uint8_t *data, int len)
+{
+  int i;
+
+  for(i = 0; i < len; i++) {
+    data[i] = (uint8_t)random_rand();
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* 0x0000 and 0xffff are both zero in one's complement */
+static int
+same_chksum(uint16_t a, uint16_t b)
+{
+  return a == b || ((a == 0 || a == 0xffff) && (b == 0 || b == 0xffff));
+}
+/*---------------------------------------------------------------------------*/
+static int
+fuzz_add(void)
+{
+  uint16_t len, sum, expected, got;
+  int i, offset, errors;
+
+  errors = 0;
+  for(i = 0; i < FUZZ_ROUNDS; i++) {
+    len = random_rand() % (MAX_LEN + 1);
+    offset = random_rand() % 8;
+    sum = random_rand();
+    fill(buf + offset, len);
+
+    expected = ref_chksum(sum, buf + offset, len);
+    got = uip_chksum_add(sum, buf + offset, len);
+    if(!same_chksum(got, expected)) {
+      printf("add: len %u offset %d sum 0x%04x: 0x%04x, expected 0x%04x\n",
+             len, offset, sum, got, expected);
+      errors++;
+    }
+  }
+
+  /* All-ones data makes every carry count */
+  memset(buf, 0xff, MAX_LEN + 8);
+  for(offset = 0; offset < 8; offset++) {
+    for(len = MAX_LEN - 3; len <= MAX_LEN; len++) {
+      if(uip_chksum_add(0xffff, buf + offset, len) !=
+         ref_chksum(0xffff, buf + offset, len)) {
+        printf("add: all ones, len %u offset %d\n", len, offset);
+        errors++;
+      }
+    }
+  }
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+/* Rewrite a word or a region of a checksummed packet and compare the
+   incremental update with a recomputation */
+static int
+fuzz_update(void)
+{
+  uint16_t len, region, chksum, expected, got, old_word, new_word;
+  int i, offset, errors;
+
+  errors = 0;
+  for(i = 0; i < FUZZ_ROUNDS; i++) {
+    len = 2 + 2 * (random_rand() % (MAX_LEN / 2));
+    fill(buf, len);
+    chksum = ~ref_chksum(0, buf, len);
+
+    offset = 2 * (random_rand() % (len / 2));
+    old_word = (buf[offset] << 8) | buf[offset + 1];
+    new_word = random_rand();
+    buf[offset] = new_word >> 8;
+    buf[offset + 1] = new_word & 0xff;
+    expected = ~ref_chksum(0, buf, len);
+    got = uip_chksum_update16(chksum, old_word, new_word);
+    if(!same_chksum(got, expected)) {
+      printf("update16: 0x%04x, expected 0x%04x\n", got, expected);
+      errors++;
+    }
+    /* Either byte order will do, as long as all three agree */
+    got = uip_chksum_update16(UIP_HTONS(chksum), UIP_HTONS(old_word),
+                              UIP_HTONS(new_word));
+    if(!same_chksum(UIP_HTONS(got), expected)) {
+      printf("update16 (network order): 0x%04x, expected 0x%04x\n",
+             UIP_HTONS(got), expected);
+      errors++;
+    }
+
+    chksum = expected;
+    offset = 2 * (random_rand() % (len / 2));
+    region = 1 + random_rand() % (len - offset);
+    memcpy(old_data, buf + offset, region);
+    fill(buf + offset, region);
+    expected = ~ref_chksum(0, buf, len);
+    got = uip_chksum_update(chksum, old_data, buf + offset, region);
+    if(!same_chksum(got, expected)) {
+      printf("update: len %u offset %d region %u: 0x%04x, expected 0x%04x\n",
+             len, offset, region, got, expected);
+      errors++;
+    }
+  }
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+static int
+bench(void)
+{
+  unsigned long t0;
+  volatile uint16_t sink;
+  uint16_t expected;
+  int i, errors;
+
+  errors = 0;
+  fill(buf, PACKET_LEN + 1);
+  expected = ref_chksum(0, buf, PACKET_LEN);
+
+  t0 = usec_now();
+  for(i = 0; i < ITERATIONS; i++) {
+    sink = ref_chksum(0, buf, PACKET_LEN);
+  }
+  print_result("ref", PACKET_LEN, usec_now() - t0, ITERATIONS);
+
+  /* uip_chksum() uses the engine when UIP_CONF_CHKSUM_FAST is set */
+  t0 = usec_now();
+  for(i = 0; i < ITERATIONS; i++) {
+    sink = uip_chksum(buf_words, PACKET_LEN);
+  }
+  print_result("chksum", PACKET_LEN, usec_now() - t0, ITERATIONS);
+  if(sink != UIP_HTONS(expected)) {
+    errors++;
+  }
+
+  t0 = usec_now();
+  for(i = 0; i < ITERATIONS; i++) {
+    sink = uip_chksum_add(0, buf + 1, PACKET_LEN);
+  }
+  print_result("add+1", PACKET_LEN, usec_now() - t0, ITERATIONS);
+  if(sink != ref_chksum(0, buf + 1, PACKET_LEN)) {
+    errors++;
+  }
+
+  t0 = usec_now();
+  for(i = 0; i < ITERATIONS; i++) {
+    sink = uip_chksum_update16(sink, 0x4000 + i, 0x3f00 + i);
+  }
+  print_result("update16", 2, usec_now() - t0, ITERATIONS);
+
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(chksum_bench_process, ev, data)
+{
+  int errors;
+
+  PROCESS_BEGIN();
+
+  errors = fuzz_add();
+  errors += fuzz_update();
+  errors += bench();
+
+  printf("Checksum benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
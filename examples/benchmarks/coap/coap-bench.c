@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the CoAP message codec: parsing a request into a
+ *         coap_packet_t against iterating its options in place, and
+ *         serializing an observe notification from a coap_packet_t
+ *         against writing it in a single pass. The output of both
+ *         serializers is compared byte for byte.
+ */
+
+#include "contiki.h"
+#include "er-coap.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ROUNDS 1000000
+
+static const uint8_t token[] = { 0xca, 0xfe, 0xbe, 0xef };
+static const char payload[] = "{\"t\":21.5,\"h\":40,\"ts\":1760000000}";
+
+static uint8_t request[64];
+static size_t request_len;
+static uint8_t work[128];
+static uint8_t out1[128], out2[128];
+static int errors;
+
+PROCESS(coap_bench_process, "CoAP codec benchmark");
+AUTOSTART_PROCESSES(&coap_bench_process);
+/*---------------------------------------------------------------------------*/
+static size_t
+write_request(uint8_t *buf, size_t size)
+{
+  coap_writer_t w;
+
+  coap_writer_init(&w, buf, size, COAP_TYPE_CON, COAP_GET, 0x1234,
+                   token, sizeof(token));
+  coap_writer_add_int_option(&w, COAP_OPTION_OBSERVE, 0);
+  coap_writer_add_option(&w, COAP_OPTION_URI_PATH, "sensors", 7);
+  coap_writer_add_option(&w, COAP_OPTION_URI_PATH, "env", 3);
+  coap_writer_add_option(&w, COAP_OPTION_URI_PATH, "1", 1);
+  coap_writer_add_int_option(&w, COAP_OPTION_ACCEPT,
+                             APPLICATION_JSON);
+  return coap_writer_finish(&w);
+}
+/*---------------------------------------------------------------------------*/
+static size_t
+serialize_notification(uint8_t *buf, uint32_t seq)
+{
+  static coap_packet_t pkt;
+
+  coap_init_message(&pkt, COAP_TYPE_NON, CONTENT_2_05, 0x4321);
+  coap_set_token(&pkt, token, sizeof(token));
+  coap_set_header_observe(&pkt, seq);
+  coap_set_header_content_format(&pkt, APPLICATION_JSON);
+  coap_set_header_max_age(&pkt, 30);
+  coap_set_payload(&pkt, payload, sizeof(payload) - 1);
+  return coap_serialize_message(&pkt, buf);
+}
+/*---------------------------------------------------------------------------*/
+static size_t
+write_notification(uint8_t *buf, size_t size, uint32_t seq)
+{
+  coap_writer_t w;
+
+  coap_writer_init(&w, buf, size, COAP_TYPE_NON, CONTENT_2_05, 0x4321,
+                   token, sizeof(token));
+  coap_writer_add_int_option(&w, COAP_OPTION_OBSERVE, seq);
+  coap_writer_add_int_option(&w, COAP_OPTION_CONTENT_FORMAT,
+                             APPLICATION_JSON);
+  coap_writer_add_int_option(&w, COAP_OPTION_MAX_AGE, 30);
+  coap_writer_add_payload(&w, payload, sizeof(payload) - 1);
+  return coap_writer_finish(&w);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(coap_bench_process, ev, data)
+{
+  static coap_packet_t pkt;
+  static coap_option_iterator_t it;
+  static unsigned long t0;
+  static long r;
+  static size_t len1, len2;
+  static unsigned int sum;
+  const char *path;
+
+  PROCESS_BEGIN();
+
+  printf("CoAP codec benchmark\n");
+
+  request_len = write_request(request, sizeof(request));
+  memcpy(work, request, request_len);
+  if(coap_parse_message(&pkt, work, request_len) != NO_ERROR ||
+     coap_get_header_uri_path(&pkt, &path) != 13 ||
+     strncmp(path, "sensors/env/1", 13) != 0 ||
+     !IS_OPTION(&pkt, COAP_OPTION_OBSERVE) ||
+     pkt.accept != APPLICATION_JSON) {
+    printf("parse: request not parsed back\n");
+    errors++;
+  }
+
+  /* Both variants copy the request first, as parsing merges the
+     Uri-Path segments in place. */
+  t0 = usec_now();
+  for(r = 0; r < ROUNDS; r++) {
+    memcpy(work, request, request_len);
+    coap_parse_message(&pkt, work, request_len);
+    sum += pkt.uri_path_len;
+  }
+  print_result("parse", (int)request_len, usec_now() - t0, ROUNDS);
+
+  t0 = usec_now();
+  for(r = 0; r < ROUNDS; r++) {
+    memcpy(work, request, request_len);
+    coap_option_iterator_init(&it, work, request_len);
+    while(coap_option_iterator_next(&it) > 0) {
+      if(it.number == COAP_OPTION_URI_PATH) {
+        sum += it.length;
+      }
+    }
+  }
+  print_result("iterate", (int)request_len, usec_now() - t0, ROUNDS);
+
+  len1 = serialize_notification(out1, 0x10203);
+  len2 = write_notification(out2, sizeof(out2), 0x10203);
+  if(len1 == 0 || len1 != len2 || memcmp(out1, out2, len1) != 0) {
+    printf("serialize: %u and %u bytes differ\n",
+           (unsigned)len1, (unsigned)len2);
+    errors++;
+  }
+
+  t0 = usec_now();
+  for(r = 0; r < ROUNDS; r++) {
+    sum += serialize_notification(out1, r);
+  }
+  print_result("serial", (int)len1, usec_now() - t0, ROUNDS);
+
+  t0 = usec_now();
+  for(r = 0; r < ROUNDS; r++) {
+    sum += write_notification(out2, sizeof(out2), r);
+  }
+  print_result("write", (int)len2, usec_now() - t0, ROUNDS);
+
+  if(sum == 0) {
+    errors++;
+  }
+
+  printf("CoAP codec benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Randomized tests of the CoAP message codec: messages with
+ *         random tokens, options and payloads are written with the
+ *         single-pass writer and read back with the option iterator
+ *         and coap_parse_message(), then mutated and truncated, which
+ *         must be rejected or parsed without reading outside the
+ *         message. Best run with an address sanitizer.
+ */
+
+#include "contiki.h"
+#include "er-coap.h"
+#include "lib/random.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MESSAGES    20000
+#define MUTATIONS   8
+#define MAX_OPTIONS 8
+#define BUF_SIZE    2600
+
+struct option {
+  unsigned int number;
+  size_t length;
+  uint8_t value[300];
+};
+
+static struct option options[MAX_OPTIONS];
+static uint8_t payload[64];
+static uint8_t buf[BUF_SIZE];
+static int errors;
+
+PROCESS(coap_fuzz_process, "CoAP codec fuzz test");
+AUTOSTART_PROCESSES(&coap_fuzz_process);
+/*---------------------------------------------------------------------------*/
+static unsigned int
+random_delta(void)
+{
+  switch(random_rand() % 8) {
+  case 0:
+    return 13 + random_rand() % 256;    /* one extended byte */
+  case 1:
+    return 269 + random_rand() % 1000;  /* two extended bytes */
+  case 2:
+    return 0;                           /* repeated option */
+  default:
+    return 1 + random_rand() % 12;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static size_t
+random_length(void)
+{
+  switch(random_rand() % 8) {
+  case 0:
+    return 13 + random_rand() % 40;
+  case 1:
+    return 269 + random_rand() % 31;
+  default:
+    return random_rand() % 13;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+fill(uint8_t *p, size_t len)
+{
+  while(len-- > 0) {
+    *p++ = random_rand();
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Reads a message of len bytes from its own allocation, so that the
+   sanitizer sees any read beyond it. */
+static void
+read_message(const uint8_t *msg, size_t len)
+{
+  static coap_packet_t pkt;
+  coap_option_iterator_t it;
+  uint8_t *copy;
+  int r;
+
+  /* coap_parse_message() null-terminates the payload after it */
+  copy = malloc(len + 1);
+  memcpy(copy, msg, len);
+  if(coap_option_iterator_init(&it, copy, len) == NO_ERROR) {
+    while((r = coap_option_iterator_next(&it)) > 0) {
+      if(it.value < copy || it.value + it.length > copy + len) {
+        printf("option %u outside the message\n", it.number);
+        errors++;
+        break;
+      }
+    }
+    if(r == 0 && it.value != NULL && it.value + it.length != copy + len) {
+      printf("payload does not end the message\n");
+      errors++;
+    }
+  }
+  coap_parse_message(&pkt, copy, len);
+  free(copy);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(coap_fuzz_process, ev, data)
+{
+  static coap_writer_t w;
+  static coap_option_iterator_t it;
+  static uint8_t token[COAP_TOKEN_LEN];
+  static uint8_t mutated[BUF_SIZE];
+  static int m, i, k, num_options, r;
+  static size_t token_len, payload_len, len;
+  static unsigned int number;
+
+  PROCESS_BEGIN();
+
+  printf("CoAP codec fuzz test\n");
+
+  for(m = 0; m < MESSAGES; m++) {
+    token_len = random_rand() % (COAP_TOKEN_LEN + 1);
+    fill(token, token_len);
+    num_options = random_rand() % (MAX_OPTIONS + 1);
+    number = 0;
+    for(i = 0; i < num_options; i++) {
+      number += random_delta();
+      options[i].number = number;
+      options[i].length = random_length();
+      fill(options[i].value, options[i].length);
+    }
+    payload_len = random_rand() % 2 ? random_rand() % sizeof(payload) : 0;
+    fill(payload, payload_len);
+
+    coap_writer_init(&w, buf, sizeof(buf), random_rand() % 4,
+                     random_rand(), random_rand(), token, token_len);
+    for(i = 0; i < num_options; i++) {
+      if(random_rand() % 2 && options[i].length <= 4) {
+        /* integer options drop leading zero bytes */
+        options[i].value[0] |= 1;
+        for(k = 0, number = 0; k < options[i].length; k++) {
+          number = number << 8 | options[i].value[k];
+        }
+        coap_writer_add_int_option(&w, options[i].number, number);
+      } else {
+        coap_writer_add_option(&w, options[i].number, options[i].value,
+                               options[i].length);
+      }
+    }
+    coap_writer_add_payload(&w, payload, payload_len);
+    len = coap_writer_finish(&w);
+    if(len == 0) {
+      printf("message %d: not written\n", m);
+      errors++;
+      continue;
+    }
+
+    /* Read back what was written. */
+    if(coap_option_iterator_init(&it, buf, len) != NO_ERROR) {
+      printf("message %d: header not read back\n", m);
+      errors++;
+      continue;
+    }
+    for(i = 0; (r = coap_option_iterator_next(&it)) > 0; i++) {
+      if(i >= num_options || it.number != options[i].number ||
+         it.length != options[i].length ||
+         memcmp(it.value, options[i].value, it.length) != 0) {
+        printf("message %d: option %d not read back\n", m, i);
+        errors++;
+        break;
+      }
+    }
+    if(r == 0 && (i != num_options || it.length != payload_len ||
+                  (payload_len > 0 &&
+                   memcmp(it.value, payload, payload_len) != 0))) {
+      printf("message %d: %d options, payload %u not read back\n",
+             m, i, (unsigned)it.length);
+      errors++;
+    }
+    read_message(buf, len);
+
+    /* Flip bytes, truncate, or both. */
+    for(k = 0; k < MUTATIONS; k++) {
+      memcpy(mutated, buf, len);
+      for(i = 0; i < 1 + k % 3; i++) {
+        mutated[random_rand() % len] ^= 1 << (random_rand() % 8);
+      }
+      read_message(mutated, k % 2 ? random_rand() % (len + 1) : len);
+    }
+  }
+
+  /* A header that claims a longer token than the message holds. */
+  buf[0] = 0x48;
+  read_message(buf, COAP_HEADER_LEN + 2);
+
+  printf("fuzz     n=%-5d %d messages, %d mutations\n", MESSAGES, MESSAGES,
+         MESSAGES * MUTATIONS);
+  printf("CoAP codec fuzz test done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
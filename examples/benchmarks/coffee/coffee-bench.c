@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of Coffee file lookup: cost of opening and reading a
+ *         small file, and of opening a missing file, against the number
+ *         of files on the storage, with checks of file contents across
+ *         removals and garbage collection.
+ */
+
+#include "contiki.h"
+#include "cfs/cfs.h"
+#include "cfs/cfs-coffee.h"
+#include "lib/random.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FILE_SIZE       32
+#define LOOKUPS         2000
+
+PROCESS(coffee_bench_process, "Coffee benchmark");
+AUTOSTART_PROCESSES(&coffee_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+file_name(char *name, int i)
+{
+  sprintf(name, "file-%d", i);
+}
+/*---------------------------------------------------------------------------*/
+static void
+file_data(char *buf, int i)
+{
+  int j;
+
+  for(j = 0; j < FILE_SIZE; j++) {
+    /* Coffee finds the end of a file at its last non-zero byte */
+    buf[j] = (char)(1 + (i * 31 + j) % 255);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+create_file(int i)
+{
+  char name[16];
+  char buf[FILE_SIZE];
+  int fd, n;
+
+  file_name(name, i);
+  if(cfs_coffee_reserve(name, FILE_SIZE) < 0) {
+    return -1;
+  }
+  fd = cfs_open(name, CFS_WRITE);
+  if(fd < 0) {
+    return -1;
+  }
+  file_data(buf, i);
+  n = cfs_write(fd, buf, sizeof(buf));
+  cfs_close(fd);
+  return n == sizeof(buf) ? 0 : -1;
+}
+/*---------------------------------------------------------------------------*/
+/* Open, read and close file i. Returns 1 if the file exists with the
+   right contents, 0 if it does not exist, and -1 otherwise. */
+static int
+read_file(int i)
+{
+  char name[16];
+  char buf[FILE_SIZE + 1];
+  char expected[FILE_SIZE];
+  int fd, n;
+
+  file_name(name, i);
+  fd = cfs_open(name, CFS_READ);
+  if(fd < 0) {
+    return 0;
+  }
+  n = cfs_read(fd, buf, sizeof(buf));
+  cfs_close(fd);
+  file_data(expected, i);
+  return n == FILE_SIZE && memcmp(buf, expected, FILE_SIZE) == 0 ? 1 : -1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+bench(int files)
+{
+  static const char *missing = "missing";
+  unsigned long t0;
+  int i, errors;
+
+  errors = 0;
+  cfs_coffee_format();
+  for(i = 0; i < files; i++) {
+    if(create_file(i) < 0) {
+      printf("failed to create file %d\n", i);
+      return 1;
+    }
+  }
+
+  t0 = usec_now();
+  for(i = 0; i < LOOKUPS; i++) {
+    if(read_file(random_rand() % files) != 1) {
+      errors++;
+    }
+  }
+  print_result("open", files, usec_now() - t0, LOOKUPS);
+
+  t0 = usec_now();
+  for(i = 0; i < LOOKUPS; i++) {
+    if(cfs_open(missing, CFS_READ) >= 0) {
+      errors++;
+    }
+  }
+  print_result("miss", files, usec_now() - t0, LOOKUPS);
+
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+/* Remove every other file and create new ones until the garbage
+   collector has to run, and check that all files are found */
+static int
+check_removals(int files)
+{
+  int i, errors, created;
+
+  errors = 0;
+  cfs_coffee_format();
+  for(i = 0; i < files; i++) {
+    if(create_file(i) < 0) {
+      return 1;
+    }
+  }
+  for(i = 0; i < files; i += 2) {
+    char name[16];
+
+    file_name(name, i);
+    if(cfs_remove(name) < 0) {
+      errors++;
+    }
+  }
+  for(created = files; created < 2 * files; created++) {
+    if(create_file(created) < 0) {
+      break;
+    }
+  }
+  if(created == files) {
+    printf("no files created after removal\n");
+    errors++;
+  }
+
+  for(i = 0; i < created; i++) {
+    if(read_file(i) != (i < files && (i & 1) == 0 ? 0 : 1)) {
+      printf("file %d wrong\n", i);
+      errors++;
+    }
+  }
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(coffee_bench_process, ev, data)
+{
+  static int errors;
+
+  PROCESS_BEGIN();
+
+  printf("Coffee benchmark\n");
+
+  errors += bench(64);
+  errors += bench(512);
+  errors += bench(2048);
+  errors += check_removals(3000);
+
+  printf("Coffee benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of UDP and TCP demultiplexing in uIP: time to process
+ *         a UDP datagram for the last of n connections, one for no
+ *         connection, and a retransmitted SYN for the last of n TCP
+ *         connections, with checks that each reaches the right one.
+ */
+
+#include "contiki.h"
+#include "net/ip/uip.h"
+#include "net/ipv6/uip-ds6.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PACKETS         20000
+#define UDP_BASE_PORT   5000
+#define TCP_BASE_PORT   10000
+#define LISTEN_PORT     80
+#define MAX_CONNS       512
+
+#define TCP_SYN         0x02
+
+#define IP_BUF          ((struct uip_ip_hdr *)&uip_buf[UIP_LLH_LEN])
+#define UDP_BUF         ((struct uip_udp_hdr *)&uip_buf[UIP_LLH_LEN + UIP_IPH_LEN])
+#define TCP_BUF         ((struct uip_tcp_hdr *)&uip_buf[UIP_LLH_LEN + UIP_IPH_LEN])
+
+PROCESS(demux_bench_process, "Demux benchmark");
+AUTOSTART_PROCESSES(&demux_bench_process);
+
+static uip_ipaddr_t peer;
+static struct uip_udp_conn *udp_conns[MAX_CONNS];
+static int udp_count;
+static int tcp_count;
+/*---------------------------------------------------------------------------*/
+static void
+ip_header(uint8_t proto, uint16_t payload_len)
+{
+  memset(uip_buf, 0, UIP_LLH_LEN + UIP_IPH_LEN);
+  IP_BUF->vtc = 0x60;
+  IP_BUF->len[0] = payload_len >> 8;
+  IP_BUF->len[1] = payload_len & 0xff;
+  IP_BUF->proto = proto;
+  IP_BUF->ttl = 64;
+  uip_ipaddr_copy(&IP_BUF->srcipaddr, &peer);
+  uip_ipaddr_copy(&IP_BUF->destipaddr,
+                  &uip_ds6_get_link_local(-1)->ipaddr);
+  uip_len = UIP_IPH_LEN + payload_len;
+  uip_ext_len = 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Processes a datagram to port and returns the connection it reached */
+static struct uip_udp_conn *
+udp_input(uint16_t port)
+{
+  ip_header(UIP_PROTO_UDP, UIP_UDPH_LEN + 4);
+  UDP_BUF->srcport = UIP_HTONS(1234);
+  UDP_BUF->destport = UIP_HTONS(port);
+  UDP_BUF->udplen = UIP_HTONS(UIP_UDPH_LEN + 4);
+  /* uIP accepts a zero UDP checksum */
+  UDP_BUF->udpchksum = 0;
+  memcpy(&uip_buf[UIP_LLH_LEN + UIP_IPUDPH_LEN], "ping", 4);
+
+  uip_udp_conn = NULL;
+  uip_input();
+  uip_clear_buf();
+  /* A scan that finds nothing leaves uip_udp_conn past the table */
+  if(uip_udp_conn == &uip_udp_conns[UIP_UDP_CONNS]) {
+    return NULL;
+  }
+  return uip_udp_conn;
+}
+/*---------------------------------------------------------------------------*/
+/* Processes a SYN from port to the listening port, and returns the
+   connection it reached */
+static struct uip_conn *
+tcp_syn(uint16_t port)
+{
+  ip_header(UIP_PROTO_TCP, UIP_TCPH_LEN);
+  memset(TCP_BUF, 0, UIP_TCPH_LEN);
+  TCP_BUF->srcport = UIP_HTONS(port);
+  TCP_BUF->destport = UIP_HTONS(LISTEN_PORT);
+  TCP_BUF->seqno[0] = port >> 8;
+  TCP_BUF->seqno[1] = port & 0xff;
+  TCP_BUF->tcpoffset = 5 << 4;
+  TCP_BUF->flags = TCP_SYN;
+  TCP_BUF->wnd[0] = 4;
+  TCP_BUF->tcpchksum = ~uip_tcpchksum();
+
+  uip_conn = NULL;
+  uip_input();
+  uip_clear_buf();
+  return uip_conn;
+}
+/*---------------------------------------------------------------------------*/
+static int
+add_connections(int n)
+{
+  int errors;
+
+  errors = 0;
+  for(; udp_count < n; udp_count++) {
+    udp_conns[udp_count] = uip_udp_new(NULL, 0);
+    if(udp_conns[udp_count] == NULL) {
+      printf("no UDP connection %d\n", udp_count);
+      return 1;
+    }
+    uip_udp_bind(udp_conns[udp_count], UIP_HTONS(UDP_BASE_PORT + udp_count));
+  }
+  for(; tcp_count < n; tcp_count++) {
+    if(tcp_syn(TCP_BASE_PORT + tcp_count) == NULL) {
+      printf("no TCP connection %d\n", tcp_count);
+      errors++;
+    }
+  }
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+static int
+bench(int n)
+{
+  struct uip_conn *conn;
+  unsigned long t0;
+  int i, errors;
+
+  errors = add_connections(n);
+
+  t0 = usec_now();
+  for(i = 0; i < PACKETS; i++) {
+    if(udp_input(UDP_BASE_PORT + n - 1) != udp_conns[n - 1]) {
+      errors++;
+    }
+  }
+  print_result("udp", n, usec_now() - t0, PACKETS);
+
+  t0 = usec_now();
+  for(i = 0; i < PACKETS; i++) {
+    if(udp_input(UDP_BASE_PORT - 1) != NULL) {
+      errors++;
+    }
+  }
+  print_result("udp-miss", n, usec_now() - t0, PACKETS);
+
+  t0 = usec_now();
+  for(i = 0; i < PACKETS; i++) {
+    conn = tcp_syn(TCP_BASE_PORT + n - 1);
+    if(conn == NULL || conn->rport != UIP_HTONS(TCP_BASE_PORT + n - 1)) {
+      errors++;
+    }
+  }
+  print_result("tcp", n, usec_now() - t0, PACKETS);
+
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+/* Rebinding and removing must keep the index in step */
+static int
+check_rebind(void)
+{
+  struct uip_udp_conn *c;
+  int errors;
+
+  errors = 0;
+  c = udp_conns[0];
+  uip_udp_bind(c, UIP_HTONS(UDP_BASE_PORT - 2));
+  if(udp_input(UDP_BASE_PORT) != NULL ||
+     udp_input(UDP_BASE_PORT - 2) != c) {
+    errors++;
+  }
+  uip_udp_remove(c);
+  if(udp_input(UDP_BASE_PORT - 2) != NULL) {
+    errors++;
+  }
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(demux_bench_process, ev, data)
+{
+  int errors;
+
+  PROCESS_BEGIN();
+
+  uip_ip6addr(&peer, 0xfe80, 0, 0, 0, 0x0212, 0x7401, 1, 1);
+  uip_listen(UIP_HTONS(LISTEN_PORT));
+
+  errors = bench(8);
+  errors += bench(64);
+  errors += bench(512);
+  errors += check_rebind();
+
+  printf("Demux benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
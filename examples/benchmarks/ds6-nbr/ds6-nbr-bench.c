@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the IPv6 neighbor cache: cost of looking up a
+ *         neighbor by IPv6 address, as done for every packet sent, with
+ *         32, 128 and 512 neighbors. Also checks that evicted, removed
+ *         and re-added neighbors are found under their current address
+ *         only. Build with DEFINES=UIP_DS6_NBR_CONF_HASH_SIZE=1024 to
+ *         measure the IPv6 address index.
+ */
+
+#include "contiki.h"
+#include "net/ipv6/uip-ds6-nbr.h"
+#include "lib/random.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LOOKUP_ROUNDS  100000
+
+static const int sizes[] = { 32, 128, 512 };
+
+PROCESS(ds6_nbr_bench_process, "IPv6 neighbor cache benchmark");
+AUTOSTART_PROCESSES(&ds6_nbr_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+make_lladdr(uip_lladdr_t *lladdr, int i)
+{
+  /* Addresses of the same vendor, differing in the last bytes only */
+  memset(lladdr, 0, sizeof(*lladdr));
+  lladdr->addr[0] = 0x00;
+  lladdr->addr[1] = 0x12;
+  lladdr->addr[2] = 0x4b;
+  lladdr->addr[UIP_LLADDR_LEN - 2] = i >> 8;
+  lladdr->addr[UIP_LLADDR_LEN - 1] = i & 0xff;
+}
+/*---------------------------------------------------------------------------*/
+static void
+make_ipaddr(uip_ipaddr_t *ipaddr, int i)
+{
+  uip_lladdr_t lladdr;
+
+  /* Global addresses derived from the link-layer address */
+  make_lladdr(&lladdr, i);
+  uip_ip6addr(ipaddr, 0xaaaa, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_set_addr_iid(ipaddr, &lladdr);
+}
+/*---------------------------------------------------------------------------*/
+static uip_ds6_nbr_t *
+add(int ip, int ll)
+{
+  uip_ipaddr_t ipaddr;
+  uip_lladdr_t lladdr;
+
+  make_ipaddr(&ipaddr, ip);
+  make_lladdr(&lladdr, ll);
+  return uip_ds6_nbr_add(&ipaddr, &lladdr, 0, NBR_REACHABLE,
+                         NBR_TABLE_REASON_UNDEFINED, NULL);
+}
+/*---------------------------------------------------------------------------*/
+/* Checks that address ip belongs to the neighbor with link-layer
+   address ll, or to no neighbor if ll is negative */
+static int
+check(int ip, int ll)
+{
+  uip_ipaddr_t ipaddr;
+  uip_lladdr_t lladdr;
+  const uip_lladdr_t *found;
+
+  make_ipaddr(&ipaddr, ip);
+  found = uip_ds6_nbr_lladdr_from_ipaddr(&ipaddr);
+  if(ll < 0) {
+    return found == NULL;
+  }
+  make_lladdr(&lladdr, ll);
+  return found != NULL && memcmp(found, &lladdr, sizeof(lladdr)) == 0;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(ds6_nbr_bench_process, ev, data)
+{
+  static int s, n, i, errors;
+  static long round;
+  static unsigned long t0;
+  uip_ipaddr_t ipaddr;
+  uip_ds6_nbr_t *nbr;
+
+  PROCESS_BEGIN();
+
+  printf("IPv6 neighbor cache benchmark (%d index slots)\n",
+         UIP_DS6_NBR_HASH_SIZE);
+
+  n = 0;
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    /* Grow the cache to the next size */
+    t0 = usec_now();
+    for(i = n; i < sizes[s]; i++) {
+      if(add(i, i) == NULL) {
+        errors++;
+      }
+    }
+    print_result("add", sizes[s], usec_now() - t0, sizes[s] - n);
+    n = sizes[s];
+
+    t0 = usec_now();
+    for(round = 0; round < LOOKUP_ROUNDS; round++) {
+      i = random_rand() % n;
+      make_ipaddr(&ipaddr, i);
+      if(uip_ds6_nbr_lladdr_from_ipaddr(&ipaddr) == NULL) {
+        errors++;
+      }
+    }
+    print_result("lookup", n, usec_now() - t0, LOOKUP_ROUNDS);
+
+    /* Packets to off-link or not yet resolved destinations */
+    t0 = usec_now();
+    for(round = 0; round < LOOKUP_ROUNDS; round++) {
+      make_ipaddr(&ipaddr, 0x1000 + random_rand() % 0x1000);
+      if(uip_ds6_nbr_lookup(&ipaddr) != NULL) {
+        errors++;
+      }
+    }
+    print_result("miss", n, usec_now() - t0, LOOKUP_ROUNDS);
+  }
+
+  /* The cache is full: adding a neighbor evicts the oldest one */
+  if(add(n, n) == NULL) {
+    errors++;
+  }
+  errors += !check(0, -1) + !check(1, 1) + !check(n, n);
+
+  /* Remove a neighbor */
+  make_ipaddr(&ipaddr, 1);
+  uip_ds6_nbr_rm(uip_ds6_nbr_lookup(&ipaddr));
+  errors += !check(1, -1);
+
+  /* Re-adding a link-layer address replaces the IPv6 address */
+  nbr = add(0x2000, 2);
+  if(nbr == NULL || uip_ds6_nbr_num() != n - 1) {
+    errors++;
+  }
+  errors += !check(2, -1) + !check(0x2000, 2);
+
+  /* Every other neighbor must still be found */
+  for(i = 3; i <= n; i++) {
+    errors += !check(i, i);
+  }
+
+  printf("IPv6 neighbor cache benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the IPv6 routing table: cost of adding routes
+ *         and of looking up routes to destinations spread over the
+ *         whole table, with 100, 1000 and 5000 host routes and a few
+ *         prefix routes. Build with DEFINES=UIP_DS6_ROUTE_CONF_HASH_SIZE=1024
+ *         to measure the host route index.
+ */
+
+#include "contiki.h"
+#include "net/ip/uip.h"
+#include "net/ipv6/uip-ds6.h"
+#include "lib/random.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_NEXTHOPS   8
+#define LOOKUP_ROUNDS  100000
+
+static const int sizes[] = { 100, 1000, 5000 };
+static uip_ipaddr_t nexthops[NUM_NEXTHOPS];
+
+PROCESS(route_bench_process, "Route table benchmark");
+AUTOSTART_PROCESSES(&route_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+host_addr(uip_ipaddr_t *addr, int i)
+{
+  /* Spread the destinations over a /64 like the nodes of a network */
+  uip_ip6addr(addr, 0xfd00, 0, 0, 0, 0x0212, 0x7400 + (i >> 12),
+              (i * 0x9e37) & 0xffff, i & 0xffff);
+}
+/*---------------------------------------------------------------------------*/
+static void
+add_nexthops(void)
+{
+  uip_lladdr_t lladdr;
+  int i;
+
+  for(i = 0; i < NUM_NEXTHOPS; i++) {
+    memset(&lladdr, 0, sizeof(lladdr));
+    lladdr.addr[0] = 0x02;
+    lladdr.addr[sizeof(lladdr) - 1] = i + 1;
+    uip_ip6addr(&nexthops[i], 0xfe80, 0, 0, 0, 0, 0, 0, i + 1);
+    uip_ds6_nbr_add(&nexthops[i], &lladdr, 1, NBR_REACHABLE,
+                    NBR_TABLE_REASON_UNDEFINED, NULL);
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(route_bench_process, ev, data)
+{
+  static int s, n, i, errors;
+  static long round;
+  static unsigned long t0;
+  uip_ipaddr_t addr;
+  uip_ds6_route_t *r;
+
+  PROCESS_BEGIN();
+
+  printf("Route table benchmark (%d hash buckets)\n",
+         UIP_DS6_ROUTE_HASH_SIZE);
+
+  add_nexthops();
+
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    n = sizes[s];
+
+    while(uip_ds6_route_head() != NULL) {
+      uip_ds6_route_rm(uip_ds6_route_head());
+    }
+
+    /* Adding a route removes covering routes via another nexthop,
+       so the prefixes do not overlap each other or the hosts. */
+    uip_ip6addr(&addr, 0xfd01, 0, 0, 0, 0, 0, 0, 0);
+    uip_ds6_route_add(&addr, 48, &nexthops[0]);
+    uip_ip6addr(&addr, 0xfd02, 0, 0, 1, 0, 0, 0, 0);
+    uip_ds6_route_add(&addr, 64, &nexthops[1]);
+
+    t0 = usec_now();
+    for(i = 0; i < n; i++) {
+      host_addr(&addr, i);
+      if(uip_ds6_route_add(&addr, 128, &nexthops[i % NUM_NEXTHOPS]) == NULL) {
+        errors++;
+      }
+    }
+    print_result("add", n, usec_now() - t0, n);
+
+    t0 = usec_now();
+    for(round = 0; round < LOOKUP_ROUNDS; round++) {
+      i = random_rand() % n;
+      host_addr(&addr, i);
+      r = uip_ds6_route_lookup(&addr);
+      if(r == NULL || r->length != 128 || !uip_ipaddr_cmp(&r->ipaddr, &addr)) {
+        errors++;
+      }
+    }
+    print_result("lookup", n, usec_now() - t0, LOOKUP_ROUNDS);
+
+    /* Destinations without a host route fall back to the prefixes. */
+    uip_ip6addr(&addr, 0xfd02, 0, 0, 1, 0, 0, 0, 1);
+    r = uip_ds6_route_lookup(&addr);
+    if(r == NULL || r->length != 64) {
+      errors++;
+    }
+    uip_ip6addr(&addr, 0xfd01, 0, 0, 2, 0, 0, 0, 1);
+    r = uip_ds6_route_lookup(&addr);
+    if(r == NULL || r->length != 48) {
+      errors++;
+    }
+    uip_ip6addr(&addr, 0xfd03, 0, 0, 0, 0, 0, 0, 1);
+    if(uip_ds6_route_lookup(&addr) != NULL) {
+      errors++;
+    }
+  }
+
+  printf("Route table benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of 6lowpan fragment forwarding at a router: how many
+ *         fragments of a 1280-byte packet have to be received before
+ *         the first one is sent on, and the cost per fragment, with
+ *         checks of the forwarded fragments and of packets whose first
+ *         fragment arrives after the following ones.
+ */
+
+#include "contiki.h"
+#include "net/ip/uip.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/ipv6/uip-ds6-route.h"
+#include "net/ipv6/sicslowpan.h"
+#include "net/netstack.h"
+#include "net/packetbuf.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PACKET_LEN      1280
+#define FIRST_LEN       96   /* Uncompressed bytes in the first fragment */
+#define FRAG_LEN        96   /* Bytes in the following fragments */
+#define SENDERS         4
+#define PACKETS         8000
+#define MAX_FRAMES      32
+
+PROCESS(forward_bench_process, "Fragment forwarding benchmark");
+AUTOSTART_PROCESSES(&forward_bench_process);
+/*---------------------------------------------------------------------------*/
+/* Frames sent by 6lowpan since the last reset */
+static uint8_t sent[MAX_FRAMES][PACKETBUF_SIZE];
+static uint16_t sent_len[MAX_FRAMES];
+static linkaddr_t sent_to[MAX_FRAMES];
+static int sent_count;
+
+static void
+capture_init(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static void
+capture_send(mac_callback_t sent_callback, void *ptr)
+{
+  if(sent_count < MAX_FRAMES) {
+    memcpy(sent[sent_count], packetbuf_dataptr(), packetbuf_datalen());
+    sent_len[sent_count] = packetbuf_datalen();
+    linkaddr_copy(&sent_to[sent_count],
+                  packetbuf_addr(PACKETBUF_ADDR_RECEIVER));
+  }
+  sent_count++;
+  mac_call_sent_callback(sent_callback, ptr, MAC_TX_OK, 1);
+}
+/*---------------------------------------------------------------------------*/
+static void
+capture_input(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+const struct llsec_driver capture_llsec_driver = {
+  "capture",
+  capture_init,
+  capture_send,
+  capture_input
+};
+/*---------------------------------------------------------------------------*/
+static uint8_t
+pattern(int sender, uint16_t offset)
+{
+  return (offset * 7 + sender) & 0xff;
+}
+/*---------------------------------------------------------------------------*/
+/* The frames of the packets of each sender, without tags */
+#define FRAGMENTS (1 + (PACKET_LEN - FIRST_LEN + FRAG_LEN - 1) / FRAG_LEN)
+static uint8_t frames[SENDERS][FRAGMENTS][SICSLOWPAN_FRAG1_HDR_LEN +
+                                          SICSLOWPAN_IPV6_HDR_LEN + FIRST_LEN];
+static uint8_t frame_len[SENDERS][FRAGMENTS];
+
+static void
+build_frames(void)
+{
+  uint8_t *ptr;
+  struct uip_ip_hdr *ip;
+  int sender, frag, hdr_len, len, i;
+  uint16_t offset;
+
+  for(sender = 0; sender < SENDERS; sender++) {
+    for(frag = 0; frag < FRAGMENTS; frag++) {
+      ptr = frames[sender][frag];
+      if(frag == 0) {
+        ptr[0] = SICSLOWPAN_DISPATCH_FRAG1 | (PACKET_LEN >> 8);
+        ptr[1] = PACKET_LEN & 0xff;
+        ptr[SICSLOWPAN_FRAG1_HDR_LEN] = SICSLOWPAN_DISPATCH_IPV6;
+        hdr_len = SICSLOWPAN_FRAG1_HDR_LEN + SICSLOWPAN_IPV6_HDR_LEN;
+        ip = (struct uip_ip_hdr *)(ptr + hdr_len);
+        ip->vtc = 0x60;
+        ip->len[0] = (PACKET_LEN - UIP_IPH_LEN) >> 8;
+        ip->len[1] = (PACKET_LEN - UIP_IPH_LEN) & 0xff;
+        ip->proto = UIP_PROTO_UDP;
+        ip->ttl = 64;
+        uip_ip6addr(&ip->srcipaddr, 0xfd00, 0, 0, 0, 0, 0, 0, sender + 1);
+        uip_ip6addr(&ip->destipaddr, 0xfd01, 0, 0, 0, 0, 0, 0, 1);
+        hdr_len += UIP_IPH_LEN;
+        offset = UIP_IPH_LEN;
+        len = FIRST_LEN - UIP_IPH_LEN;
+      } else {
+        offset = FIRST_LEN + (frag - 1) * FRAG_LEN;
+        ptr[0] = SICSLOWPAN_DISPATCH_FRAGN | (PACKET_LEN >> 8);
+        ptr[1] = PACKET_LEN & 0xff;
+        ptr[4] = offset >> 3;
+        hdr_len = SICSLOWPAN_FRAGN_HDR_LEN;
+        len = MIN(FRAG_LEN, PACKET_LEN - offset);
+      }
+      for(i = 0; i < len; i++) {
+        ptr[hdr_len + i] = pattern(sender, offset + i);
+      }
+      frame_len[sender][frag] = hdr_len + len;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Pass fragment frag of packet tag from a sender to 6lowpan, as the MAC
+ * layer does */
+static void
+input_fragment(int sender, uint16_t tag, int frag)
+{
+  linkaddr_t addr;
+  uint8_t *ptr;
+
+  packetbuf_clear();
+  ptr = packetbuf_dataptr();
+  memcpy(ptr, frames[sender][frag], frame_len[sender][frag]);
+  ptr[2] = tag >> 8;
+  ptr[3] = tag & 0xff;
+  packetbuf_set_datalen(frame_len[sender][frag]);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.u8[LINKADDR_SIZE - 1] = sender + 1;
+  packetbuf_set_addr(PACKETBUF_ADDR_SENDER, &addr);
+  packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, &linkaddr_node_addr);
+
+  sicslowpan_driver.input();
+}
+/*---------------------------------------------------------------------------*/
+/* Send one packet from each sender, with the fragments interleaved */
+static void
+input_packets(uint16_t tag)
+{
+  int frag, s;
+
+  for(frag = 0; frag < FRAGMENTS; frag++) {
+    for(s = 0; s < SENDERS; s++) {
+      input_fragment(s, tag + s, frag);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+#if SICSLOWPAN_CONF_FRAG_FORWARDING
+/* Send the fragments of a packet of sender 0 with the first fragment
+ * arriving in position first_at. Returns the number of frames sent
+ * before the last fragment arrived. */
+static int
+input_out_of_order(uint16_t tag, int first_at)
+{
+  int k, sent_before_last;
+
+  sent_before_last = 0;
+  for(k = 0; k < FRAGMENTS; k++) {
+    if(k == FRAGMENTS - 1) {
+      sent_before_last = sent_count;
+    }
+    input_fragment(0, tag, k < first_at ? k + 1 : (k == first_at ? 0 : k));
+  }
+  return sent_before_last;
+}
+#endif /* SICSLOWPAN_CONF_FRAG_FORWARDING */
+/*---------------------------------------------------------------------------*/
+/* Check the frames sent for one packet of a sender: the payload of the
+ * fragments after the first must arrive unchanged, under one new tag, at
+ * the next hop. Returns the number of errors. */
+static int
+check_frames(int sender, const linkaddr_t *next_hop)
+{
+  int i, n, errors;
+  uint16_t tag, offset, len;
+
+  errors = 0;
+  n = MIN(sent_count, MAX_FRAMES);
+  if(n == 0 || (sent[0][0] & 0xf8) != SICSLOWPAN_DISPATCH_FRAG1 ||
+     (((sent[0][0] & 0x07) << 8) | sent[0][1]) != PACKET_LEN) {
+    return 1;
+  }
+  tag = (sent[0][2] << 8) | sent[0][3];
+  for(i = 0; i < n; i++) {
+    if(!linkaddr_cmp(&sent_to[i], next_hop) ||
+       ((sent[i][2] << 8) | sent[i][3]) != tag) {
+      errors++;
+    }
+    if(i > 0) {
+      offset = sent[i][4] << 3;
+      for(len = SICSLOWPAN_FRAGN_HDR_LEN; len < sent_len[i]; len++) {
+        if(sent[i][len] != pattern(sender, offset++)) {
+          errors++;
+          break;
+        }
+      }
+    }
+  }
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(forward_bench_process, ev, data)
+{
+  static int errors;
+  static uint16_t tag;
+  static unsigned long t0;
+  static uip_lladdr_t next_hop;
+#if SICSLOWPAN_CONF_FRAG_FORWARDING
+  static uip_stats_t drop;
+#endif /* SICSLOWPAN_CONF_FRAG_FORWARDING */
+  uip_ipaddr_t ipaddr, prefix;
+  int i, received;
+
+  PROCESS_BEGIN();
+
+  printf("Fragment forwarding benchmark\n");
+
+  build_frames();
+
+  /* Packets to fd01::/64 are routed through fe80::ff */
+  memset(&next_hop, 0, sizeof(next_hop));
+  next_hop.addr[sizeof(next_hop) - 1] = 0xff;
+  uip_ip6addr(&ipaddr, 0xfe80, 0, 0, 0, 0, 0, 0, 0xff);
+  uip_ds6_nbr_add(&ipaddr, &next_hop, 1, NBR_REACHABLE,
+                  NBR_TABLE_REASON_UNDEFINED, NULL);
+  uip_ip6addr(&prefix, 0xfd01, 0, 0, 0, 0, 0, 0, 0);
+  uip_ds6_route_add(&prefix, 64, &ipaddr);
+
+  /* Fragments received before the first one is sent on */
+  sent_count = 0;
+  received = 0;
+  for(i = 0; i < FRAGMENTS; i++) {
+    input_fragment(0, tag, i);
+    if(sent_count == 0) {
+      received++;
+    }
+  }
+  tag++;
+  printf("latency  %d of %d fragments received before the first is sent\n",
+         received + 1, FRAGMENTS);
+  errors += check_frames(0, (linkaddr_t *)&next_hop);
+
+  t0 = usec_now();
+  for(i = 0; i < PACKETS / SENDERS; i++) {
+    input_packets(tag);
+    tag += SENDERS;
+  }
+  print_result("fragment", PACKETS, usec_now() - t0, (long)PACKETS * FRAGMENTS);
+
+#if SICSLOWPAN_CONF_FRAG_FORWARDING
+  /* The counters are uip_stats_t and may wrap */
+  if(sicslowpan_reass_stats.forwarded !=
+     (uip_stats_t)((PACKETS + 1) * FRAGMENTS) ||
+     sicslowpan_reass_stats.reassembled != 0) {
+    printf("forwarded %u fragments\n", sicslowpan_reass_stats.forwarded);
+    errors++;
+  }
+
+  /* Following fragments that arrive before the first one are held for
+     reassembly, so the first one is not sent on without them: the packet
+     is reassembled and sent on whole, with the first fragment arriving
+     in the middle or last */
+  for(i = 0; i < 2; i++) {
+    sent_count = 0;
+    received = input_out_of_order(tag++, i == 0 ? 2 : FRAGMENTS - 1);
+    if(received != 0 || sent_count < FRAGMENTS ||
+       sicslowpan_reass_stats.reassembled != i + 1) {
+      printf("out of order: sent %d frames early, %d in all\n",
+             received, sent_count);
+      errors++;
+    }
+    errors += check_frames(0, (linkaddr_t *)&next_hop);
+  }
+
+  /* The fragment that ends the packet may overtake the others, which are
+     still sent on. A fragment of another size under the same tag is not. */
+  sent_count = 0;
+  drop = sicslowpan_reass_stats.drop;
+  input_fragment(0, tag, 0);
+  input_fragment(0, tag, FRAGMENTS - 1);
+  for(i = 1; i < FRAGMENTS - 1; i++) {
+    input_fragment(0, tag, i);
+  }
+  if(sent_count != FRAGMENTS || sicslowpan_reass_stats.reassembled != 2 ||
+     sicslowpan_reass_stats.drop != drop) {
+    printf("last fragment first: sent %d frames\n", sent_count);
+    errors++;
+  }
+  errors += check_frames(0, (linkaddr_t *)&next_hop);
+  sent_count = 0;
+  input_fragment(0, tag + 1, 0);
+  frames[0][1][1]--;
+  input_fragment(0, tag + 1, 1);
+  frames[0][1][1]++;
+  if(sent_count != 1 || sicslowpan_reass_stats.drop != drop + 1) {
+    printf("size mismatch: sent %d frames\n", sent_count);
+    errors++;
+  }
+  tag += 2;
+
+  /* Fragments of a packet to this node are reassembled */
+  uip_ip6addr(&ipaddr, 0xfd01, 0, 0, 0, 0, 0, 0, 1);
+  uip_ds6_addr_add(&ipaddr, 0, ADDR_MANUAL);
+  sent_count = 0;
+  input_packets(tag);
+  tag += SENDERS;
+  if(sent_count != 0 || sicslowpan_reass_stats.reassembled != 2 + SENDERS) {
+    printf("sent %d frames, reassembled %u packets\n", sent_count,
+           sicslowpan_reass_stats.reassembled);
+    errors++;
+  }
+#endif /* SICSLOWPAN_CONF_FRAG_FORWARDING */
+
+  printf("Fragment forwarding benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of memb: cost of allocating and freeing blocks in
+ *         pools of 16, 256 and 1024 blocks, when filling a pool and
+ *         when freeing and allocating random blocks of an almost full
+ *         pool. Every allocation is checked against a copy of the pool
+ *         state, as are memb_numfree() and the pool statistics.
+ */
+
+#include "contiki.h"
+#include "lib/memb.h"
+#include "lib/random.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHURN_ROUNDS 200000
+
+struct block {
+  uint8_t data[24];
+};
+
+MEMB(pool16, struct block, 16);
+MEMB(pool256, struct block, 256);
+MEMB(pool1024, struct block, 1024);
+
+static struct memb *pools[] = { &pool16, &pool256, &pool1024 };
+
+static struct block *blocks[1024];
+
+PROCESS(memb_bench_process, "memb benchmark");
+AUTOSTART_PROCESSES(&memb_bench_process);
+/*---------------------------------------------------------------------------*/
+/* Checks that a new block is a free block of the pool */
+static int
+check_alloc(struct memb *m, struct block *b, int n)
+{
+  int i, index;
+
+  if(b == NULL || !memb_inmemb(m, b)) {
+    printf("block %p not in pool\n", b);
+    return 1;
+  }
+  index = b - (struct block *)m->mem;
+  for(i = 0; i < n; i++) {
+    if(blocks[i] == b) {
+      printf("block %d allocated twice\n", index);
+      return 1;
+    }
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static int
+run(struct memb *m)
+{
+  int i, n, errors = 0;
+  long round;
+  unsigned long t0;
+  struct block *b;
+
+  memb_init(m);
+  n = m->num;
+
+  t0 = usec_now();
+  for(i = 0; i < n; i++) {
+    blocks[i] = memb_alloc(m);
+  }
+  print_result("fill", n, usec_now() - t0, n);
+  for(i = 0; i < n; i++) {
+    errors += check_alloc(m, blocks[i], i);
+  }
+  if(memb_alloc(m) != NULL || memb_numfree(m) != 0) {
+    printf("full pool still allocates\n");
+    errors++;
+  }
+
+  /* Free and allocate random blocks, with one block free on average */
+  t0 = usec_now();
+  for(round = 0; round < CHURN_ROUNDS; round++) {
+    i = random_rand() % n;
+    memb_free(m, blocks[i]);
+    blocks[i] = memb_alloc(m);
+  }
+  print_result("churn", n, usec_now() - t0, CHURN_ROUNDS);
+
+  t0 = usec_now();
+  for(round = 0; round < CHURN_ROUNDS; round++) {
+    if(memb_numfree(m) != 0) {
+      errors++;
+      break;
+    }
+  }
+  print_result("numfree", n, usec_now() - t0, CHURN_ROUNDS);
+
+  /* Check churn results by freeing every other block and checking that
+     exactly those are allocated again */
+  for(i = 0; i < n; i += 2) {
+    if(memb_free(m, blocks[i]) != 0) {
+      errors++;
+    }
+    /* A second free of the same block changes nothing */
+    if(memb_free(m, blocks[i]) != 0) {
+      errors++;
+    }
+  }
+  if(memb_numfree(m) != n / 2) {
+    printf("%d blocks free, expected %d\n", memb_numfree(m), n / 2);
+    errors++;
+  }
+  for(i = 0; i < n; i += 2) {
+    b = memb_alloc(m);
+    blocks[i] = NULL;
+    errors += check_alloc(m, b, n);
+    blocks[i] = b;
+  }
+
+  /* Pointers that are not blocks of the pool */
+  if(memb_free(m, (char *)blocks[1] + 1) != -1
+     || memb_free(m, (struct block *)m->mem + n) != -1
+     || memb_free(m, NULL) != -1) {
+    printf("freed a pointer that is not a block\n");
+    errors++;
+  }
+
+#if MEMB_WITH_STATS
+  if(m->max_used != n || m->failures != 1) {
+    printf("stats: max %u failures %u, expected %d 1\n",
+           m->max_used, m->failures, n);
+    errors++;
+  }
+#endif /* MEMB_WITH_STATS */
+
+  for(i = 0; i < n; i++) {
+    memb_free(m, blocks[i]);
+  }
+  if(memb_numfree(m) != n) {
+    errors++;
+  }
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(memb_bench_process, ev, data)
+{
+  static int errors;
+  int p;
+#if MEMB_WITH_STATS
+  struct memb *m;
+  int registered;
+#endif /* MEMB_WITH_STATS */
+
+  PROCESS_BEGIN();
+
+  printf("memb benchmark (statistics %s)\n", MEMB_WITH_STATS ? "on" : "off");
+
+  for(p = 0; p < sizeof(pools) / sizeof(pools[0]); p++) {
+    errors += run(pools[p]);
+  }
+
+#if MEMB_WITH_STATS
+  registered = 0;
+  for(m = memb_pool_list(); m != NULL; m = m->next) {
+    for(p = 0; p < sizeof(pools) / sizeof(pools[0]); p++) {
+      registered += m == pools[p];
+    }
+  }
+  if(registered != sizeof(pools) / sizeof(pools[0])) {
+    printf("%d pools registered, expected %d\n", registered,
+           (int)(sizeof(pools) / sizeof(pools[0])));
+    errors++;
+  }
+#endif /* MEMB_WITH_STATS */
+
+  printf("memb benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the managed memory allocator: cost of freeing
+ *         and allocating random blocks of 8 to 128 bytes with 16, 32
+ *         and 48 blocks allocated, one at a time and half of them at
+ *         once. The contents of every block and the statistics are
+ *         checked after the churn. Build with
+ *         DEFINES=MMEM_CONF_DEFERRED_COMPACTION=1 or
+ *         DEFINES=MMEM_CONF_WITH_SIZE_CLASSES=1 to compare.
+ */
+
+#include "contiki.h"
+#include "lib/mmem.h"
+#include "lib/random.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHURN_ROUNDS 100000
+#define MAX_BLOCKS   48
+#define MIN_SIZE     8
+#define MAX_SIZE     128
+
+static struct mmem blocks[MAX_BLOCKS];
+static uint8_t allocated[MAX_BLOCKS];
+static uint8_t tags[MAX_BLOCKS];
+static const int counts[] = { 16, 32, 48 };
+static int errors;
+
+PROCESS(mmem_bench_process, "mmem benchmark");
+AUTOSTART_PROCESSES(&mmem_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+alloc_block(int i)
+{
+  unsigned int size;
+
+  size = MIN_SIZE + random_rand() % (MAX_SIZE - MIN_SIZE + 1);
+  if(mmem_alloc(&blocks[i], size)) {
+    allocated[i] = 1;
+    tags[i]++;
+    memset(MMEM_PTR(&blocks[i]), tags[i], size);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+free_block(int i)
+{
+  if(allocated[i]) {
+    mmem_free(&blocks[i]);
+    allocated[i] = 0;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+check(int n)
+{
+  struct mmem_stats stats;
+  unsigned int used, j;
+  uint8_t *p;
+  int i;
+
+  used = 0;
+  for(i = 0; i < n; i++) {
+    if(!allocated[i]) {
+      continue;
+    }
+    p = (uint8_t *)MMEM_PTR(&blocks[i]);
+    for(j = 0; j < blocks[i].size; j++) {
+      if(p[j] != tags[i]) {
+        printf("block %d: corrupted at byte %u\n", i, j);
+        errors++;
+        break;
+      }
+    }
+    used += blocks[i].size;
+  }
+
+  mmem_stats(&stats);
+  if(stats.used != used ||
+     stats.used + stats.overhead + stats.free + stats.top > stats.size) {
+    printf("stats: used %u overhead %u free %u top %u size %u, expected used %u\n",
+           stats.used, stats.overhead, stats.free, stats.top, stats.size,
+           used);
+    errors++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(mmem_bench_process, ev, data)
+{
+  static struct mmem_stats stats;
+  static unsigned long t0, tfree, talloc;
+  static int c, n, i, r;
+
+  PROCESS_BEGIN();
+
+  mmem_init();
+  printf("mmem benchmark (%s)\n",
+         MMEM_WITH_SIZE_CLASSES ? "size classes" :
+         MMEM_DEFERRED_COMPACTION ? "deferred compaction" : "compacting");
+
+  for(c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+    n = counts[c];
+    for(i = 0; i < n; i++) {
+      alloc_block(i);
+    }
+
+    t0 = usec_now();
+    for(r = 0; r < CHURN_ROUNDS; r++) {
+      i = random_rand() % n;
+      free_block(i);
+      alloc_block(i);
+    }
+    print_result("churn", n, usec_now() - t0, CHURN_ROUNDS);
+    check(n);
+
+    /* Free and allocate every other block, timed apart. */
+    tfree = talloc = 0;
+    for(r = 0; r < CHURN_ROUNDS / n; r++) {
+      t0 = usec_now();
+      for(i = r & 1; i < n; i += 2) {
+        free_block(i);
+      }
+      tfree += usec_now() - t0;
+      t0 = usec_now();
+      for(i = r & 1; i < n; i += 2) {
+        alloc_block(i);
+      }
+      talloc += usec_now() - t0;
+    }
+    print_result("free", n, tfree, (long)(CHURN_ROUNDS / n) * (n / 2));
+    print_result("alloc", n, talloc, (long)(CHURN_ROUNDS / n) * (n / 2));
+    check(n);
+
+    mmem_stats(&stats);
+    printf("stats    n=%-5d used %u overhead %u free %u top %u, "
+           "%u compactions, %u failures\n", n, stats.used, stats.overhead,
+           stats.free, stats.top, stats.compactions, stats.failures);
+
+    for(i = 0; i < n; i++) {
+      free_block(i);
+    }
+    mmem_compact();
+    mmem_stats(&stats);
+    if(stats.used != 0 || stats.free != 0 || stats.top != stats.size) {
+      printf("stats: %u bytes left after freeing all blocks\n",
+             stats.size - stats.top);
+      errors++;
+    }
+  }
+
+  printf("mmem benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the neighbor table: cost of looking up a neighbor
+ *         by link-layer address, as done for every frame sent or
+ *         received, with 32, 128 and 512 neighbors. Also checks that
+ *         evicted and renamed neighbors are found under their new
+ *         address only. Build with DEFINES=NBR_TABLE_CONF_HASH_SIZE=1024
+ *         to measure the link-layer address index.
+ */
+
+#include "contiki.h"
+#include "net/nbr-table.h"
+#include "lib/random.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LOOKUP_ROUNDS  100000
+
+struct nbr {
+  uint16_t id;
+};
+
+static const int sizes[] = { 32, 128, 512 };
+
+NBR_TABLE(struct nbr, nbrs);
+
+PROCESS(nbr_bench_process, "Neighbor table benchmark");
+AUTOSTART_PROCESSES(&nbr_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+make_lladdr(linkaddr_t *addr, int i)
+{
+  /* Addresses of the same vendor, differing in the last bytes only */
+  memset(addr, 0, sizeof(*addr));
+  addr->u8[0] = 0x00;
+  addr->u8[1] = 0x12;
+  addr->u8[2] = 0x4b;
+  addr->u8[LINKADDR_SIZE - 2] = i >> 8;
+  addr->u8[LINKADDR_SIZE - 1] = i & 0xff;
+}
+/*---------------------------------------------------------------------------*/
+static int
+check(int i, int id)
+{
+  linkaddr_t addr;
+  struct nbr *n;
+
+  make_lladdr(&addr, i);
+  n = nbr_table_get_from_lladdr(nbrs, &addr);
+  if(id < 0) {
+    return n == NULL;
+  }
+  return n != NULL && n->id == id;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(nbr_bench_process, ev, data)
+{
+  static int s, n, i, errors;
+  static long round;
+  static unsigned long t0;
+  linkaddr_t addr, new_addr;
+  struct nbr *nbr;
+
+  PROCESS_BEGIN();
+
+  printf("Neighbor table benchmark (%d index slots)\n", NBR_TABLE_HASH_SIZE);
+
+  nbr_table_register(nbrs, NULL);
+
+  n = 0;
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    /* Grow the table to the next size */
+    t0 = usec_now();
+    for(i = n; i < sizes[s]; i++) {
+      make_lladdr(&addr, i);
+      nbr = nbr_table_add_lladdr(nbrs, &addr, NBR_TABLE_REASON_UNDEFINED, NULL);
+      if(nbr == NULL) {
+        errors++;
+      } else {
+        nbr->id = i;
+      }
+    }
+    print_result("add", sizes[s], usec_now() - t0, sizes[s] - n);
+    n = sizes[s];
+
+    t0 = usec_now();
+    for(round = 0; round < LOOKUP_ROUNDS; round++) {
+      i = random_rand() % n;
+      make_lladdr(&addr, i);
+      nbr = nbr_table_get_from_lladdr(nbrs, &addr);
+      if(nbr == NULL || nbr->id != i) {
+        errors++;
+      }
+    }
+    print_result("lookup", n, usec_now() - t0, LOOKUP_ROUNDS);
+
+    /* Frames from unknown senders */
+    t0 = usec_now();
+    for(round = 0; round < LOOKUP_ROUNDS; round++) {
+      make_lladdr(&addr, 0x1000 + random_rand() % 0x1000);
+      if(nbr_table_get_from_lladdr(nbrs, &addr) != NULL) {
+        errors++;
+      }
+    }
+    print_result("miss", n, usec_now() - t0, LOOKUP_ROUNDS);
+  }
+
+  /* The table is full: adding a neighbor evicts the oldest one */
+  make_lladdr(&addr, n);
+  nbr = nbr_table_add_lladdr(nbrs, &addr, NBR_TABLE_REASON_UNDEFINED, NULL);
+  if(nbr == NULL) {
+    errors++;
+  } else {
+    nbr->id = n;
+  }
+  errors += !check(0, -1) + !check(1, 1) + !check(n, n);
+
+  /* Rename a neighbor, and refuse to rename onto an existing one */
+  make_lladdr(&addr, 1);
+  make_lladdr(&new_addr, 0x2000);
+  if(!nbr_table_update_lladdr(&addr, &new_addr, 0)) {
+    errors++;
+  }
+  errors += !check(1, -1) + !check(0x2000, 1);
+  make_lladdr(&addr, 2);
+  if(nbr_table_update_lladdr(&addr, &new_addr, 0)) {
+    errors++;
+  }
+  errors += !check(2, 2) + !check(0x2000, 1);
+
+  /* Every other neighbor must still be found */
+  for(i = 3; i <= n; i++) {
+    errors += !check(i, i);
+  }
+
+  printf("Neighbor table benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of CoAP observe notifications: CPU time per change of
+ *         an observed resource with 1, 10, 50 and 200 observers. Every
+ *         notification is captured below the IPv6 layer and checked for
+ *         the observer's Token and MID, the next observe counter and the
+ *         latest representation. Build with
+ *         DEFINES=COAP_OBSERVE_MIN_INTERVAL=100 to check that bursts of
+ *         changes are coalesced into one notification per observer.
+ */
+
+#include "contiki.h"
+#include "contiki-net.h"
+#include "er-coap.h"
+#include "er-coap-observe.h"
+#include "er-coap-transactions.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ROUNDS     2000
+#define BURST      10
+#define BASE_PORT  5000
+
+static const int counts[] = { 1, 10, 50, 200 };
+static int errors;
+
+static unsigned long value;
+static unsigned long handler_calls;
+static unsigned long received;
+static int checking;
+
+static void res_get_handler(void *request, void *response, uint8_t *buffer,
+                            uint16_t preferred_size, int32_t *offset);
+
+EVENT_RESOURCE(res_sensor, "title=\"Sensor\";obs", res_get_handler,
+               NULL, NULL, NULL, NULL);
+
+PROCESS(observe_bench_process, "Observe benchmark");
+AUTOSTART_PROCESSES(&observe_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+res_get_handler(void *request, void *response, uint8_t *buffer,
+                uint16_t preferred_size, int32_t *offset)
+{
+  handler_calls++;
+  coap_set_header_content_format(response, APPLICATION_JSON);
+  coap_set_payload(response, buffer,
+                   snprintf((char *)buffer, preferred_size,
+                            "{\"value\":%lu}", value));
+}
+/*---------------------------------------------------------------------------*/
+static coap_observer_t *
+find_observer(uint16_t port)
+{
+  coap_observer_t *obs;
+
+  for(obs = list_head(coap_get_observers()); obs != NULL; obs = obs->next) {
+    if(obs->port == port) {
+      return obs;
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+/* Replaces the network driver: checks the notification in uip_buf */
+static uint8_t
+capture(const uip_lladdr_t *lladdr)
+{
+  static coap_packet_t packet;
+  static char expected[32];
+  coap_observer_t *obs;
+  uint32_t observe;
+  const uint8_t *payload;
+  int len;
+
+  if(UIP_IP_BUF->proto != UIP_PROTO_UDP
+     || UIP_UDP_BUF->srcport != UIP_HTONS(COAP_SERVER_PORT)) {
+    /* other traffic of the IPv6 stack, e.g., RPL */
+    return 0;
+  }
+  received++;
+  if(!checking) {
+    return 0;
+  }
+
+  obs = find_observer(UIP_UDP_BUF->destport);
+  len = uip_ntohs(UIP_UDP_BUF->udplen) - UIP_UDPH_LEN;
+  snprintf(expected, sizeof(expected), "{\"value\":%lu}", value);
+  if(obs == NULL
+     || coap_parse_message(&packet, (uint8_t *)UIP_UDP_BUF + UIP_UDPH_LEN,
+                           len) != NO_ERROR
+     || packet.mid != obs->last_mid
+     || packet.token_len != obs->token_len
+     || memcmp(packet.token, obs->token, obs->token_len) != 0
+     || !coap_get_header_observe(&packet, &observe)
+     || observe != ((obs->obs_counter - 1) & 0xffffff)
+     || packet.type != (observe % COAP_OBSERVE_REFRESH_INTERVAL == 0 ?
+                        COAP_TYPE_CON : COAP_TYPE_NON)
+     || coap_get_payload(&packet, &payload) != strlen(expected)
+     || memcmp(payload, expected, strlen(expected)) != 0) {
+    printf("bad notification to port %u\n", uip_ntohs(UIP_UDP_BUF->destport));
+    errors++;
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+static void
+add_observer(int i)
+{
+  static coap_packet_t request, response;
+  uint8_t token[4] = { 0xb0, 0x0b, i >> 8, i };
+
+  uip_create_linklocal_allnodes_mcast(&UIP_IP_BUF->srcipaddr);
+  UIP_UDP_BUF->srcport = UIP_HTONS(BASE_PORT + i);
+
+  coap_init_message(&request, COAP_TYPE_CON, COAP_GET, 0);
+  coap_set_header_uri_path(&request, res_sensor.url);
+  coap_set_header_observe(&request, 0);
+  coap_set_token(&request, token, sizeof(token));
+  coap_init_message(&response, COAP_TYPE_ACK, CONTENT_2_05, 0);
+  coap_observe_handler(&res_sensor, &request, &response);
+  if(response.code != CONTENT_2_05) {
+    printf("observer %d not added\n", i);
+    errors++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Drops the CON notifications left open, as if all had been acknowledged */
+static void
+clear_transactions(void)
+{
+  coap_observer_t *obs;
+  coap_transaction_t *t;
+
+  for(obs = list_head(coap_get_observers()); obs != NULL; obs = obs->next) {
+    if((t = coap_get_transaction_by_mid(obs->last_mid)) != NULL) {
+      coap_clear_transaction(t);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+change(void)
+{
+  value++;
+  coap_notify_observers(&res_sensor);
+  clear_transactions();
+}
+/*---------------------------------------------------------------------------*/
+static void
+expect(const char *what, int n, unsigned long messages, unsigned long calls)
+{
+  if(received != messages || handler_calls != calls) {
+    printf("%s n=%d: %lu notifications, %lu handler calls\n",
+           what, n, received, handler_calls);
+    errors++;
+  }
+  received = 0;
+  handler_calls = 0;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(observe_bench_process, ev, data)
+{
+#if COAP_OBSERVE_MIN_INTERVAL
+  static struct etimer et;
+#endif /* COAP_OBSERVE_MIN_INTERVAL */
+  static unsigned long t0;
+  static int c, n, r, added;
+
+  PROCESS_BEGIN();
+
+  printf("Observe benchmark (minimum interval %u ticks)\n",
+         (unsigned)COAP_OBSERVE_MIN_INTERVAL);
+
+  rest_init_engine();
+  rest_activate_resource(&res_sensor, "sensor");
+  tcpip_set_outputfunc(capture);
+
+  added = 0;
+  for(c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+    n = counts[c];
+    for(; added < n; added++) {
+      add_observer(added);
+    }
+
+#if COAP_OBSERVE_MIN_INTERVAL
+    /* once the interval has passed, the first change of a burst is sent
+       at once and the others are coalesced into one later notification */
+    etimer_set(&et, COAP_OBSERVE_MIN_INTERVAL + 1);
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+    checking = 1;
+    received = handler_calls = 0;
+    for(r = 0; r < BURST; r++) {
+      change();
+    }
+    expect("burst", n, n, 1);
+    etimer_set(&et, 2 * COAP_OBSERVE_MIN_INTERVAL);
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+    clear_transactions();
+    expect("coalesced", n, n, 1);
+    checking = 0;
+
+    etimer_set(&et, COAP_OBSERVE_MIN_INTERVAL + 1);
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+    t0 = usec_now();
+    for(r = 0; r < ROUNDS; r++) {
+      change();
+    }
+    print_result("burst", n, usec_now() - t0, ROUNDS);
+    etimer_set(&et, 2 * COAP_OBSERVE_MIN_INTERVAL);
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&et));
+    clear_transactions();
+    /* a slow run may outlast the interval: just check that changes
+       were coalesced and that every rendering went to all observers */
+    if(handler_calls < 2 || handler_calls >= ROUNDS) {
+      expect("burst", n, 2 * n, 2);
+    } else {
+      expect("burst", n, handler_calls * n, handler_calls);
+    }
+#else
+    checking = 1;
+    received = handler_calls = 0;
+    for(r = 0; r < COAP_OBSERVE_REFRESH_INTERVAL; r++) {
+      change();
+    }
+    expect("notify", n, COAP_OBSERVE_REFRESH_INTERVAL * n,
+           COAP_OBSERVE_REFRESH_INTERVAL);
+    checking = 0;
+
+    t0 = usec_now();
+    for(r = 0; r < ROUNDS; r++) {
+      change();
+    }
+    print_result("notify", n, usec_now() - t0, ROUNDS);
+    expect("notify", n, ROUNDS * n, ROUNDS);
+#endif /* COAP_OBSERVE_MIN_INTERVAL */
+  }
+
+  printf("Observe benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
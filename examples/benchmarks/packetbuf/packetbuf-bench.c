@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of packetbuf header handling: time to frame an
+ *         outgoing packet, to parse and reframe a packet for the next
+ *         hop, and to push four small headers as Chameleon does, with
+ *         checks that the payload and frame survive each of them.
+ */
+
+#include "contiki.h"
+#include "net/packetbuf.h"
+#include "net/netstack.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ROUNDS          200000
+#define PUSH_LEN        16
+
+PROCESS(packetbuf_bench_process, "Packetbuf benchmark");
+AUTOSTART_PROCESSES(&packetbuf_bench_process);
+
+static uint8_t payload[PACKETBUF_SIZE];
+static uint8_t frame[PACKETBUF_SIZE];
+static int frame_len;
+static linkaddr_t receiver = { { 1, 2, 3, 4, 5, 6, 7, 8 } };
+/*---------------------------------------------------------------------------*/
+/* Puts a payload of len bytes into packetbuf and frames it */
+static int
+frame_payload(int len)
+{
+  packetbuf_clear();
+  memcpy(packetbuf_dataptr(), payload, len);
+  packetbuf_set_datalen(len);
+  packetbuf_set_addr(PACKETBUF_ADDR_SENDER, &linkaddr_node_addr);
+  packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, &receiver);
+  packetbuf_set_attr(PACKETBUF_ATTR_FRAME_TYPE, FRAME802154_DATAFRAME);
+  return NETSTACK_FRAMER.create();
+}
+/*---------------------------------------------------------------------------*/
+/* Receives the frame, and frames its payload again for the next hop */
+static int
+forward(void)
+{
+  packetbuf_copyfrom(frame, frame_len);
+  if(NETSTACK_FRAMER.parse() < 0) {
+    return -1;
+  }
+  packetbuf_compact();
+  return NETSTACK_FRAMER.create();
+}
+/*---------------------------------------------------------------------------*/
+static int
+push(int len)
+{
+  int i;
+
+  packetbuf_copyfrom(payload, len);
+  for(i = 0; i < 4; i++) {
+    if(!packetbuf_hdralloc(PUSH_LEN)) {
+      return 0;
+    }
+    memset(packetbuf_hdrptr(), i, PUSH_LEN);
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+check(int len)
+{
+  uint8_t copy[PACKETBUF_SIZE];
+  int errors, hdr, i;
+
+  errors = 0;
+
+  hdr = frame_payload(len);
+  if(hdr <= 0 || packetbuf_totlen() != hdr + len ||
+     memcmp(packetbuf_dataptr(), payload, len) != 0) {
+    printf("bad frame, length %d\n", len);
+    errors++;
+  }
+  frame_len = packetbuf_copyto(frame);
+
+  if(forward() != hdr) {
+    printf("bad forward, length %d\n", len);
+    errors++;
+  }
+  if(packetbuf_copyto(copy) != frame_len ||
+     memcmp(copy, frame, frame_len) != 0) {
+    printf("forwarded frame differs, length %d\n", len);
+    errors++;
+  }
+
+  if(len + 4 * PUSH_LEN <= PACKETBUF_SIZE) {
+    if(!push(len) || packetbuf_totlen() != len + 4 * PUSH_LEN) {
+      printf("bad push, length %d\n", len);
+      errors++;
+    }
+    packetbuf_copyto(copy);
+    for(i = 0; i < 4 * PUSH_LEN; i++) {
+      if(copy[i] != 3 - i / PUSH_LEN) {
+        printf("bad pushed header, length %d\n", len);
+        errors++;
+        break;
+      }
+    }
+    if(memcmp(copy + 4 * PUSH_LEN, payload, len) != 0) {
+      printf("bad pushed payload, length %d\n", len);
+      errors++;
+    }
+  }
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+static void
+bench(int len)
+{
+  unsigned long t0;
+  int i;
+
+  t0 = usec_now();
+  for(i = 0; i < ROUNDS; i++) {
+    frame_payload(len);
+  }
+  print_result("frame", len, usec_now() - t0, ROUNDS);
+
+  frame_payload(len);
+  frame_len = packetbuf_copyto(frame);
+  t0 = usec_now();
+  for(i = 0; i < ROUNDS; i++) {
+    forward();
+  }
+  print_result("forward", len, usec_now() - t0, ROUNDS);
+
+  t0 = usec_now();
+  for(i = 0; i < ROUNDS; i++) {
+    push(len);
+  }
+  print_result("push4", len, usec_now() - t0, ROUNDS);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(packetbuf_bench_process, ev, data)
+{
+  int errors, len;
+
+  PROCESS_BEGIN();
+
+  for(len = 0; len < PACKETBUF_SIZE; len++) {
+    payload[len] = len * 13 + 1;
+  }
+
+  errors = 0;
+  for(len = 0; len <= PACKETBUF_SIZE - 40; len++) {
+    errors += check(len);
+  }
+
+  bench(20);
+  bench(60);
+
+  printf("Packetbuf benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
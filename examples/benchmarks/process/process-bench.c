@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the process scheduler: cost of delivering a
+ *         poll with many idle processes, latency of an event to a
+ *         high-priority process queued behind bulk events, and the
+ *         event queue overflow counters. Build with
+ *         DEFINES=PROCESS_CONF_PRIORITY_LEVELS=2 to use priorities.
+ */
+
+#include "contiki.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_IDLE    100
+#define POLL_ROUNDS 1000
+#define BULK_EVENTS 20
+
+PROCESS(process_bench_process, "Process benchmark");
+PROCESS(target_process, "Target");
+PROCESS(idle_process, "Idle");
+AUTOSTART_PROCESSES(&process_bench_process);
+
+static struct process idle[NUM_IDLE];
+static int polls, events;
+static process_event_t bench_event;
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(idle_process, ev, data)
+{
+  PROCESS_BEGIN();
+  while(1) {
+    PROCESS_YIELD();
+  }
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(target_process, ev, data)
+{
+  PROCESS_POLLHANDLER(polls++);
+
+  PROCESS_BEGIN();
+  while(1) {
+    PROCESS_YIELD();
+    if(ev == bench_event) {
+      events++;
+    }
+  }
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+drain(void)
+{
+  int i;
+
+  for(i = 0; i < 1000 && process_nevents() > 0; i++) {
+    process_run();
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(process_bench_process, ev, data)
+{
+  static int i, runs, errors;
+  static unsigned long t0;
+#if PROCESS_CONF_STATS
+  static unsigned short overflows;
+#endif
+
+  PROCESS_BEGIN();
+
+  printf("Process benchmark (%d priority levels)\n", PROCESS_PRIORITY_LEVELS);
+
+  bench_event = process_alloc_event();
+  for(i = 0; i < NUM_IDLE; i++) {
+    idle[i] = idle_process;
+    process_start(&idle[i], NULL);
+  }
+  process_set_priority(&target_process, PROCESS_PRIORITY_HIGH);
+  process_start(&target_process, NULL);
+
+  /* Poll the target process with NUM_IDLE idle processes around. The
+     scheduler is run from here, which is safe as long as no events
+     are posted to this process meanwhile. */
+  drain();
+  t0 = 0;
+  for(i = 0; i < POLL_ROUNDS; i++) {
+    process_poll(&target_process);
+    t0 -= usec_now();
+    process_run();
+    t0 += usec_now();
+  }
+  if(polls != POLL_ROUNDS) {
+    errors++;
+  }
+  printf("poll     %d processes %6lu ns/poll\n", NUM_IDLE + 3,
+         t0 * 1000UL / POLL_ROUNDS);
+
+  /* Queue bulk events for an idle process ahead of one event for the
+     target process, and count scheduler runs until it is delivered. */
+  drain();
+  for(i = 0; i < BULK_EVENTS; i++) {
+    process_post(&idle[i % NUM_IDLE], bench_event, NULL);
+  }
+  process_post(&target_process, bench_event, NULL);
+  for(runs = 0; events == 0 && runs < 1000; runs++) {
+    process_run();
+  }
+  printf("latency  %d queued events: delivered after %d runs\n",
+         BULK_EVENTS, runs);
+
+#if PROCESS_CONF_STATS
+  /* Overflow the event queue of the normal priority level. */
+  drain();
+  overflows = process_overflows[PROCESS_PRIORITY_NORMAL];
+  for(i = 0; i < PROCESS_CONF_NUMEVENTS + 5; i++) {
+    process_post(&idle[0], bench_event, NULL);
+  }
+  overflows = process_overflows[PROCESS_PRIORITY_NORMAL] - overflows;
+  printf("overflow %u events dropped, max %u events queued\n",
+         overflows, process_maxevents);
+  if(overflows != 5) {
+    errors++;
+  }
+  drain();
+#endif /* PROCESS_CONF_STATS */
+
+  printf("Process benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of REST engine dispatch: time to find and call the
+ *         resource for a request with 10, 100 and 500 resources with
+ *         LWM2M-style paths such as "3302/1/5703", and for a path that
+ *         does not exist. The per-resource counters check that every
+ *         request reached the right resource, and a few parent
+ *         resources check the sub-resource rules. Build with
+ *         DEFINES=REST_CONF_PATH_INDEX_NODES=0 to compare with
+ *         dispatch by URL comparison.
+ */
+
+#include "contiki.h"
+#include "er-coap.h"
+#include "lib/random.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_RESOURCES 500
+#define ROUNDS        200000
+
+static resource_t resources[MAX_RESOURCES];
+static char paths[MAX_RESOURCES][16];
+static const int counts[] = { 10, 100, 500 };
+static int errors;
+
+static void get_handler(void *request, void *response, uint8_t *buffer,
+                        uint16_t preferred_size, int32_t *offset);
+
+PARENT_RESOURCE(res_parent_first, NULL, get_handler, NULL, NULL, NULL);
+RESOURCE(res_child_late, NULL, get_handler, NULL, NULL, NULL);
+RESOURCE(res_child_first, NULL, get_handler, NULL, NULL, NULL);
+PARENT_RESOURCE(res_parent_late, NULL, get_handler, NULL, NULL, NULL);
+
+PROCESS(dispatch_bench_process, "REST dispatch benchmark");
+AUTOSTART_PROCESSES(&dispatch_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+get_handler(void *request, void *response, uint8_t *buffer,
+            uint16_t preferred_size, int32_t *offset)
+{
+}
+/*---------------------------------------------------------------------------*/
+static int
+dispatch(const char *path)
+{
+  static coap_packet_t request, response;
+  static uint8_t buffer[REST_MAX_CHUNK_SIZE];
+  int32_t offset = 0;
+
+  coap_init_message(&request, COAP_TYPE_CON, COAP_GET, 0);
+  coap_set_header_uri_path(&request, path);
+  coap_init_message(&response, COAP_TYPE_ACK, CONTENT_2_05, 0);
+  return rest_invoke_restful_service(&request, &response, buffer,
+                                     sizeof(buffer), &offset);
+}
+/*---------------------------------------------------------------------------*/
+static void
+expect(const char *path, resource_t *resource)
+{
+  uint32_t before = resource != NULL ? resource->stats.requests : 0;
+
+  if(dispatch(path) != (resource != NULL) ||
+     (resource != NULL && resource->stats.requests != before + 1)) {
+    printf("%s: dispatched to the wrong resource\n", path);
+    errors++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(dispatch_bench_process, ev, data)
+{
+  static unsigned long t0;
+  static int c, n, i, r, activated;
+  static uint32_t sum;
+
+  PROCESS_BEGIN();
+
+  printf("REST dispatch benchmark (%s)\n",
+         REST_PATH_INDEX_NODES ? "path index" : "URL comparison");
+
+  rest_init_engine();
+
+  /* The first resource activated for a request wins. */
+  rest_activate_resource(&res_parent_first, "parent");
+  rest_activate_resource(&res_child_late, "parent/child");
+  rest_activate_resource(&res_child_first, "late/child");
+  rest_activate_resource(&res_parent_late, "late");
+  expect("parent", &res_parent_first);
+  expect("parent/child", &res_parent_first);
+  expect("parent/child/x", &res_parent_first);
+  expect("parent/", &res_parent_first);
+  expect("parentx", NULL);
+  expect("late/child", &res_child_first);
+  expect("late/child/x", &res_parent_late);
+  expect("late/other", &res_parent_late);
+  expect("lat", NULL);
+
+  activated = 0;
+  for(c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+    n = counts[c];
+    for(; activated < n; activated++) {
+      i = activated;
+      snprintf(paths[i], sizeof(paths[i]), "%u/%u/%u",
+               3300 + i / 50, (i / 10) % 5, 5700 + i % 10);
+      resources[i].flags = NO_FLAGS;
+      resources[i].get_handler = get_handler;
+      rest_activate_resource(&resources[i], paths[i]);
+    }
+
+    for(i = 0; i < n; i++) {
+      memset(&resources[i].stats, 0, sizeof(resources[i].stats));
+    }
+    t0 = usec_now();
+    for(r = 0; r < ROUNDS; r++) {
+      dispatch(paths[random_rand() % n]);
+    }
+    print_result("dispatch", n, usec_now() - t0, ROUNDS);
+    for(i = 0, sum = 0; i < n; i++) {
+      sum += resources[i].stats.requests;
+      if(resources[i].stats.requests != resources[i].stats.latency[0] +
+         resources[i].stats.latency[1] + resources[i].stats.latency[2] +
+         resources[i].stats.latency[3] + resources[i].stats.latency[4] +
+         resources[i].stats.latency[5] + resources[i].stats.latency[6] +
+         resources[i].stats.latency[7]) {
+        errors++;
+      }
+    }
+    if(sum != ROUNDS) {
+      printf("dispatch n=%-5d %lu requests reached the resources\n",
+             n, (unsigned long)sum);
+      errors++;
+    }
+
+    t0 = usec_now();
+    for(r = 0; r < ROUNDS; r++) {
+      if(dispatch("9999/0/1")) {
+        errors++;
+      }
+    }
+    print_result("miss", n, usec_now() - t0, ROUNDS);
+
+    for(i = 0; i < n; i++) {
+      expect(paths[i], &resources[i]);
+    }
+  }
+
+  printf("REST dispatch benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
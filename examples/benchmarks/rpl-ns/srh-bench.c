@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of a RPL non-storing root: cost of building the source
+ *         routing header of a downward packet, for destinations spread
+ *         over trees of 100 and 1000 nodes. Also checks the headers
+ *         after nodes have moved. Build with
+ *         DEFINES=RPL_NS_CONF_HASH_SIZE=256,RPL_NS_CONF_SRH_CACHE_SIZE=1024
+ *         to measure the node index and the source route cache.
+ */
+
+#include "contiki.h"
+#include "net/ip/uip.h"
+#include "net/ipv6/uip-ds6.h"
+#include "net/rpl/rpl.h"
+#include "net/rpl/rpl-private.h"
+#include "net/rpl/rpl-ns.h"
+#include "lib/random.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define UIP_IP_BUF     ((struct uip_ip_hdr *)&uip_buf[UIP_LLH_LEN])
+#define UIP_RH_BUF     ((struct uip_routing_hdr *)&uip_buf[UIP_LLH_LEN + UIP_IPH_LEN])
+
+#define FANOUT         4
+#define PAYLOAD_LEN    32
+#define ROUNDS         100000
+
+static const int sizes[] = { 100, 1000 };
+static rpl_dag_t *dag;
+static uip_ipaddr_t root_addr;
+
+PROCESS(srh_bench_process, "SRH benchmark");
+AUTOSTART_PROCESSES(&srh_bench_process);
+/*---------------------------------------------------------------------------*/
+/* Node 0 is the root, node i > 0 has node parent_of[i] as parent */
+static uint16_t parent_of[1001];
+
+static void
+node_addr(uip_ipaddr_t *addr, int i)
+{
+  if(i == 0) {
+    uip_ipaddr_copy(addr, &root_addr);
+  } else {
+    uip_ip6addr(addr, 0xfd00, 0, 0, 0, 0x0212, 0x7400, 0x0001, i);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_parent(int i, int parent)
+{
+  uip_ipaddr_t child_addr, parent_addr;
+
+  parent_of[i] = parent;
+  node_addr(&child_addr, i);
+  node_addr(&parent_addr, parent);
+  rpl_ns_update_node(dag, &child_addr, &parent_addr, 0xffffffff);
+}
+/*---------------------------------------------------------------------------*/
+/* Run a packet to node i through the root and check the resulting
+ * next hop and source route length */
+static int
+send_down(int i)
+{
+  uip_ipaddr_t addr;
+  int hops, first;
+
+  memset(uip_buf, 0, UIP_LLH_LEN + UIP_IPH_LEN + PAYLOAD_LEN);
+  UIP_IP_BUF->vtc = 0x60;
+  UIP_IP_BUF->proto = UIP_PROTO_UDP;
+  UIP_IP_BUF->ttl = 64;
+  UIP_IP_BUF->len[1] = PAYLOAD_LEN;
+  uip_ipaddr_copy(&UIP_IP_BUF->srcipaddr, &root_addr);
+  node_addr(&UIP_IP_BUF->destipaddr, i);
+  uip_len = UIP_IPH_LEN + PAYLOAD_LEN;
+  uip_ext_len = 0;
+
+  if(!rpl_update_header()) {
+    return 0;
+  }
+
+  /* Find the node below the root and the number of hops to node i */
+  hops = 0;
+  for(first = i; parent_of[first] != 0; first = parent_of[first]) {
+    hops++;
+  }
+  node_addr(&addr, first);
+  if(!uip_ipaddr_cmp(&UIP_IP_BUF->destipaddr, &addr)) {
+    return 0;
+  }
+  if(hops == 0) {
+    return UIP_IP_BUF->proto == UIP_PROTO_UDP;
+  }
+  return UIP_IP_BUF->proto == UIP_PROTO_ROUTING &&
+    UIP_RH_BUF->seg_left == hops;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(srh_bench_process, ev, data)
+{
+  static int s, n, i, errors;
+  static long round;
+  static unsigned long t0;
+  uip_ipaddr_t prefix;
+
+  PROCESS_BEGIN();
+
+  printf("SRH benchmark (%d hash buckets, %d cached routes)\n",
+         RPL_NS_HASH_SIZE, RPL_NS_SRH_CACHE_SIZE);
+
+  uip_ip6addr(&prefix, 0xfd00, 0, 0, 0, 0, 0, 0, 0);
+  uip_ipaddr_copy(&root_addr, &prefix);
+  uip_ds6_set_addr_iid(&root_addr, &uip_lladdr);
+  uip_ds6_addr_add(&root_addr, 0, ADDR_MANUAL);
+  dag = rpl_set_root(RPL_DEFAULT_INSTANCE, &root_addr);
+  if(dag == NULL) {
+    printf("Failed to become root\n");
+    exit(EXIT_FAILURE);
+  }
+  rpl_set_prefix(dag, &prefix, 64);
+
+  n = 1;
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    /* Grow the tree to the next size, breadth first */
+    for(; n <= sizes[s]; n++) {
+      set_parent(n, (n - 1) / FANOUT);
+    }
+
+    t0 = usec_now();
+    for(round = 0; round < ROUNDS; round++) {
+      if(!send_down(1 + random_rand() % sizes[s])) {
+        errors++;
+      }
+    }
+    print_result("srh", sizes[s], usec_now() - t0, ROUNDS);
+  }
+
+  /* Move subtrees around, as DAOs with new parents do */
+  t0 = usec_now();
+  for(round = 0; round < ROUNDS; round++) {
+    if((round & 15) == 0) {
+      i = FANOUT + 1 + random_rand() % (n - FANOUT - 1);
+      /* Parents always have a lower number than their children, so
+         that no loops are created */
+      set_parent(i, random_rand() % i);
+    }
+    if(!send_down(1 + random_rand() % (n - 1))) {
+      errors++;
+    }
+  }
+  print_result("srh+dao", n - 1, usec_now() - t0, ROUNDS);
+
+  for(i = 1; i < n; i++) {
+    errors += !send_down(i);
+  }
+
+  printf("SRH benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the real-time timer module: timing jitter of
+ *         one to four periodic real-time tasks that share the rtimer,
+ *         and checks that tasks set while others are pending all run,
+ *         in deadline and priority order.
+ */
+
+#include "contiki.h"
+#include "sys/rtimer.h"
+
+#include "bench.h"
+
+#if !RTIMER_MULTIPLE_TASKS
+#error "rtimer-bench needs RTIMER_MULTIPLE_TASKS"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_USERS 4
+#define RUN_TIME  (CLOCK_SECOND * 2)
+
+struct user {
+  struct rtimer rt;
+  rtimer_clock_t period;
+  int fired;
+  unsigned long last;
+  unsigned long jitter_sum;
+  unsigned long jitter_max;
+};
+
+static struct user users[MAX_USERS];
+static const rtimer_clock_t periods[MAX_USERS] = { 5, 7, 11, 13 };
+static volatile int running;
+
+static struct rtimer order_tasks[4];
+static volatile int order[4];
+static volatile int order_len;
+
+static int errors;
+
+PROCESS(rtimer_bench_process, "Real-time timer benchmark");
+AUTOSTART_PROCESSES(&rtimer_bench_process);
+/*---------------------------------------------------------------------------*/
+static void
+periodic(struct rtimer *t, void *ptr)
+{
+  struct user *u = ptr;
+  unsigned long now, expected, jitter;
+
+  now = usec_now();
+  if(u->fired > 0) {
+    expected = u->period * 1000000UL / RTIMER_SECOND;
+    jitter = now - u->last > expected ?
+      now - u->last - expected : expected - (now - u->last);
+    u->jitter_sum += jitter;
+    if(jitter > u->jitter_max) {
+      u->jitter_max = jitter;
+    }
+  }
+  u->last = now;
+  u->fired++;
+  if(running) {
+    rtimer_set(t, RTIMER_TIME(t) + u->period, 1, periodic, u);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+record(struct rtimer *t, void *ptr)
+{
+  if(order_len < 4) {
+    order[order_len] = t - order_tasks;
+  }
+  order_len++;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(rtimer_bench_process, ev, data)
+{
+  static struct etimer et;
+  static int n, i, expected;
+  static unsigned long sum, max;
+  static int count;
+  rtimer_clock_t now;
+
+  PROCESS_BEGIN();
+
+  printf("Real-time timer benchmark\n");
+
+  for(n = 1; n <= MAX_USERS; n++) {
+    running = 1;
+    now = RTIMER_NOW();
+    for(i = 0; i < n; i++) {
+      memset(&users[i], 0, sizeof(users[i]));
+      users[i].period = periods[i];
+      rtimer_set(&users[i].rt, now + periods[i], 1, periodic, &users[i]);
+    }
+    etimer_set(&et, RUN_TIME);
+    PROCESS_WAIT_UNTIL(etimer_expired(&et));
+    running = 0;
+    /* Let the last callbacks run. */
+    etimer_set(&et, CLOCK_SECOND / 10);
+    PROCESS_WAIT_UNTIL(etimer_expired(&et));
+
+    sum = max = 0;
+    count = 0;
+    for(i = 0; i < n; i++) {
+      expected = RUN_TIME * RTIMER_SECOND / CLOCK_SECOND / periods[i];
+      if(users[i].fired < expected - 2 || users[i].fired > expected + 2) {
+        printf("task %d: %d callbacks, expected %d\n",
+               i, users[i].fired, expected);
+        errors++;
+      }
+      if(users[i].fired > 1) {
+        sum += users[i].jitter_sum;
+        count += users[i].fired - 1;
+      }
+      if(users[i].jitter_max > max) {
+        max = users[i].jitter_max;
+      }
+    }
+    printf("jitter   n=%-5d %8lu us mean %8lu us max\n",
+           n, count > 0 ? sum / count : 0, max);
+  }
+
+  /* Tasks set while another one is pending: the earlier deadline runs
+     first, the same deadline runs by priority, then in setting order. */
+  order_len = 0;
+  now = RTIMER_NOW();
+  RTIMER_SET_PRIORITY(&order_tasks[0], RTIMER_PRIORITY_DEFAULT);
+  RTIMER_SET_PRIORITY(&order_tasks[1], RTIMER_PRIORITY_DEFAULT);
+  RTIMER_SET_PRIORITY(&order_tasks[2], RTIMER_PRIORITY_HIGH);
+  RTIMER_SET_PRIORITY(&order_tasks[3], RTIMER_PRIORITY_DEFAULT);
+  rtimer_set(&order_tasks[0], now + 50, 1, record, NULL);
+  rtimer_set(&order_tasks[1], now + 20, 1, record, NULL);
+  rtimer_set(&order_tasks[2], now + 20, 1, record, NULL);
+  /* Moved from later to earlier while pending. */
+  rtimer_set(&order_tasks[3], now + 200, 1, record, NULL);
+  rtimer_set(&order_tasks[3], now + 30, 1, record, NULL);
+  etimer_set(&et, CLOCK_SECOND / 2);
+  PROCESS_WAIT_UNTIL(etimer_expired(&et));
+  if(order_len != 4 || order[0] != 2 || order[1] != 1 ||
+     order[2] != 3 || order[3] != 0) {
+    printf("order: %d tasks ran, expected 4 in order 2 1 3 0\n", order_len);
+    errors++;
+  }
+
+  printf("Real-time timer benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
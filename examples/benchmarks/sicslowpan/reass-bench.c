@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of 6lowpan fragment reassembly: cost per fragment of
+ *         reassembling 1280-byte packets from four senders whose
+ *         fragments are interleaved, and checks of the reassembled
+ *         data and of the duplicate, drop and timeout counters.
+ */
+
+#include "contiki.h"
+#include "net/ip/uip.h"
+#include "net/ipv6/sicslowpan.h"
+#include "net/netstack.h"
+#include "net/packetbuf.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define UIP_IP_BUF      ((struct uip_ip_hdr *)&uip_buf[UIP_LLH_LEN])
+
+#define PACKET_LEN      1280
+#define FIRST_LEN       96   /* Uncompressed bytes in the first fragment */
+#define FRAG_LEN        96   /* Bytes in the following fragments */
+#define SENDERS         4
+#define PACKETS         8000
+
+PROCESS(reass_bench_process, "Reassembly benchmark");
+AUTOSTART_PROCESSES(&reass_bench_process);
+/*---------------------------------------------------------------------------*/
+static uint8_t
+pattern(int sender, uint16_t offset)
+{
+  return (offset * 7 + sender) & 0xff;
+}
+/*---------------------------------------------------------------------------*/
+/* The frames of the packets of each sender, without tags */
+#define FRAGMENTS (1 + (PACKET_LEN - FIRST_LEN + FRAG_LEN - 1) / FRAG_LEN)
+static uint8_t frames[SENDERS][FRAGMENTS][SICSLOWPAN_FRAG1_HDR_LEN +
+                                          SICSLOWPAN_IPV6_HDR_LEN + FIRST_LEN];
+static uint8_t frame_len[SENDERS][FRAGMENTS];
+
+static void
+build_frames(void)
+{
+  uint8_t *ptr;
+  struct uip_ip_hdr *ip;
+  int sender, frag, hdr_len, len, i;
+  uint16_t offset;
+
+  for(sender = 0; sender < SENDERS; sender++) {
+    for(frag = 0; frag < FRAGMENTS; frag++) {
+      ptr = frames[sender][frag];
+      if(frag == 0) {
+        ptr[0] = SICSLOWPAN_DISPATCH_FRAG1 | (PACKET_LEN >> 8);
+        ptr[1] = PACKET_LEN & 0xff;
+        ptr[SICSLOWPAN_FRAG1_HDR_LEN] = SICSLOWPAN_DISPATCH_IPV6;
+        hdr_len = SICSLOWPAN_FRAG1_HDR_LEN + SICSLOWPAN_IPV6_HDR_LEN;
+        ip = (struct uip_ip_hdr *)(ptr + hdr_len);
+        ip->vtc = 0x60;
+        ip->len[0] = (PACKET_LEN - UIP_IPH_LEN) >> 8;
+        ip->len[1] = (PACKET_LEN - UIP_IPH_LEN) & 0xff;
+        ip->proto = UIP_PROTO_UDP;
+        ip->ttl = 64;
+        uip_ip6addr(&ip->srcipaddr, 0xfe80, 0, 0, 0, 0x0200, 0, 0, sender + 1);
+        /* A group we are not a member of, so the packet is dropped quietly */
+        uip_ip6addr(&ip->destipaddr, 0xff02, 0, 0, 0, 0, 0, 0, 0x1234);
+        hdr_len += UIP_IPH_LEN;
+        offset = UIP_IPH_LEN;
+        len = FIRST_LEN - UIP_IPH_LEN;
+      } else {
+        offset = FIRST_LEN + (frag - 1) * FRAG_LEN;
+        ptr[0] = SICSLOWPAN_DISPATCH_FRAGN | (PACKET_LEN >> 8);
+        ptr[1] = PACKET_LEN & 0xff;
+        ptr[4] = offset >> 3;
+        hdr_len = SICSLOWPAN_FRAGN_HDR_LEN;
+        len = MIN(FRAG_LEN, PACKET_LEN - offset);
+      }
+      for(i = 0; i < len; i++) {
+        ptr[hdr_len + i] = pattern(sender, offset + i);
+      }
+      frame_len[sender][frag] = hdr_len + len;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Pass fragment frag of packet tag from a sender to 6lowpan, as the MAC
+ * layer does */
+static void
+input_fragment(int sender, uint16_t tag, int frag)
+{
+  linkaddr_t addr;
+  uint8_t *ptr;
+
+  packetbuf_clear();
+  ptr = packetbuf_dataptr();
+  memcpy(ptr, frames[sender][frag], frame_len[sender][frag]);
+  ptr[2] = tag >> 8;
+  ptr[3] = tag & 0xff;
+  packetbuf_set_datalen(frame_len[sender][frag]);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.u8[LINKADDR_SIZE - 1] = sender + 1;
+  packetbuf_set_addr(PACKETBUF_ADDR_SENDER, &addr);
+  packetbuf_set_addr(PACKETBUF_ADDR_RECEIVER, &linkaddr_node_addr);
+
+  sicslowpan_driver.input();
+}
+/*---------------------------------------------------------------------------*/
+/* Check the payload of the last reassembled packet */
+static int
+check_packet(int sender)
+{
+  uint16_t i;
+
+  for(i = UIP_IPH_LEN; i < PACKET_LEN; i++) {
+    if(((uint8_t *)UIP_IP_BUF)[i] != pattern(sender, i)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Send one packet from each sender, with the fragments interleaved. Each
+ * fragment after the first is sent copies times. Returns the number of
+ * reassembled packets with wrong contents if check is set. */
+static int
+input_packets(uint16_t tag, int copies, int check)
+{
+  int frag, s, c, errors;
+  uip_stats_t reassembled;
+
+  errors = 0;
+  for(s = 0; s < SENDERS; s++) {
+    input_fragment(s, tag + s, 0);
+  }
+  for(frag = 1; frag < FRAGMENTS; frag++) {
+    for(s = 0; s < SENDERS; s++) {
+      for(c = 0; c < copies; c++) {
+        reassembled = sicslowpan_reass_stats.reassembled;
+        input_fragment(s, tag + s, frag);
+        if(check && sicslowpan_reass_stats.reassembled != reassembled &&
+           !check_packet(s)) {
+          errors++;
+        }
+      }
+    }
+  }
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(reass_bench_process, ev, data)
+{
+  static struct etimer et;
+  static int errors;
+  static uint16_t tag;
+  static unsigned long t0;
+  static uip_stats_t expected;
+  int i;
+
+  PROCESS_BEGIN();
+
+  printf("Reassembly benchmark\n");
+
+  build_frames();
+
+  t0 = usec_now();
+  for(i = 0; i < PACKETS / SENDERS; i++) {
+    errors += input_packets(tag, 1, 0);
+    tag += SENDERS;
+  }
+  print_result("fragment", PACKETS, usec_now() - t0, (long)PACKETS * FRAGMENTS);
+  expected = PACKETS;
+  errors += input_packets(tag, 1, 1);
+  tag += SENDERS;
+  expected += SENDERS;
+  if(sicslowpan_reass_stats.reassembled != expected) {
+    printf("reassembled %u of %u packets\n",
+           sicslowpan_reass_stats.reassembled, expected);
+    errors++;
+  }
+
+  /* Retransmitted fragments are ignored. The copy of the last fragment
+     arrives after reassembly and is dropped as unknown. */
+  errors += input_packets(tag, 2, 1);
+  tag += SENDERS;
+  expected += SENDERS;
+  if(sicslowpan_reass_stats.reassembled != expected ||
+     sicslowpan_reass_stats.duplicates != SENDERS * (FRAGMENTS - 2) ||
+     sicslowpan_reass_stats.drop != SENDERS) {
+    printf("duplicates %u drops %u\n", sicslowpan_reass_stats.duplicates,
+           sicslowpan_reass_stats.drop);
+    errors++;
+  }
+
+  /* Fragments of an unknown packet are dropped */
+  input_fragment(0, tag++, 1);
+  if(sicslowpan_reass_stats.drop != SENDERS + 1) {
+    errors++;
+  }
+
+  /* An incomplete packet times out, and its context is reused */
+  input_fragment(0, tag++, 0);
+  etimer_set(&et, SICSLOWPAN_REASS_MAXAGE * CLOCK_SECOND / 16 + 1);
+  PROCESS_WAIT_UNTIL(etimer_expired(&et));
+  errors += input_packets(tag, 1, 1);
+  expected += SENDERS;
+  if(sicslowpan_reass_stats.reassembled != expected ||
+     sicslowpan_reass_stats.timeouts != 1) {
+    printf("timeouts %u\n", sicslowpan_reass_stats.timeouts);
+    errors++;
+  }
+
+  printf("Reassembly benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
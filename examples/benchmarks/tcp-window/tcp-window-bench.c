@@ -0,0 +1,497 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the uIP TCP send window: a process sends a byte
+ *         stream over a connection to a simulated peer across a link
+ *         with a fixed delay, with and without segment loss. Reports the
+ *         throughput in simulated time and the processing time per
+ *         segment, and checks that the peer receives the whole stream
+ *         in order before the FIN. With a send window, also checks that
+ *         a FIN from the peer and data arriving after the node closed
+ *         do not cut off the stream or the data.
+ */
+
+#include "contiki.h"
+#include "net/ip/uip.h"
+#include "net/ipv6/uip-ds6.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STREAM_LEN      65536UL
+#define LISTEN_PORT     5001
+#define PEER_WINDOW     8192
+#define LINK_DELAY_MS   10      /* One way */
+#define TIMER_MS        500     /* The uIP periodic TCP timer */
+#define LIMIT_MS        600000UL
+#define QUEUE_LEN       64
+#define PEER_DATA_LEN   100
+
+#define TCP_FIN         0x01
+#define TCP_SYN         0x02
+#define TCP_ACK         0x10
+
+#define IP_BUF          ((struct uip_ip_hdr *)&uip_buf[UIP_LLH_LEN])
+#define TCP_BUF         ((struct uip_tcp_hdr *)&uip_buf[UIP_LLH_LEN + UIP_IPH_LEN])
+#define TCP_DATA        (&uip_buf[UIP_LLH_LEN + UIP_IPH_LEN + \
+                                  ((TCP_BUF->tcpoffset >> 4) << 2)])
+
+PROCESS(tcp_window_bench_process, "TCP window benchmark");
+PROCESS(sender_process, "TCP sender");
+AUTOSTART_PROCESSES(&tcp_window_bench_process);
+
+/* What the peer sends besides ACKs */
+enum {
+  PEER_ACKS_ONLY,
+  PEER_FIN_MIDWAY,      /* Data and a FIN halfway through the stream */
+  PEER_DATA_ON_CLOSE    /* Data once the sender has closed */
+};
+
+/* A segment or an ACK on its way across the link */
+struct packet {
+  unsigned long arrival;
+  uint32_t seq;
+  uint16_t len;
+  uint8_t flags;
+};
+
+struct queue {
+  struct packet packets[QUEUE_LEN];
+  int first;
+  int count;
+};
+
+static uip_ipaddr_t peer;
+static uint16_t peer_port = 40000;
+static struct uip_conn *conn;
+static unsigned long now;
+static struct queue to_peer, to_node;
+
+/* Peer state */
+static uint32_t node_iss;
+static uint32_t peer_seq;
+static uint32_t peer_rcv_nxt;
+static uint32_t stream_end;
+static int fin_received;
+static int peer_sent;
+
+static int loss_every;
+static unsigned long data_segments;
+static unsigned long lost;
+static unsigned long segments;
+static unsigned long next_timer;
+static int errors;
+
+/* Sender state */
+static uint32_t send_offset;
+static uint16_t send_last;
+static int send_closed;
+static uint16_t recv_len;
+static int recv_closed;
+/*---------------------------------------------------------------------------*/
+static uint8_t
+pattern(uint32_t offset)
+{
+  return (offset * 7 + (offset >> 8)) & 0xff;
+}
+/*---------------------------------------------------------------------------*/
+static uint32_t
+get32(const uint8_t *p)
+{
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+    ((uint32_t)p[2] << 8) | p[3];
+}
+/*---------------------------------------------------------------------------*/
+static void
+put32(uint8_t *p, uint32_t v)
+{
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+/*---------------------------------------------------------------------------*/
+/* A classic uIP sender: regenerates the last segment on UIP_REXMIT and
+   sends the next one once the last has been acknowledged */
+static void
+sender_appcall(void)
+{
+  uint16_t n, i;
+
+  if(uip_connected()) {
+    send_offset = 0;
+    send_last = 0;
+    send_closed = 0;
+    recv_len = 0;
+    recv_closed = 0;
+  }
+  if(uip_newdata()) {
+    recv_len += uip_datalen();
+  }
+  if(uip_closed()) {
+    recv_closed = 1;
+    return;
+  }
+  if(uip_acked()) {
+    send_offset += send_last;
+    send_last = 0;
+  }
+  if(uip_rexmit() ||
+     (send_last == 0 && (uip_connected() || uip_acked() || uip_poll()))) {
+    if(send_last == 0) {
+      if(send_offset == STREAM_LEN) {
+        if(!send_closed) {
+          send_closed = 1;
+          uip_close();
+        }
+        return;
+      }
+      send_last = MIN(uip_mss(), STREAM_LEN - send_offset);
+    }
+    n = send_last;
+    for(i = 0; i < n; i++) {
+      ((uint8_t *)uip_appdata)[i] = pattern(send_offset + i);
+    }
+    uip_send(uip_appdata, n);
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(sender_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  tcp_listen(UIP_HTONS(LISTEN_PORT));
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == tcpip_event);
+    sender_appcall();
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+static void
+enqueue(struct queue *q, uint32_t seq, uint16_t len, uint8_t flags)
+{
+  struct packet *p;
+
+  if(q->count == QUEUE_LEN) {
+    lost++;
+    return;
+  }
+  p = &q->packets[(q->first + q->count++) % QUEUE_LEN];
+  p->arrival = now + LINK_DELAY_MS;
+  p->seq = seq;
+  p->len = len;
+  p->flags = flags;
+}
+/*---------------------------------------------------------------------------*/
+static struct packet *
+dequeue(struct queue *q)
+{
+  struct packet *p;
+
+  if(q->count == 0 || q->packets[q->first].arrival > now) {
+    return NULL;
+  }
+  p = &q->packets[q->first];
+  q->first = (q->first + 1) % QUEUE_LEN;
+  q->count--;
+  return p;
+}
+/*---------------------------------------------------------------------------*/
+/* Checks the segment uIP left in uip_buf, if any, and puts it on the
+   link to the peer unless it is to be lost */
+static void
+capture(void)
+{
+  uint32_t seq, offset;
+  uint16_t len, i;
+
+  if(uip_len == 0) {
+    return;
+  }
+  if(IP_BUF->proto != UIP_PROTO_TCP) {
+    uip_clear_buf();
+    return;
+  }
+  seq = get32(TCP_BUF->seqno);
+  len = uip_len - UIP_IPH_LEN - ((TCP_BUF->tcpoffset >> 4) << 2);
+  if(len > 0) {
+    offset = seq - node_iss - 1;
+    for(i = 0; i < len; i++) {
+      if(TCP_DATA[i] != pattern(offset + i)) {
+        printf("bad data at %lu\n", (unsigned long)offset + i);
+        errors++;
+        break;
+      }
+    }
+    if(loss_every > 0 && ++data_segments % loss_every == 0) {
+      lost++;
+      uip_clear_buf();
+      return;
+    }
+  }
+  enqueue(&to_peer, seq, len, TCP_BUF->flags);
+  uip_clear_buf();
+}
+/*---------------------------------------------------------------------------*/
+/* Lets uIP send what it has asked to be polled for, as tcpip_process
+   would */
+static void
+flush(void)
+{
+  int i;
+
+  if(conn == NULL) {
+    return;
+  }
+  for(i = 0; i < QUEUE_LEN; i++) {
+    uip_poll_conn(conn);
+    if(uip_len == 0) {
+      break;
+    }
+    capture();
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+node_input(uint8_t flags, uint32_t ack, int mss_option, uint16_t len)
+{
+  uint16_t hlen;
+
+  hlen = UIP_TCPH_LEN + (mss_option ? 4 : 0);
+  memset(uip_buf, 0, UIP_LLH_LEN + UIP_IPH_LEN + hlen);
+  IP_BUF->vtc = 0x60;
+  IP_BUF->len[0] = (hlen + len) >> 8;
+  IP_BUF->len[1] = (hlen + len) & 0xff;
+  IP_BUF->proto = UIP_PROTO_TCP;
+  IP_BUF->ttl = 64;
+  uip_ipaddr_copy(&IP_BUF->srcipaddr, &peer);
+  uip_ipaddr_copy(&IP_BUF->destipaddr,
+                  &uip_ds6_get_link_local(-1)->ipaddr);
+  uip_len = UIP_IPH_LEN + hlen + len;
+  uip_ext_len = 0;
+
+  TCP_BUF->srcport = UIP_HTONS(peer_port);
+  TCP_BUF->destport = UIP_HTONS(LISTEN_PORT);
+  put32(TCP_BUF->seqno, peer_seq);
+  put32(TCP_BUF->ackno, ack);
+  TCP_BUF->tcpoffset = (hlen / 4) << 4;
+  TCP_BUF->flags = flags;
+  TCP_BUF->wnd[0] = PEER_WINDOW >> 8;
+  TCP_BUF->wnd[1] = PEER_WINDOW & 0xff;
+  if(mss_option) {
+    TCP_BUF->optdata[0] = 2;
+    TCP_BUF->optdata[1] = 4;
+    TCP_BUF->optdata[2] = UIP_TCP_MSS >> 8;
+    TCP_BUF->optdata[3] = UIP_TCP_MSS & 0xff;
+  }
+  memset(TCP_DATA, 0x5a, len);
+  TCP_BUF->tcpchksum = ~uip_tcpchksum();
+
+  uip_input();
+  capture();
+  flush();
+}
+/*---------------------------------------------------------------------------*/
+/* The peer takes segments in order only, and ACKs every one */
+static void
+peer_input(struct packet *p)
+{
+  if(p->len == 0 && !(p->flags & TCP_FIN)) {
+    return;
+  }
+  if(p->seq == peer_rcv_nxt) {
+    peer_rcv_nxt += p->len;
+    if(p->flags & TCP_FIN) {
+      if(peer_rcv_nxt - node_iss - 1 != stream_end) {
+        printf("FIN after %lu bytes\n",
+               (unsigned long)(peer_rcv_nxt - node_iss - 1));
+        errors++;
+      }
+      peer_rcv_nxt++;
+      fin_received = 1;
+    }
+  }
+  enqueue(&to_node, 0, 0, TCP_ACK);
+  to_node.packets[(to_node.first + to_node.count - 1) % QUEUE_LEN].seq =
+    peer_rcv_nxt;
+}
+/*---------------------------------------------------------------------------*/
+/* Sends data from the peer straight to the node, with a FIN if asked */
+static void
+peer_send(uint8_t flags)
+{
+  node_input(flags | TCP_ACK, peer_rcv_nxt, 0, PEER_DATA_LEN);
+  peer_seq += PEER_DATA_LEN + ((flags & TCP_FIN) ? 1 : 0);
+  peer_sent = 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+peer_connect(void)
+{
+  peer_port++;
+  peer_seq = 1000;
+  memset(&to_peer, 0, sizeof(to_peer));
+  memset(&to_node, 0, sizeof(to_node));
+
+  conn = NULL;
+  now = 0;
+  node_input(TCP_SYN, 0, 1, 0);
+  conn = uip_conn;
+  if(conn == NULL || to_peer.count != 1 ||
+     !(to_peer.packets[to_peer.first].flags & TCP_SYN)) {
+    printf("no SYNACK\n");
+    return 0;
+  }
+  node_iss = to_peer.packets[to_peer.first].seq;
+  to_peer.count = 0;
+  peer_seq++;
+  peer_rcv_nxt = node_iss + 1;
+  stream_end = STREAM_LEN;
+  fin_received = 0;
+  peer_sent = 0;
+
+  /* The sender starts on UIP_CONNECTED */
+  node_input(TCP_ACK, node_iss + 1, 0, 0);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Moves the simulation on by a millisecond */
+static void
+step(void)
+{
+  struct packet *p;
+
+  while((p = dequeue(&to_peer)) != NULL) {
+    if(p->len > 0) {
+      segments++;
+    }
+    peer_input(p);
+  }
+  while((p = dequeue(&to_node)) != NULL) {
+    node_input(TCP_ACK, p->seq, 0, 0);
+  }
+  if(now == next_timer) {
+    uip_periodic_conn(conn);
+    capture();
+    flush();
+    next_timer += TIMER_MS;
+  }
+  now++;
+}
+/*---------------------------------------------------------------------------*/
+static void
+bench(const char *name, int loss, int peer)
+{
+  unsigned long t0, usec;
+
+  loss_every = loss;
+  data_segments = 0;
+  lost = 0;
+  if(!peer_connect()) {
+    errors++;
+    return;
+  }
+
+  t0 = usec_now();
+  next_timer = TIMER_MS;
+  segments = 0;
+  while(!fin_received && now < LIMIT_MS) {
+    if(!peer_sent && peer == PEER_FIN_MIDWAY &&
+       peer_rcv_nxt - node_iss - 1 >= STREAM_LEN / 2 && to_peer.count > 0) {
+      /* The FIN leaves segments on the link unacknowledged. The sender
+         stops when told of the close: the data it has handed to uIP
+         must still reach the peer before the FIN */
+      stream_end = send_offset + send_last;
+      peer_send(TCP_FIN);
+    } else if(!peer_sent && peer == PEER_DATA_ON_CLOSE && send_closed) {
+      peer_send(0);
+    }
+    step();
+  }
+  usec = usec_now() - t0;
+
+  if(!fin_received) {
+    printf("%s: stream not complete after %lu ms\n", name, now);
+    errors++;
+    return;
+  }
+  print_result(name, UIP_TCP_WINDOW_SEGMENTS, usec,
+               segments > 0 ? segments : 1);
+  printf("%-8s n=%-5d %8lu bytes/s, %lu segments lost\n", name,
+         UIP_TCP_WINDOW_SEGMENTS, stream_end * 1000UL / now, lost);
+
+  if(peer != PEER_ACKS_ONLY && recv_len != PEER_DATA_LEN) {
+    printf("%s: %u of %u bytes from the peer delivered\n", name,
+           recv_len, PEER_DATA_LEN);
+    errors++;
+  }
+  if(peer == PEER_FIN_MIDWAY) {
+    /* Let the peer's ACK of our FIN arrive */
+    while(to_node.count > 0) {
+      step();
+    }
+    if(!recv_closed || (conn->tcpstateflags & UIP_TS_MASK) != UIP_CLOSED) {
+      printf("%s: connection not closed\n", name);
+      errors++;
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(tcp_window_bench_process, ev, data)
+{
+  PROCESS_BEGIN();
+
+  uip_ip6addr(&peer, 0xfe80, 0, 0, 0, 0x0212, 0x7401, 1, 1);
+  process_start(&sender_process, NULL);
+
+  bench("tcp", 0, PEER_ACKS_ONLY);
+  bench("tcp-loss", 50, PEER_ACKS_ONLY);
+#if UIP_TCP_WINDOW_SEGMENTS > 1
+  /* uIP without a send window closes as soon as the peer does */
+  bench("peer-fin", 0, PEER_FIN_MIDWAY);
+  bench("closing", 0, PEER_DATA_ON_CLOSE);
+#endif /* UIP_TCP_WINDOW_SEGMENTS > 1 */
+
+  printf("TCP window benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the callback timer library: cost of setting
+ *         and stopping callback timers, and the time needed to call
+ *         back a burst of timers that expire together, with up to
+ *         4000 outstanding callback timers. Build with
+ *         DEFINES=CTIMER_CONF_HEAP=1 to measure the heap backend.
+ */
+
+#include "contiki.h"
+#include "lib/random.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_TIMERS 4000
+
+static struct ctimer timers[MAX_TIMERS];
+static const int sizes[] = { 100, 1000, 4000 };
+static int fired;
+static unsigned long first_fired, last_fired;
+static int errors;
+
+PROCESS(ctimer_bench_process, "Callback timer benchmark");
+AUTOSTART_PROCESSES(&ctimer_bench_process);
+/*---------------------------------------------------------------------------*/
+static clock_time_t
+far_interval(void)
+{
+  /* Far enough in the future to never expire during the benchmark. */
+  return CLOCK_SECOND * 3600 + random_rand() % (CLOCK_SECOND * 60);
+}
+/*---------------------------------------------------------------------------*/
+static void
+callback(void *ptr)
+{
+  if(fired == 0) {
+    first_fired = usec_now();
+  }
+  last_fired = usec_now();
+  fired++;
+  if(ptr != &ctimer_bench_process) {
+    errors++;
+  }
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(ctimer_bench_process, ev, data)
+{
+  static struct etimer et;
+  static int s, n, i;
+  static unsigned long t0;
+
+  PROCESS_BEGIN();
+
+  printf("Callback timer benchmark (%s backend)\n",
+         CTIMER_HEAP ? "heap" : "list");
+
+  /* Timers need not be initialized before they are set: start from
+     memory that held something else */
+  memset(timers, 0xa5, sizeof(timers));
+
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    n = sizes[s];
+
+    t0 = usec_now();
+    for(i = 0; i < n; i++) {
+      ctimer_set(&timers[i], far_interval(), callback, &ctimer_bench_process);
+    }
+    print_result("set", n, usec_now() - t0, n);
+
+    t0 = usec_now();
+    for(i = 0; i < n; i++) {
+      ctimer_set(&timers[random_rand() % n], far_interval(),
+                 callback, &ctimer_bench_process);
+    }
+    print_result("reset", n, usec_now() - t0, n);
+
+    t0 = usec_now();
+    for(i = 0; i < n; i++) {
+      ctimer_stop(&timers[(i * 7919) % n]);
+    }
+    print_result("stop", n, usec_now() - t0, n);
+
+    /* Let all n timers expire in the same clock tick. */
+    fired = 0;
+    for(i = 0; i < n; i++) {
+      ctimer_set(&timers[i], CLOCK_SECOND / 10, callback,
+                 &ctimer_bench_process);
+    }
+    etimer_set(&et, CLOCK_SECOND / 10 + CLOCK_SECOND * 10);
+    PROCESS_WAIT_UNTIL(fired == n || etimer_expired(&et));
+    etimer_stop(&et);
+    if(fired != n) {
+      printf("fire     n=%-5d only %d callbacks\n", n, fired);
+      errors++;
+    } else {
+      print_result("fire", n, last_fired - first_fired, n);
+    }
+    for(i = 0; i < n; i++) {
+      if(!ctimer_expired(&timers[i])) {
+        errors++;
+      }
+    }
+  }
+
+  printf("Callback timer benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
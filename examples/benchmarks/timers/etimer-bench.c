@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the event timer library: cost of setting,
+ *         re-setting, polling and stopping event timers with 10, 100
+ *         and 1000 pending timers. Build with
+ *         DEFINES=ETIMER_CONF_HEAP=1 to measure the heap backend.
+ */
+
+#include "contiki.h"
+#include "lib/random.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_TIMERS   1000
+#define POLL_ROUNDS  200
+#define ORDER_TIMERS 20
+
+static struct etimer timers[MAX_TIMERS];
+static struct etimer probe;
+static const int sizes[] = { 10, 100, 1000 };
+
+PROCESS(etimer_bench_process, "Event timer benchmark");
+AUTOSTART_PROCESSES(&etimer_bench_process);
+/*---------------------------------------------------------------------------*/
+static clock_time_t
+far_interval(void)
+{
+  /* Far enough in the future to never expire during the benchmark. */
+  return CLOCK_SECOND * 3600 + random_rand() % (CLOCK_SECOND * 60);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(etimer_bench_process, ev, data)
+{
+  static int s, n, i, round;
+  static unsigned long t0;
+  static int errors;
+  static struct etimer *last;
+
+  PROCESS_BEGIN();
+
+  printf("Event timer benchmark (%s backend)\n",
+         ETIMER_HEAP ? "heap" : "list");
+
+  /* Timers need not be initialized before they are set: start from
+     memory that held something else */
+  memset(timers, 0xa5, sizeof(timers));
+
+  /* Check that timers expire in order of expiration time. */
+  for(i = 0; i < ORDER_TIMERS; i++) {
+    etimer_set(&timers[i], (ORDER_TIMERS - i) * CLOCK_SECOND / 100);
+  }
+  last = NULL;
+  for(i = 0; i < ORDER_TIMERS; i++) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_TIMER);
+    if(last != NULL &&
+       etimer_expiration_time(data) < etimer_expiration_time(last)) {
+      errors++;
+    }
+    last = data;
+  }
+  printf("order    %s\n", errors == 0 ? "OK" : "FAILED");
+
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    n = sizes[s];
+
+    t0 = usec_now();
+    for(i = 0; i < n; i++) {
+      etimer_set(&timers[i], far_interval());
+    }
+    print_result("set", n, usec_now() - t0, n);
+
+    t0 = usec_now();
+    for(i = 0; i < n; i++) {
+      etimer_set(&timers[random_rand() % n], far_interval());
+    }
+    print_result("reset", n, usec_now() - t0, n);
+
+    /* Poll the timer process with one expired timer among n pending. */
+    t0 = 0;
+    for(round = 0; round < POLL_ROUNDS; round++) {
+      etimer_set(&probe, 0);
+      t0 -= usec_now();
+      process_post_synch(&etimer_process, PROCESS_EVENT_POLL, NULL);
+      t0 += usec_now();
+      if(!etimer_expired(&probe)) {
+        errors++;
+      }
+      PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_TIMER && data == &probe);
+    }
+    print_result("poll", n, t0, POLL_ROUNDS);
+
+    t0 = usec_now();
+    for(i = 0; i < n; i++) {
+      etimer_stop(&timers[(i * 7919) % n]);
+    }
+    print_result("stop", n, usec_now() - t0, n);
+    for(i = 0; i < n; i++) {
+      if(!etimer_expired(&timers[i])) {
+        errors++;
+      }
+    }
+  }
+
+  printf("Event timer benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
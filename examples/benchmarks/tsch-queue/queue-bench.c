@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the TSCH neighbor queues: cost of picking a unicast
+ *         packet for a shared link, as done in every shared slot, with 8,
+ *         32 and 128 neighbors. Checks that control packets overtake
+ *         data, that a packet being sent is the one removed, and that
+ *         shared links serve neighbors in turn.
+ *         Build with DEFINES=TSCH_QUEUE_CONF_NUM_PRIORITIES=1 to measure
+ *         a single traffic class.
+ */
+
+#include "contiki.h"
+#include "net/packetbuf.h"
+#include "net/mac/tsch/tsch.h"
+#include "net/mac/tsch/tsch-queue.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LOOKUP_ROUNDS  100000
+#define RR_NEIGHBORS   5
+
+static const int sizes[] = { 8, 32, 128 };
+
+/* The parts of TSCH the queues use, without the slot operation */
+const linkaddr_t tsch_broadcast_address = { { 0xff, 0xff, 0xff, 0xff,
+                                              0xff, 0xff, 0xff, 0xff } };
+const linkaddr_t tsch_eb_address = { { 0, 0, 0, 0, 0, 0, 0, 0 } };
+int tsch_is_coordinator = 1;
+
+PROCESS(queue_bench_process, "TSCH queue benchmark");
+AUTOSTART_PROCESSES(&queue_bench_process);
+/*---------------------------------------------------------------------------*/
+int
+tsch_is_locked(void)
+{
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+int
+tsch_get_lock(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_release_lock(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_set_ka_timeout(uint32_t timeout)
+{
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_schedule_keepalive(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+static void
+nbr_addr(linkaddr_t *addr, int i)
+{
+  memset(addr, 0, sizeof(*addr));
+  addr->u8[0] = 0x02;
+  addr->u8[LINKADDR_SIZE - 1] = i;
+}
+/*---------------------------------------------------------------------------*/
+static struct tsch_packet *
+add_packet(int i, int priority)
+{
+  linkaddr_t addr;
+
+  nbr_addr(&addr, i);
+  packetbuf_clear();
+#if TSCH_QUEUE_NUM_PRIORITIES > 1
+  packetbuf_set_attr(PACKETBUF_ATTR_TSCH_PRIORITY, priority);
+#endif
+  return tsch_queue_add_packet(&addr, NULL, NULL);
+}
+/*---------------------------------------------------------------------------*/
+static struct tsch_neighbor *
+get_nbr(int i)
+{
+  linkaddr_t addr;
+
+  nbr_addr(&addr, i);
+  return tsch_queue_get_nbr(&addr);
+}
+/*---------------------------------------------------------------------------*/
+/* A control packet queued after data is sent before it */
+static int
+check_priority(void)
+{
+  struct tsch_packet *expected[5], *p;
+  struct tsch_neighbor *n;
+  int i, errors = 0;
+
+  for(i = 0; i < 4; i++) {
+    expected[TSCH_QUEUE_NUM_PRIORITIES > 1 ? i + 1 : i] =
+      add_packet(1, TSCH_QUEUE_PRIORITY_DATA);
+  }
+  expected[TSCH_QUEUE_NUM_PRIORITIES > 1 ? 0 : 4] =
+    add_packet(1, TSCH_QUEUE_PRIORITY_CONTROL);
+  n = get_nbr(1);
+  if(tsch_queue_packet_count(&n->addr) != 5) {
+    printf("queue holds %d packets, expected 5\n",
+           tsch_queue_packet_count(&n->addr));
+    errors++;
+  }
+
+  for(i = 0; i < 5; i++) {
+    p = tsch_queue_get_packet_for_nbr(n, NULL);
+    if(p == NULL || p != expected[i]) {
+      printf("packet %d sent out of order\n", i);
+      errors++;
+    }
+    if(tsch_queue_remove_packet(n, p) != p) {
+      errors++;
+    }
+    tsch_queue_free_packet(p);
+  }
+  if(!tsch_queue_is_empty(n)) {
+    errors++;
+  }
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+/* A control packet queued while data is being sent does not make the
+   data packet stay in the queue */
+static int
+check_in_flight(void)
+{
+  struct tsch_packet *data, *control, *p;
+  struct tsch_neighbor *n;
+  int errors = 0;
+
+  data = add_packet(1, TSCH_QUEUE_PRIORITY_DATA);
+  n = get_nbr(1);
+  p = tsch_queue_get_packet_for_nbr(n, NULL);
+  control = add_packet(1, TSCH_QUEUE_PRIORITY_CONTROL);
+  if(p != data || tsch_queue_remove_packet(n, p) != data) {
+    printf("in-flight packet not removed\n");
+    errors++;
+  }
+  tsch_queue_free_packet(data);
+  if(tsch_queue_get_packet_for_nbr(n, NULL) != control
+     || tsch_queue_remove_packet(n, control) != control) {
+    errors++;
+  }
+  tsch_queue_free_packet(control);
+  if(!tsch_queue_is_empty(n)) {
+    errors++;
+  }
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+/* Shared links serve every neighbor before any is served again, and never
+   pick broadcast packets */
+static int
+check_round_robin(void)
+{
+  struct tsch_neighbor *n, *served[RR_NEIGHBORS];
+  struct tsch_packet *p;
+  int i, j, k, errors = 0;
+
+  tsch_queue_add_packet(&tsch_broadcast_address, NULL, NULL);
+  for(i = 1; i <= RR_NEIGHBORS; i++) {
+    add_packet(i, TSCH_QUEUE_PRIORITY_DATA);
+    add_packet(i, TSCH_QUEUE_PRIORITY_DATA);
+  }
+
+  for(k = 0; k < 2; k++) {
+    for(i = 0; i < RR_NEIGHBORS; i++) {
+      p = tsch_queue_get_unicast_packet_for_any(&n, NULL);
+      if(p == NULL || n->is_broadcast) {
+        printf("no unicast packet on shared link\n");
+        return errors + 1;
+      }
+      for(j = 0; j < i; j++) {
+        if(served[j] == n) {
+          printf("neighbor served twice in a round\n");
+          errors++;
+        }
+      }
+      served[i] = n;
+      tsch_queue_remove_packet(n, p);
+      tsch_queue_free_packet(p);
+    }
+  }
+  if(tsch_queue_get_unicast_packet_for_any(&n, NULL) != NULL) {
+    errors++;
+  }
+  tsch_queue_reset();
+  return errors;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(queue_bench_process, ev, data)
+{
+  static int s, n, i, errors;
+  static long round;
+  static unsigned long t0;
+  struct tsch_neighbor *nbr;
+  linkaddr_t addr;
+
+  PROCESS_BEGIN();
+
+  printf("TSCH queue benchmark (%u traffic classes)\n",
+         TSCH_QUEUE_NUM_PRIORITIES);
+
+  tsch_queue_init();
+  errors += check_priority();
+  errors += check_in_flight();
+  errors += check_round_robin();
+
+  n = 0;
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    for(i = n + 1; i <= sizes[s]; i++) {
+      nbr_addr(&addr, i);
+      if(tsch_queue_add_nbr(&addr) == NULL) {
+        errors++;
+      }
+    }
+    n = sizes[s];
+
+    /* One neighbor, the last one added, has a packet */
+    add_packet(n, TSCH_QUEUE_PRIORITY_DATA);
+    t0 = usec_now();
+    for(round = 0; round < LOOKUP_ROUNDS; round++) {
+      if(tsch_queue_get_unicast_packet_for_any(&nbr, NULL) == NULL) {
+        errors++;
+        break;
+      }
+    }
+    print_result("any-one", n, usec_now() - t0, LOOKUP_ROUNDS);
+
+    /* Every neighbor has a packet */
+    for(i = 1; i < n; i++) {
+      add_packet(i, TSCH_QUEUE_PRIORITY_DATA);
+    }
+    t0 = usec_now();
+    for(round = 0; round < LOOKUP_ROUNDS; round++) {
+      if(tsch_queue_get_unicast_packet_for_any(&nbr, NULL) == NULL) {
+        errors++;
+        break;
+      }
+    }
+    print_result("any-all", n, usec_now() - t0, LOOKUP_ROUNDS);
+    tsch_queue_reset();
+  }
+
+  /* Neighbors with no packet and no link are freed */
+  tsch_queue_free_unused_neighbors();
+  if(tsch_queue_get_unicast_packet_for_any(&nbr, NULL) != NULL) {
+    errors++;
+  }
+  errors += check_round_robin();
+
+  printf("TSCH queue benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
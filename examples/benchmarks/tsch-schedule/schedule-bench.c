@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the TSCH schedule: cost of finding the next active
+ *         link, as done in every slot, with 10, 100 and 1000 links in an
+ *         Orchestra-like schedule. Each result is checked against a walk
+ *         over all links, also while links are removed and added.
+ *         Build with DEFINES=TSCH_SCHEDULE_CONF_WITH_LINK_INDEX=0 to
+ *         measure the walk over the links lists.
+ */
+
+#include "contiki.h"
+#include "net/mac/tsch/tsch-schedule.h"
+#include "lib/random.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LOOKUP_ROUNDS  100000
+#define CHURN_ROUNDS   2000
+
+/* Slotframe sizes, as in Orchestra but with a unicast slotframe large
+   enough for a link per neighbor in distinct timeslots */
+#define EB_PERIOD       397
+#define COMMON_PERIOD   31
+#define UNICAST_PERIOD  2053
+
+static const int sizes[] = { 10, 100, 1000 };
+
+static struct tsch_slotframe *sf_eb, *sf_common, *sf_unicast;
+
+/* The parts of TSCH the schedule uses, without the slot operation */
+const linkaddr_t tsch_broadcast_address = { { 0xff, 0xff, 0xff, 0xff,
+                                              0xff, 0xff, 0xff, 0xff } };
+struct tsch_link *current_link;
+
+PROCESS(schedule_bench_process, "TSCH schedule benchmark");
+AUTOSTART_PROCESSES(&schedule_bench_process);
+/*---------------------------------------------------------------------------*/
+int
+tsch_is_locked(void)
+{
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+int
+tsch_get_lock(void)
+{
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_release_lock(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+struct tsch_neighbor *
+tsch_queue_add_nbr(const linkaddr_t *addr)
+{
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+static struct tsch_link *
+add_unicast_link(void)
+{
+  linkaddr_t addr;
+  uint16_t timeslot;
+
+  /* A free timeslot, so that adding does not replace a link */
+  do {
+    timeslot = random_rand() % UNICAST_PERIOD;
+  } while(tsch_schedule_get_link_by_timeslot(sf_unicast, timeslot) != NULL);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.u8[LINKADDR_SIZE - 2] = timeslot >> 8;
+  addr.u8[LINKADDR_SIZE - 1] = timeslot & 0xff;
+  /* Rx links to us, and Tx links to the neighbors, as with Orchestra's
+     sender-based unicast slotframe */
+  return tsch_schedule_add_link(sf_unicast,
+                                (timeslot & 1) ? LINK_OPTION_TX : LINK_OPTION_RX,
+                                LINK_TYPE_NORMAL, &addr, timeslot, 2);
+}
+/*---------------------------------------------------------------------------*/
+/* Checks the next active link against a walk over all links */
+static int
+check(struct tsch_asn_t *asn)
+{
+  struct tsch_slotframe *sf;
+  struct tsch_link *l, *best, *backup;
+  uint16_t offset, min, time, timeslot;
+  int tx;
+
+  best = tsch_schedule_get_next_active_link(asn, &offset, &backup);
+
+  min = 0xffff;
+  tx = 0;
+  for(sf = tsch_schedule_get_slotframe_by_handle(0); sf != NULL;
+      sf = list_item_next(sf)) {
+    timeslot = TSCH_ASN_MOD(*asn, sf->size);
+    for(l = list_head(sf->links_list); l != NULL; l = list_item_next(l)) {
+      time = l->timeslot > timeslot ?
+        l->timeslot - timeslot : sf->size.val + l->timeslot - timeslot;
+      if(time < min) {
+        min = time;
+        tx = 0;
+      }
+      if(time == min && (l->link_options & LINK_OPTION_TX)) {
+        tx = 1;
+      }
+    }
+  }
+
+  if(best == NULL || offset != min) {
+    printf("next link in %u slots, expected %u\n", offset, min);
+    return 1;
+  }
+  if(tx && !(best->link_options & LINK_OPTION_TX)) {
+    printf("next link has no Tx option\n");
+    return 1;
+  }
+  if(backup != NULL && !(backup->link_options & LINK_OPTION_RX)) {
+    printf("backup link has no Rx option\n");
+    return 1;
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(schedule_bench_process, ev, data)
+{
+  static int s, n, i, errors;
+  static long round;
+  static unsigned long t0;
+  static struct tsch_asn_t asn;
+  static struct tsch_link *links[1000];
+  uint16_t offset;
+  struct tsch_link *l, *backup;
+
+  PROCESS_BEGIN();
+
+  printf("TSCH schedule benchmark (link index %s)\n",
+         TSCH_SCHEDULE_WITH_LINK_INDEX ? "on" : "off");
+
+  tsch_schedule_init();
+  sf_eb = tsch_schedule_add_slotframe(0, EB_PERIOD);
+  sf_common = tsch_schedule_add_slotframe(1, COMMON_PERIOD);
+  sf_unicast = tsch_schedule_add_slotframe(2, UNICAST_PERIOD);
+  tsch_schedule_add_link(sf_eb, LINK_OPTION_TX, LINK_TYPE_ADVERTISING_ONLY,
+                         &tsch_broadcast_address, 0, 0);
+  tsch_schedule_add_link(sf_common, LINK_OPTION_RX | LINK_OPTION_TX | LINK_OPTION_SHARED,
+                         LINK_TYPE_ADVERTISING, &tsch_broadcast_address, 0, 1);
+
+  n = 0;
+  for(s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    t0 = usec_now();
+    for(i = n; i < sizes[s]; i++) {
+      links[i] = add_unicast_link();
+      if(links[i] == NULL) {
+        errors++;
+      }
+    }
+    print_result("add", sizes[s], usec_now() - t0, sizes[s] - n);
+    n = sizes[s];
+
+    /* Walk the schedule as the slot operation does */
+    TSCH_ASN_INIT(asn, 0, 0);
+    t0 = usec_now();
+    for(round = 0; round < LOOKUP_ROUNDS; round++) {
+      if(tsch_schedule_get_next_active_link(&asn, &offset, &backup) == NULL) {
+        errors++;
+        break;
+      }
+      TSCH_ASN_INC(asn, offset);
+    }
+    print_result("next", n, usec_now() - t0, LOOKUP_ROUNDS);
+
+    TSCH_ASN_INIT(asn, 0, 0);
+    for(round = 0; round < CHURN_ROUNDS; round++) {
+      errors += check(&asn);
+      TSCH_ASN_INC(asn, 1 + random_rand() % 50);
+    }
+  }
+
+  /* Replace links, checking the schedule after every change */
+  for(round = 0; round < CHURN_ROUNDS; round++) {
+    i = random_rand() % n;
+    if(!tsch_schedule_remove_link(sf_unicast, links[i])) {
+      errors++;
+    }
+    errors += check(&asn);
+    links[i] = add_unicast_link();
+    if(links[i] == NULL) {
+      errors++;
+    }
+    errors += check(&asn);
+    TSCH_ASN_INC(asn, 1 + random_rand() % 50);
+  }
+
+  /* Every link must still be found from its timeslot */
+  for(i = 0; i < n; i++) {
+    l = tsch_schedule_get_link_by_timeslot(sf_unicast, links[i]->timeslot);
+    if(l != links[i]) {
+      errors++;
+    }
+  }
+
+  /* An emptied slotframe, and a slotframe added after it */
+  tsch_schedule_remove_slotframe(sf_common);
+  sf_common = tsch_schedule_add_slotframe(3, COMMON_PERIOD);
+  tsch_schedule_add_link(sf_common, LINK_OPTION_RX | LINK_OPTION_SHARED,
+                         LINK_TYPE_NORMAL, &tsch_broadcast_address, 5, 1);
+  for(round = 0; round < CHURN_ROUNDS; round++) {
+    errors += check(&asn);
+    TSCH_ASN_INC(asn, 1 + random_rand() % 50);
+  }
+  tsch_schedule_remove_all_slotframes();
+  if(tsch_schedule_get_next_active_link(&asn, &offset, &backup) != NULL) {
+    errors++;
+  }
+
+  printf("TSCH schedule benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
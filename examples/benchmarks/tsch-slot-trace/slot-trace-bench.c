@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+/**
+ * \file
+ *         Benchmark of the TSCH slot timing trace: cost added to a slot
+ *         by tracing it, measured with the trace calls a unicast Tx slot
+ *         makes. Checks that idle slots are not kept, that sampled-out
+ *         slots are kept when they miss a deadline, and that slots are
+ *         dropped when the ring is full. Then traces synthetic slots with
+ *         32768 Hz rtimer timings, for tools/tsch/tsch-slot-trace.py:
+ *           ./slot-trace-bench.native |
+ *             ../../../tools/tsch/tsch-slot-trace.py --rtimer-second 32768
+ */
+
+#include "contiki.h"
+#include "net/mac/tsch/tsch-slot-trace.h"
+#include "net/mac/mac.h"
+#include "lib/random.h"
+
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define TIMING_ROUNDS  20000
+#define DEMO_SLOTS     4000
+
+/* Polled by the trace module, drained by hand here */
+PROCESS(tsch_pending_events_process, "TSCH pending events");
+PROCESS(slot_trace_bench_process, "TSCH slot trace benchmark");
+AUTOSTART_PROCESSES(&slot_trace_bench_process);
+
+static struct tsch_asn_t asn;
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(tsch_pending_events_process, ev, data)
+{
+  PROCESS_BEGIN();
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+/* Prints out pending traces to /dev/null */
+static void
+drain(void)
+{
+  int out, null;
+
+  fflush(stdout);
+  out = dup(STDOUT_FILENO);
+  null = open("/dev/null", O_WRONLY);
+  dup2(null, STDOUT_FILENO);
+  tsch_slot_trace_process_pending();
+  fflush(stdout);
+  dup2(out, STDOUT_FILENO);
+  close(null);
+  close(out);
+}
+/*---------------------------------------------------------------------------*/
+/* The trace calls of a unicast Tx slot. Returns 0 if the slot was not
+   traced because the ring was full. */
+static int
+tx_slot(int missed)
+{
+  int traced;
+
+  TSCH_SLOT_TRACE_START(&asn, RTIMER_NOW());
+  traced = tsch_slot_trace_current != NULL;
+  TSCH_SLOT_TRACE_SET(type, TSCH_SLOT_TRACE_TX);
+  TSCH_SLOT_TRACE_PHASE(TSCH_SLOT_PHASE_PREPARE);
+  if(missed) {
+    TSCH_SLOT_TRACE_MISS(TSCH_SLOT_PHASE_PREPARE);
+  }
+  TSCH_SLOT_TRACE_PHASE(TSCH_SLOT_PHASE_TX);
+  TSCH_SLOT_TRACE_PHASE(TSCH_SLOT_PHASE_ACK);
+  TSCH_SLOT_TRACE_SET(status, MAC_TX_OK);
+  TSCH_SLOT_TRACE_PHASE(TSCH_SLOT_PHASE_END);
+  TSCH_SLOT_TRACE_END();
+  TSCH_ASN_INC(asn, 1);
+  return traced;
+}
+/*---------------------------------------------------------------------------*/
+/* A slot with a Tx-only link and nothing to send */
+static int
+idle_slot(void)
+{
+  int traced;
+
+  TSCH_SLOT_TRACE_START(&asn, RTIMER_NOW());
+  traced = tsch_slot_trace_current != NULL;
+  TSCH_SLOT_TRACE_PHASE(TSCH_SLOT_PHASE_END);
+  TSCH_SLOT_TRACE_END();
+  TSCH_ASN_INC(asn, 1);
+  return traced;
+}
+/*---------------------------------------------------------------------------*/
+static uint16_t
+between(uint16_t low, uint16_t high)
+{
+  return low + random_rand() % (high - low + 1);
+}
+/*---------------------------------------------------------------------------*/
+/* A slot with the default 10 ms timeslot template at 32768 Hz */
+static void
+synthetic_slot(void)
+{
+  struct tsch_slot_trace *trace;
+  uint16_t t;
+
+  TSCH_SLOT_TRACE_START(&asn, RTIMER_NOW());
+  trace = tsch_slot_trace_current;
+  if(trace == NULL) {
+    return;
+  }
+  trace->time[TSCH_SLOT_PHASE_START] = t = between(0, 3);
+  if(random_rand() % 3 == 0) {
+    trace->type = TSCH_SLOT_TRACE_TX;
+    /* One frame in 100 is secured too slowly for the Tx offset */
+    t += random_rand() % 100 == 0 ? between(70, 90) : between(10, 45);
+    trace->time[TSCH_SLOT_PHASE_PREPARE] = t;
+    if(t >= 69) {
+      TSCH_SLOT_TRACE_MISS(TSCH_SLOT_PHASE_PREPARE);
+    }
+    trace->time[TSCH_SLOT_PHASE_TX] = t = MAX(t, 69) + between(5, 35);
+    trace->time[TSCH_SLOT_PHASE_ACK] = t = t + between(25, 40);
+    trace->status = MAC_TX_OK;
+  } else {
+    trace->type = TSCH_SLOT_TRACE_RX;
+    if(random_rand() % 4 == 0) {
+      trace->time[TSCH_SLOT_PHASE_RX] = t = between(100, 140);
+      trace->time[TSCH_SLOT_PHASE_RX_ACK] = t = t + between(30, 40);
+      trace->status = 1;
+    } else {
+      trace->time[TSCH_SLOT_PHASE_RX] = t = between(85, 90);
+    }
+  }
+  trace->time[TSCH_SLOT_PHASE_END] = t + between(2, 8);
+  TSCH_SLOT_TRACE_END();
+  TSCH_ASN_INC(asn, 1);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(slot_trace_bench_process, ev, data)
+{
+  static int i, errors;
+  static long round;
+  static unsigned long usec;
+  unsigned long t0;
+
+  PROCESS_BEGIN();
+
+  tsch_slot_trace_init();
+  TSCH_ASN_INIT(asn, 0, 0);
+
+  /* Time the trace calls, draining the ring outside the timed loops */
+  usec = 0;
+  for(round = 0; round < TIMING_ROUNDS; round++) {
+    t0 = usec_now();
+    for(i = 0; i < TSCH_SLOT_TRACE_LEN; i++) {
+      tx_slot(0);
+    }
+    usec += usec_now() - t0;
+    drain();
+  }
+  print_result("tx slot", TSCH_SLOT_TRACE_LEN, usec,
+               (long)TIMING_ROUNDS * TSCH_SLOT_TRACE_LEN);
+
+  t0 = usec_now();
+  for(round = 0; round < TIMING_ROUNDS * TSCH_SLOT_TRACE_LEN; round++) {
+    idle_slot();
+  }
+  print_result("idle", TSCH_SLOT_TRACE_LEN, usec_now() - t0,
+               (long)TIMING_ROUNDS * TSCH_SLOT_TRACE_LEN);
+
+  /* Idle slots do not take ring entries, other slots do, once per
+     TSCH_SLOT_TRACE_SAMPLE unless they missed a deadline. The ring holds
+     TSCH_SLOT_TRACE_LEN - 1 slots. */
+  for(i = 0; i < 2 * TSCH_SLOT_TRACE_LEN; i++) {
+    errors += !idle_slot();
+  }
+  for(i = 0; tx_slot(0) && i < 2 * TSCH_SLOT_TRACE_LEN * TSCH_SLOT_TRACE_SAMPLE; i++);
+  if(i < (TSCH_SLOT_TRACE_LEN - 1) * TSCH_SLOT_TRACE_SAMPLE ||
+     i >= TSCH_SLOT_TRACE_LEN * TSCH_SLOT_TRACE_SAMPLE) {
+    errors++;
+  }
+  errors += idle_slot();
+  drain();
+  for(i = 0; i < TSCH_SLOT_TRACE_LEN - 1; i++) {
+    errors += !tx_slot(1);
+  }
+  errors += tx_slot(1);
+  drain();
+  if(errors) {
+    printf("ring accounting is wrong\n");
+  }
+
+  /* Synthetic slots for the decoder */
+  for(i = 0; i < DEMO_SLOTS; i++) {
+    synthetic_slot();
+    if(i % (TSCH_SLOT_TRACE_LEN / 2) == 0) {
+      tsch_slot_trace_process_pending();
+    }
+  }
+  tsch_slot_trace_process_pending();
+
+  printf("TSCH slot trace benchmark done, %d errors\n", errors);
+  exit(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
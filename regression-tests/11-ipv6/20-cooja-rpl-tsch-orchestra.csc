@@ -26,7 +26,7 @@
       <description>Cooja Mote Type #z11</description>
       <source EXPORT="discard">[CONTIKI_DIR]/examples/ipv6/rpl-tsch/node.c</source>
       <commands EXPORT="discard">make TARGET=cooja clean
-make node.cooja TARGET=cooja MAKE_WITH_ORCHESTRA=1 MAKE_WITH_SECURITY=0</commands>
+make node.cooja TARGET=cooja MAKE_WITH_ORCHESTRA=1 MAKE_WITH_SECURITY=0 DEFINES=TSCH_SCHEDULE_CONF_WITH_LINK_INDEX=1</commands>
       <firmware
           EXPORT="copy">[CONTIKI_DIR]/examples/ipv6/rpl-tsch/node.z1</firmware>
       <moteinterface>org.contikios.cooja.interfaces.Position</moteinterface>
@@ -34,9 +34,14 @@
 
 #define UNIT_TEST_PRINT_FUNCTION test_print_report
 
-/* Set the minimum value of QUEUEBUF_CONF_NUM for the flush_nbr_queue test */
 #undef QUEUEBUF_CONF_NUM
+#if TSCH_QUEUE_CONF_NUM_PRIORITIES > 1
+/* The queue priority test keeps several packets queued at once */
+#define QUEUEBUF_CONF_NUM   8
+#else
+/* Set the minimum value of QUEUEBUF_CONF_NUM for the flush_nbr_queue test */
 #define QUEUEBUF_CONF_NUM   1
+#endif
 
 #undef TSCH_LOG_CONF_LEVEL
 #define TSCH_LOG_CONF_LEVEL 2
@@ -44,6 +49,9 @@
 #undef TSCH_CONF_AUTOSTART
 #define TSCH_CONF_AUTOSTART 1
 
+#undef TSCH_SCHEDULE_CONF_WITH_LINK_INDEX
+#define TSCH_SCHEDULE_CONF_WITH_LINK_INDEX 1
+
 #undef NETSTACK_CONF_MAC
 #define NETSTACK_CONF_MAC        tschmac_driver
 
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026, The Contiki contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This file is part of the Contiki operating system.
+ *
+ */
+
+#include <stdio.h>
+
+#include "contiki.h"
+#include "contiki-net.h"
+#include "contiki-lib.h"
+#include "lib/assert.h"
+
+#include "net/linkaddr.h"
+#include "net/packetbuf.h"
+#include "net/mac/tsch/tsch.h"
+#include "net/mac/tsch/tsch-queue.h"
+
+#include "unit-test.h"
+#include "common.h"
+
+PROCESS(test_process, "TSCH queue priority test");
+AUTOSTART_PROCESSES(&test_process);
+
+#define TEST_NUM_PEERS 3
+static linkaddr_t test_nbr_addr[TEST_NUM_PEERS] = {{{ 0x01 }}, {{ 0x02 }}, {{ 0x03 }}};
+#define TEST_PEER_ADDR &test_nbr_addr[0]
+
+static struct tsch_packet *
+add_packet(const linkaddr_t *addr, int priority)
+{
+  packetbuf_clear();
+  packetbuf_set_attr(PACKETBUF_ATTR_TSCH_PRIORITY, priority);
+  return tsch_queue_add_packet(addr, NULL, NULL);
+}
+
+UNIT_TEST_REGISTER(test_priority,
+                   "control packets should be sent before queued data");
+UNIT_TEST(test_priority)
+{
+  struct tsch_packet *data[3];
+  struct tsch_packet *control;
+  struct tsch_neighbor *nbr;
+  int i;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < 3; i++) {
+    data[i] = add_packet(TEST_PEER_ADDR, TSCH_QUEUE_PRIORITY_DATA);
+    UNIT_TEST_ASSERT(data[i] != NULL);
+  }
+  control = add_packet(TEST_PEER_ADDR, TSCH_QUEUE_PRIORITY_CONTROL);
+  UNIT_TEST_ASSERT(control != NULL);
+  UNIT_TEST_ASSERT(tsch_queue_packet_count(TEST_PEER_ADDR) == 4);
+
+  nbr = tsch_queue_get_nbr(TEST_PEER_ADDR);
+  UNIT_TEST_ASSERT(nbr != NULL);
+  UNIT_TEST_ASSERT(tsch_queue_get_packet_for_nbr(nbr, NULL) == control);
+  UNIT_TEST_ASSERT(tsch_queue_remove_packet(nbr, control) == control);
+  tsch_queue_free_packet(control);
+
+  /* Data keeps its order */
+  for(i = 0; i < 3; i++) {
+    UNIT_TEST_ASSERT(tsch_queue_get_packet_for_nbr(nbr, NULL) == data[i]);
+    UNIT_TEST_ASSERT(tsch_queue_remove_packet(nbr, data[i]) == data[i]);
+    tsch_queue_free_packet(data[i]);
+  }
+  UNIT_TEST_ASSERT(tsch_queue_is_empty(nbr));
+
+  UNIT_TEST_END();
+}
+
+UNIT_TEST_REGISTER(test_in_flight,
+                   "a packet being sent should be the one removed");
+UNIT_TEST(test_in_flight)
+{
+  struct tsch_packet *data;
+  struct tsch_packet *control;
+  struct tsch_neighbor *nbr;
+
+  UNIT_TEST_BEGIN();
+
+  data = add_packet(TEST_PEER_ADDR, TSCH_QUEUE_PRIORITY_DATA);
+  UNIT_TEST_ASSERT(data != NULL);
+  nbr = tsch_queue_get_nbr(TEST_PEER_ADDR);
+  UNIT_TEST_ASSERT(tsch_queue_get_packet_for_nbr(nbr, NULL) == data);
+
+  /* A control packet arrives while the data packet is in the air */
+  control = add_packet(TEST_PEER_ADDR, TSCH_QUEUE_PRIORITY_CONTROL);
+  UNIT_TEST_ASSERT(control != NULL);
+  UNIT_TEST_ASSERT(tsch_queue_remove_packet(nbr, data) == data);
+  tsch_queue_free_packet(data);
+
+  UNIT_TEST_ASSERT(tsch_queue_get_packet_for_nbr(nbr, NULL) == control);
+  tsch_queue_reset();
+  UNIT_TEST_ASSERT(tsch_queue_is_empty(nbr));
+
+  UNIT_TEST_END();
+}
+
+UNIT_TEST_REGISTER(test_round_robin,
+                   "shared links should serve the neighbors in turn");
+UNIT_TEST(test_round_robin)
+{
+  struct tsch_neighbor *served[TEST_NUM_PEERS];
+  struct tsch_neighbor *nbr;
+  struct tsch_packet *packet;
+  int i, j;
+
+  UNIT_TEST_BEGIN();
+
+  for(i = 0; i < TEST_NUM_PEERS; i++) {
+    UNIT_TEST_ASSERT(add_packet(&test_nbr_addr[i], TSCH_QUEUE_PRIORITY_DATA) != NULL);
+    UNIT_TEST_ASSERT(add_packet(&test_nbr_addr[i], TSCH_QUEUE_PRIORITY_DATA) != NULL);
+  }
+
+  /* Every neighbor is served once before any is served again */
+  for(i = 0; i < 2 * TEST_NUM_PEERS; i++) {
+    packet = tsch_queue_get_unicast_packet_for_any(&nbr, NULL);
+    UNIT_TEST_ASSERT(packet != NULL);
+    for(j = 0; j < i % TEST_NUM_PEERS; j++) {
+      UNIT_TEST_ASSERT(served[j] != nbr);
+    }
+    served[i % TEST_NUM_PEERS] = nbr;
+    UNIT_TEST_ASSERT(tsch_queue_remove_packet(nbr, packet) == packet);
+    tsch_queue_free_packet(packet);
+  }
+  UNIT_TEST_ASSERT(tsch_queue_get_unicast_packet_for_any(&nbr, NULL) == NULL);
+
+  UNIT_TEST_END();
+}
+
+PROCESS_THREAD(test_process, ev, data)
+{
+  static struct etimer et;
+
+  PROCESS_BEGIN();
+
+  tsch_set_coordinator(1);
+
+  etimer_set(&et, CLOCK_SECOND);
+  while(tsch_is_associated == 0) {
+    PROCESS_YIELD_UNTIL(etimer_expired(&et));
+    etimer_reset(&et);
+  }
+
+  printf("Run unit-test\n");
+  printf("---\n");
+
+  UNIT_TEST_RUN(test_priority);
+  UNIT_TEST_RUN(test_in_flight);
+  UNIT_TEST_RUN(test_round_robin);
+
+  printf("=check-me= DONE\n");
+  PROCESS_END();
+}
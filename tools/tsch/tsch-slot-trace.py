@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026, The Contiki contributors.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE
+# COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+# HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+# STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+# OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+# This file is part of the Contiki operating system.
+#
+
+"""Decode TSCH slot timing traces into per-phase latency histograms.
+
+Reads the output of nodes built with TSCH_SLOT_TRACE_CONF_LEN set, e.g. a
+serial dump or a Cooja log, from the files given or standard input. Lines
+that do not contain "TSCH-trace:" are ignored. See
+core/net/mac/tsch/tsch-slot-trace.c for the line format.
+"""
+
+import argparse
+import re
+import sys
+
+PHASES = ["start", "prepare", "cca", "tx", "ack", "rx", "rx-ack", "end"]
+SLOT_TYPES = {0: "idle", 1: "tx", 2: "rx"}
+NONE = 0xffff
+
+LINE = re.compile(r"(?:ID:(\d+)\s+)?.*?TSCH-trace: (\w) ?(.*)$")
+
+
+class Node:
+    def __init__(self):
+        self.rtimer_second = None
+        self.misses = [0] * len(PHASES)
+        self.dropped = 0
+
+
+def parse_record(hexstr, nphases):
+    data = bytes.fromhex(hexstr)
+    asn = (data[0] << 32) | int.from_bytes(data[1:5], "big")
+    times = [int.from_bytes(data[8 + 2 * i:10 + 2 * i], "big")
+             for i in range(nphases)]
+    return asn, data[5], data[6], data[7], times
+
+
+def durations(times):
+    """Duration of each phase that was reached, from the end of the
+    previous phase reached, or from the start of the slot."""
+    prev = 0
+    for phase, t in enumerate(times):
+        if t != NONE:
+            yield phase, (t - prev) & 0xffff
+            prev = t
+
+
+def percentile(sorted_values, p):
+    return sorted_values[min(len(sorted_values) - 1,
+                             int(p * len(sorted_values) / 100))]
+
+
+def print_histogram(values, bins, width=40):
+    low, high = values[0], values[-1]
+    step = max(1, (high - low + bins) // bins)
+    counts = [0] * bins
+    for v in values:
+        counts[min(bins - 1, (v - low) // step)] += 1
+    top = max(counts)
+    for i, c in enumerate(counts):
+        if c:
+            print("    %6d-%-6d %7d %s" % (low + i * step, low + (i + 1) * step - 1,
+                                          c, "#" * max(1, c * width // top)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("files", nargs="*", type=argparse.FileType("r"),
+                        default=[sys.stdin])
+    parser.add_argument("--rtimer-second", type=int,
+                        help="rtimer ticks per second, if not in the trace")
+    parser.add_argument("--bins", type=int, default=0,
+                        help="print a histogram with this many bins per phase")
+    args = parser.parse_args()
+
+    nodes = {}
+    samples = [[] for _ in PHASES]
+    missed = [0] * len(PHASES)
+    types = {}
+    records = 0
+
+    for f in args.files:
+        for line in f:
+            m = LINE.search(line.strip())
+            if m is None:
+                continue
+            node = nodes.setdefault(m.group(1), Node())
+            kind, fields = m.group(2), m.group(3).split()
+            if kind == "h":
+                node.rtimer_second = int(fields[0])
+            elif kind == "d":
+                node.dropped = int(fields[0])
+            elif kind == "m":
+                node.misses = [int(x) for x in fields]
+            elif kind == "r":
+                rtimer_second = args.rtimer_second or node.rtimer_second
+                if rtimer_second is None:
+                    sys.exit("no rtimer rate in the trace, use --rtimer-second")
+                asn, slot_type, status, miss, times = parse_record(fields[0], len(PHASES))
+                records += 1
+                types[slot_type] = types.get(slot_type, 0) + 1
+                for phase, ticks in durations(times):
+                    samples[phase].append(ticks * 1000000 // rtimer_second)
+                for phase in range(len(PHASES)):
+                    if miss & (1 << phase):
+                        missed[phase] += 1
+
+    print("%d slots traced (%s), %d dropped" % (
+        records,
+        ", ".join("%s %d" % (SLOT_TYPES.get(t, t), n) for t, n in sorted(types.items())),
+        sum(n.dropped for n in nodes.values())))
+    print("%-8s %7s %7s %7s %7s %7s %7s %7s" % (
+        "phase", "slots", "min us", "p50", "p90", "p99", "max", "misses"))
+    for phase, name in enumerate(PHASES):
+        values = sorted(samples[phase])
+        misses = sum(n.misses[phase] for n in nodes.values() if phase < len(n.misses))
+        if not values:
+            print("%-8s %7d %7s %7s %7s %7s %7s %7d" % (name, 0, "-", "-", "-", "-", "-",
+                                                        max(misses, missed[phase])))
+            continue
+        print("%-8s %7d %7d %7d %7d %7d %7d %7d" % (
+            name, len(values), values[0], percentile(values, 50),
+            percentile(values, 90), percentile(values, 99), values[-1],
+            max(misses, missed[phase])))
+        if args.bins:
+            print_histogram(values, args.bins)
+
+
+if __name__ == "__main__":
+    main()